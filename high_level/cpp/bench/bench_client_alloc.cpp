@@ -0,0 +1,201 @@
+// Heap allocations and latency per call for the high-rate client paths.
+//
+//   stub/fresh     generated stub, new context, request and response every call
+//                  (how the examples were written before RobotClient)
+//   stub/arena     generated stub, request and response reused from an ArenaMessage
+//   client/arena   RobotClient: recycled call objects with arena-backed responses,
+//                  request reused from an ArenaMessage
+// for GetRobotState polling and for ExecuteSequence with a 9-motion sequence. Calls
+// run back to back; allocations are every malloc/calloc/realloc in the client process
+// (gRPC core, protobuf and this code, all threads) divided by the number of calls.
+//
+// A MockRobotServer with near-zero motion durations is forked into a child process,
+// so none of its allocations are counted.
+//
+// Usage: ./bench_client_alloc [calls=20000]
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+#include "common/arena_message.h"
+#include "common/latency_stats.h"
+#include "common/mock_robot.h"
+#include "common/motion_builders.h"
+#include "common/robot_client.h"
+
+using grpc_comm::ExecuteSequenceRequest;
+using grpc_comm::ExecuteSequenceResponse;
+using grpc_comm::GetRobotStateRequest;
+using grpc_comm::GetRobotStateResponse;
+
+// Counting wrappers around glibc's allocator; operator new ends up here as well.
+std::atomic<uint64_t> g_allocations {0};
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+}
+
+void FillSequence(ExecuteSequenceRequest* request)
+{
+    using namespace quad_sdk::motions;
+    auto* sequence = request->mutable_sequence();
+    sequence->set_sequence_id("bench_client_alloc");
+    sequence->set_bpm(120.0f);
+    PathToState {"BALANCE_STAND"}.AppendTo(sequence);
+    for (int i = 0; i < 4; ++i) {
+        BalancePitch {1.0f, 0.8f}.AppendTo(sequence);
+        BalanceYaw {1.0f, -0.8f}.AppendTo(sequence);
+    }
+    request->set_immediate_start(true);
+}
+
+// Runs `call` n times and prints allocations and latency per call.
+template <typename Fn>
+bool Measure(const std::string& name, int n, Fn call)
+{
+    for (int i = 0; i < n / 10 + 1; ++i) // warm-up, also fills the call pools
+        if (!call())
+            return false;
+    quad_sdk::LatencyStats latency;
+    uint64_t before = g_allocations.load();
+    for (int i = 0; i < n; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        if (!call())
+            return false;
+        latency.Add(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    double per_call = static_cast<double>(g_allocations.load() - before) / n;
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << per_call << std::setw(12) << latency.Percentile(50) << std::setw(12)
+              << latency.Percentile(99) << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int calls = (argc > 1) ? std::stoi(argv[1]) : 20000;
+    if (calls < 1) {
+        std::cout << "Usage: " << argv[0] << " [calls=20000]" << std::endl;
+        return 1;
+    }
+
+    // Fork before gRPC is initialised in this process (see bench_state_stream.cpp).
+    int port_pipe[2], stop_pipe[2];
+    if (pipe(port_pipe) != 0 || pipe(stop_pipe) != 0) {
+        std::cout << "pipe() failed" << std::endl;
+        return 1;
+    }
+    pid_t server_pid = fork();
+    if (server_pid == 0) {
+        close(port_pipe[0]);
+        close(stop_pipe[1]);
+        quad_sdk::MockRobotServer server(1e-9);
+        int port = 0;
+        if (server.Start("127.0.0.1:0"))
+            port = std::stoi(server.Address().substr(server.Address().rfind(':') + 1));
+        if (write(port_pipe[1], &port, sizeof(port)) != sizeof(port))
+            _exit(1);
+        char c;
+        while (read(stop_pipe[0], &c, 1) > 0) {
+        }
+        server.Shutdown();
+        _exit(0);
+    }
+    close(port_pipe[1]);
+    close(stop_pipe[0]);
+    int port = 0;
+    if (server_pid < 0 || read(port_pipe[0], &port, sizeof(port)) != sizeof(port) || port == 0) {
+        std::cout << "Failed to start the mock robot" << std::endl;
+        return 1;
+    }
+    const std::string address = "127.0.0.1:" + std::to_string(port);
+
+    bool ok = true;
+    {
+        quad_sdk::RobotClient client(address);
+        auto* stub = client.Stub();
+
+        std::cout << "Client allocations per call, " << calls << " calls per row (forked mock robot at " << address
+                  << ")\n"
+                  << std::endl;
+        std::cout << std::left << std::setw(28) << "path" << std::right << std::setw(12) << "allocs" << std::setw(12)
+                  << "p50 us" << std::setw(12) << "p99 us" << std::endl;
+
+        quad_sdk::ArenaMessage<GetRobotStateRequest> state_request;
+        quad_sdk::ArenaMessage<GetRobotStateResponse> state_response;
+        quad_sdk::ArenaMessage<ExecuteSequenceRequest> sequence_request;
+        quad_sdk::ArenaMessage<ExecuteSequenceResponse> sequence_response;
+
+        ok = ok && Measure("GetRobotState stub/fresh", calls, [&] {
+            grpc::ClientContext context;
+            std::unique_ptr<GetRobotStateRequest> request(new GetRobotStateRequest());
+            std::unique_ptr<GetRobotStateResponse> response(new GetRobotStateResponse());
+            return stub->GetRobotState(&context, *request, response.get()).ok() && response->success();
+        });
+        ok = ok && Measure("GetRobotState stub/arena", calls, [&] {
+            grpc::ClientContext context;
+            auto& response = state_response.Reset();
+            return stub->GetRobotState(&context, state_request.Reset(), &response).ok() && response.success();
+        });
+        ok = ok && Measure("GetRobotState client/arena", calls, [&] {
+            auto call = client.GetRobotState(state_request.Reset());
+            call->Wait();
+            return call->status().ok() && call->response().success();
+        });
+
+        ok = ok && Measure("ExecuteSequence stub/fresh", calls, [&] {
+            grpc::ClientContext context;
+            std::unique_ptr<ExecuteSequenceRequest> request(new ExecuteSequenceRequest());
+            std::unique_ptr<ExecuteSequenceResponse> response(new ExecuteSequenceResponse());
+            FillSequence(request.get());
+            return stub->ExecuteSequence(&context, *request, response.get()).ok() && response->success();
+        });
+        ok = ok && Measure("ExecuteSequence stub/arena", calls, [&] {
+            grpc::ClientContext context;
+            auto& request = sequence_request.Reset();
+            FillSequence(&request);
+            auto& response = sequence_response.Reset();
+            return stub->ExecuteSequence(&context, request, &response).ok() && response.success();
+        });
+        ok = ok && Measure("ExecuteSequence client/arena", calls, [&] {
+            auto& request = sequence_request.Reset();
+            FillSequence(&request);
+            auto call = client.ExecuteSequence(request);
+            call->Wait();
+            return call->status().ok() && call->response().success();
+        });
+        if (!ok)
+            std::cout << "A call failed" << std::endl;
+    }
+
+    close(stop_pipe[1]);
+    waitpid(server_pid, nullptr, 0);
+    return ok ? 0 : 1;
+}
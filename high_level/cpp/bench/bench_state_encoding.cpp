@@ -0,0 +1,116 @@
+// RobotState (18 repeated float fields) vs PackedRobotState (one fixed-layout block).
+//
+// Per encoding, measures the serialized size and the cost of
+//   encode   server side: fill the message from robot values and serialize it
+//   decode   client side: parse the bytes and copy every value into a PackedStateV1
+// so both sides do the same useful work. The state comes from the mock robot.
+//
+// Usage: ./bench_state_encoding [iterations=200000]
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "proto/grpc_service.pb.h"
+#include "common/mock_robot.h"
+#include "common/packed_state.h"
+
+using grpc_comm::PackedRobotState;
+using grpc_comm::RobotState;
+using quad_sdk::PackedStateV1;
+
+volatile float g_sink;
+
+template <typename Fn>
+double NanosPerCall(int iterations, Fn fn)
+{
+    for (int i = 0; i < iterations / 10; ++i) // warm-up
+        fn();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        fn();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+// Rebuilds a RobotState from the values in `values` (what a server does every update).
+void FillRobotState(const PackedStateV1& values, RobotState* state)
+{
+    state->Clear();
+    auto set = [](google::protobuf::RepeatedField<float>* field, const float* v, int n) { field->Add(v, v + n); };
+    set(state->mutable_jpos_leg(), values.jpos_leg, 12);
+    set(state->mutable_jpos_leg_des(), values.jpos_leg_des, 12);
+    set(state->mutable_jvel_leg(), values.jvel_leg, 12);
+    set(state->mutable_jtau_leg(), values.jtau_leg, 12);
+    set(state->mutable_jvel_leg_des(), values.jvel_leg_des, 12);
+    set(state->mutable_jtau_leg_des(), values.jtau_leg_des, 12);
+    set(state->mutable_pos_body(), values.pos_body, 3);
+    set(state->mutable_vel_body(), values.vel_body, 3);
+    set(state->mutable_acc_body(), values.acc_body, 3);
+    set(state->mutable_omega_body(), values.omega_body, 3);
+    set(state->mutable_ori_body(), values.ori_body, 3);
+    set(state->mutable_grf_left(), values.grf_left, 6);
+    set(state->mutable_grf_right(), values.grf_right, 6);
+    set(state->mutable_grf_vertical_filtered(), values.grf_vertical_filtered, 2);
+    set(state->mutable_temp(), &values.contact_force_left, 4);
+    set(state->mutable_temp(), values.reserved, 4);
+    set(state->mutable_temp(), &values.battery_voltage_1, 1);
+    set(state->mutable_temp(), &values.battery_voltage_2, 1);
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = (argc > 1) ? std::stoi(argv[1]) : 200000;
+    if (iterations < 1) {
+        std::cout << "Usage: " << argv[0] << " [iterations=200000]" << std::endl;
+        return 1;
+    }
+
+    // One realistic sample from the mock robot.
+    quad_sdk::MockRobotService robot;
+    grpc_comm::GetRobotStateRequest request;
+    grpc_comm::GetRobotStateResponse response;
+    robot.GetRobotState(nullptr, &request, &response);
+    PackedStateV1 values;
+    quad_sdk::ToPackedState(response.robot_state(), &values);
+
+    RobotState state;
+    PackedRobotState packed;
+    std::string wire;
+    PackedStateV1 out;
+
+    double proto_encode = NanosPerCall(iterations, [&] {
+        FillRobotState(values, &state);
+        state.SerializeToString(&wire);
+    });
+    FillRobotState(values, &state);
+    state.SerializeToString(&wire);
+    const std::string proto_wire = wire;
+    double proto_decode = NanosPerCall(iterations, [&] {
+        state.ParseFromString(proto_wire);
+        quad_sdk::ToPackedState(state, &out);
+        g_sink = out.battery_voltage_1;
+    });
+
+    double packed_encode = NanosPerCall(iterations, [&] {
+        quad_sdk::PackState(values, &packed);
+        packed.SerializeToString(&wire);
+    });
+    quad_sdk::PackState(values, &packed);
+    packed.SerializeToString(&wire);
+    const std::string packed_wire = wire;
+    double packed_decode = NanosPerCall(iterations, [&] {
+        packed.ParseFromString(packed_wire);
+        quad_sdk::UnpackState(packed, &out);
+        g_sink = out.battery_voltage_1;
+    });
+
+    std::cout << "State encoding, " << iterations << " iterations\n" << std::endl;
+    std::cout << std::left << std::setw(18) << "message" << std::right << std::setw(12) << "wire bytes" << std::setw(14)
+              << "encode ns" << std::setw(14) << "decode ns" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(18) << "RobotState" << std::right << std::setw(12) << proto_wire.size()
+              << std::setw(14) << proto_encode << std::setw(14) << proto_decode << std::endl;
+    std::cout << std::left << std::setw(18) << "PackedRobotState" << std::right << std::setw(12) << packed_wire.size()
+              << std::setw(14) << packed_encode << std::setw(14) << packed_decode << std::endl;
+    return 0;
+}
@@ -0,0 +1,243 @@
+// Robot state delivery: polling GetRobotState vs the StreamRobotState stream.
+//
+// Each mode delivers rate_hz state updates per second for duration_s seconds:
+//   poll           one unary GetRobotState call per update
+//   stream         StreamRobotState with all fields
+//   stream_mask    StreamRobotState with only jpos_leg and ori_body
+//   stream_packed  StreamRobotState with PackedRobotState updates
+// and reports achieved update rate, protobuf payload bytes/s, bytes/s on the wire
+// (loopback interface counters, so TCP/IP and HTTP/2 framing included) and CPU of
+// the client and of the server.
+//
+// Without a server address a MockRobotServer is forked into a child process so its
+// CPU can be measured separately; with an address only the client side is measured.
+//
+// Usage: ./bench_state_stream [rate_hz=100] [duration_s=5] [server_address]
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+#include "common/mock_robot.h"
+
+using grpc_comm::GetRobotStateRequest;
+using grpc_comm::GetRobotStateResponse;
+using grpc_comm::gRPCService;
+using grpc_comm::RobotStateUpdate;
+using grpc_comm::StreamRobotStateRequest;
+
+struct Counters
+{
+    double client_cpu_s;
+    double server_cpu_s; // < 0 when the server is not ours
+    long long wire_bytes; // < 0 when not measurable
+};
+
+double ProcessCpuSeconds()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+// utime + stime of another process from /proc/<pid>/stat.
+double ChildCpuSeconds(pid_t pid)
+{
+    std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+    std::string content((std::istreambuf_iterator<char>(stat)), std::istreambuf_iterator<char>());
+    // Fields after the parenthesised command name; utime and stime are fields 14 and 15.
+    std::istringstream rest(content.substr(content.rfind(')') + 2));
+    std::string field;
+    unsigned long long utime = 0, stime = 0;
+    for (int i = 3; i <= 15 && rest >> field; ++i) {
+        if (i == 14)
+            utime = std::stoull(field);
+        else if (i == 15)
+            stime = std::stoull(field);
+    }
+    return static_cast<double>(utime + stime) / sysconf(_SC_CLK_TCK);
+}
+
+// Bytes received on the loopback interface; every loopback packet is counted once.
+long long LoopbackBytes()
+{
+    std::ifstream dev("/proc/net/dev");
+    std::string line;
+    while (std::getline(dev, line)) {
+        auto colon = line.find(':');
+        if (colon == std::string::npos)
+            continue;
+        std::string name = line.substr(0, colon);
+        name.erase(0, name.find_first_not_of(' '));
+        if (name == "lo")
+            return std::stoll(line.substr(colon + 1));
+    }
+    return -1;
+}
+
+class StateBench
+{
+public:
+    StateBench(const std::string& server_address, pid_t server_pid)
+        : server_pid_(server_pid)
+    {
+        stub_ = gRPCService::NewStub(grpc::CreateChannel(server_address, grpc::InsecureChannelCredentials()));
+    }
+
+    // Connects the channel so connection setup is not part of the first measurement.
+    bool Connect()
+    {
+        grpc::ClientContext context;
+        context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+        GetRobotStateResponse response;
+        return stub_->GetRobotState(&context, GetRobotStateRequest(), &response).ok();
+    }
+
+    void Run(const std::string& mode, double rate_hz, double duration_s)
+    {
+        uint64_t updates = 0, payload_bytes = 0;
+        Counters before = Sample();
+        auto start = std::chrono::steady_clock::now();
+        auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                               std::chrono::duration<double>(duration_s));
+
+        if (mode == "poll") {
+            auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(1.0 / rate_hz));
+            GetRobotStateResponse response;
+            for (auto next = start; next < end; next += period) {
+                std::this_thread::sleep_until(next);
+                grpc::ClientContext context;
+                if (!stub_->GetRobotState(&context, GetRobotStateRequest(), &response).ok())
+                    break;
+                updates++;
+                payload_bytes += response.ByteSizeLong();
+            }
+        } else {
+            StreamRobotStateRequest request;
+            request.set_rate_hz(static_cast<float>(rate_hz));
+            if (mode == "stream_mask") {
+                request.add_fields("jpos_leg");
+                request.add_fields("ori_body");
+            }
+            request.set_packed(mode == "stream_packed");
+            grpc::ClientContext context;
+            auto reader = stub_->StreamRobotState(&context, request);
+            RobotStateUpdate update;
+            while (std::chrono::steady_clock::now() < end && reader->Read(&update)) {
+                updates++;
+                payload_bytes += update.ByteSizeLong();
+            }
+            context.TryCancel();
+            while (reader->Read(&update)) {
+            }
+            reader->Finish();
+        }
+
+        double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        Counters after = Sample();
+        std::cout << std::left << std::setw(14) << mode << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << updates / wall_s << std::setw(14) << payload_bytes / wall_s / 1024.0;
+        if (before.wire_bytes >= 0)
+            std::cout << std::setw(12) << (after.wire_bytes - before.wire_bytes) / wall_s / 1024.0;
+        else
+            std::cout << std::setw(12) << "-";
+        std::cout << std::setw(10) << 100.0 * (after.client_cpu_s - before.client_cpu_s) / wall_s;
+        if (server_pid_ > 0)
+            std::cout << std::setw(10) << 100.0 * (after.server_cpu_s - before.server_cpu_s) / wall_s;
+        else
+            std::cout << std::setw(10) << "-";
+        std::cout << std::endl;
+    }
+
+private:
+    Counters Sample() const
+    {
+        Counters c;
+        c.client_cpu_s = ProcessCpuSeconds();
+        c.server_cpu_s = server_pid_ > 0 ? ChildCpuSeconds(server_pid_) : -1.0;
+        c.wire_bytes = server_pid_ > 0 ? LoopbackBytes() : -1;
+        return c;
+    }
+
+    pid_t server_pid_;
+    std::unique_ptr<gRPCService::Stub> stub_;
+};
+
+int main(int argc, char** argv)
+{
+    double rate_hz = (argc > 1) ? std::stod(argv[1]) : 100.0;
+    double duration_s = (argc > 2) ? std::stod(argv[2]) : 5.0;
+    std::string server_address = (argc > 3) ? argv[3] : "";
+    if (rate_hz <= 0.0 || duration_s <= 0.0) {
+        std::cout << "Usage: " << argv[0] << " [rate_hz=100] [duration_s=5] [server_address]" << std::endl;
+        return 1;
+    }
+
+    pid_t server_pid = 0;
+    int stop_pipe[2] = {-1, -1};
+    if (server_address.empty()) {
+        // Fork before gRPC is initialised in this process: the child runs the mock robot,
+        // reports its port through one pipe and exits when the other one is closed.
+        int port_pipe[2];
+        if (pipe(port_pipe) != 0 || pipe(stop_pipe) != 0) {
+            std::cout << "pipe() failed" << std::endl;
+            return 1;
+        }
+        server_pid = fork();
+        if (server_pid == 0) {
+            close(port_pipe[0]);
+            close(stop_pipe[1]);
+            quad_sdk::MockRobotServer server;
+            int port = 0;
+            if (server.Start("127.0.0.1:0"))
+                port = std::stoi(server.Address().substr(server.Address().rfind(':') + 1));
+            if (write(port_pipe[1], &port, sizeof(port)) != sizeof(port))
+                _exit(1);
+            char c;
+            while (read(stop_pipe[0], &c, 1) > 0) {
+            }
+            server.Shutdown();
+            _exit(0);
+        }
+        close(port_pipe[1]);
+        close(stop_pipe[0]);
+        int port = 0;
+        if (server_pid < 0 || read(port_pipe[0], &port, sizeof(port)) != sizeof(port) || port == 0) {
+            std::cout << "Failed to start the mock robot" << std::endl;
+            return 1;
+        }
+        server_address = "127.0.0.1:" + std::to_string(port);
+    }
+
+    StateBench bench(server_address, server_pid);
+    int result = 0;
+    if (!bench.Connect()) {
+        std::cout << "Cannot reach " << server_address << std::endl;
+        result = 1;
+    } else {
+        std::cout << "Target: " << server_address << (server_pid > 0 ? " (forked mock robot)" : "") << ", " << rate_hz
+                  << " updates/s for " << duration_s << " s per mode\n"
+                  << std::endl;
+        std::cout << std::left << std::setw(14) << "mode" << std::right << std::setw(10) << "updates/s" << std::setw(14)
+                  << "payload KiB/s" << std::setw(12) << "wire KiB/s" << std::setw(10) << "client %" << std::setw(10)
+                  << "server %" << std::endl;
+        for (const char* mode : {"poll", "stream", "stream_mask", "stream_packed"})
+            bench.Run(mode, rate_hz, duration_s);
+    }
+
+    if (server_pid > 0) {
+        close(stop_pipe[1]);
+        waitpid(server_pid, nullptr, 0);
+    }
+    return result;
+}
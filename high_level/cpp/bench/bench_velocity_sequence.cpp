@@ -0,0 +1,141 @@
+// Velocity sequence encoding: "vx,vy,wz,duration;..." string vs typed VelocitySegments.
+//
+// Per encoding, measures the serialized size of a walk Motion carrying the sequence and
+//   encode   client side: build the sequence from setpoints, attach it to the motion, serialize
+//   decode   robot side: parse the motion and turn the parameter into numeric segments
+// The text form uses the shortest round-tripping decimals, so both carry exactly the
+// same float values. Before timing, the e4 walk demo must encode to the exact string
+// robot firmware has always been sent; the bench exits 1 if it does not.
+//
+// Usage: ./bench_velocity_sequence [segments=10000] [iterations=200]
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "proto/grpc_service.pb.h"
+#include "common/velocity_sequence.h"
+
+using grpc_comm::Motion;
+using grpc_comm::VelocitySegments;
+
+volatile double g_sink;
+
+template <typename Fn>
+double MicrosPerCall(int iterations, Fn fn)
+{
+    for (int i = 0; i < iterations / 10 + 1; ++i) // warm-up
+        fn();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        fn();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+struct Setpoint
+{
+    float vx, vy, wz, duration_s;
+};
+
+double TotalDuration(const VelocitySegments& segments)
+{
+    double total = 0.0;
+    for (const auto& s : segments.segments())
+        total += s.duration_s();
+    return total;
+}
+
+// The e4 walk demo, as sent before VelocitySequenceBuilder existed.
+bool CheckWalkDemoText()
+{
+    const std::string expected =
+        "0.0,0.0,0.6,3.0;0.0,0.0,-0.6,3.0;0.0,0.0,0.0,1.0;0.6,0.0,0.0,3.0;-0.6,0.0,0.0,3.0;0.0,0.0,0.0,1.0;";
+    quad_sdk::VelocitySequenceBuilder velocity;
+    velocity.Add(0.0f, 0.0f, 0.6f, 3.0f)
+        .Add(0.0f, 0.0f, -0.6f, 3.0f)
+        .Hold(1.0f)
+        .Add(0.6f, 0.0f, 0.0f, 3.0f)
+        .Add(-0.6f, 0.0f, 0.0f, 3.0f)
+        .Hold(1.0f);
+    if (velocity.ToText() == expected)
+        return true;
+    std::cerr << "Walk demo encodes as " << velocity.ToText() << "\n            expected " << expected << std::endl;
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    int segments = (argc > 1) ? std::stoi(argv[1]) : 10000;
+    int iterations = (argc > 2) ? std::stoi(argv[2]) : 200;
+    if (segments < 1 || iterations < 1) {
+        std::cout << "Usage: " << argv[0] << " [segments=10000] [iterations=200]" << std::endl;
+        return 1;
+    }
+    if (!CheckWalkDemoText())
+        return 1;
+
+    // A choreography with non-round values, as a planner would produce.
+    std::vector<Setpoint> setpoints(segments);
+    for (int i = 0; i < segments; ++i) {
+        double t = i * 0.1;
+        setpoints[i] = {static_cast<float>(0.5 * std::sin(t)), static_cast<float>(0.2 * std::cos(0.7 * t)),
+                        static_cast<float>(0.6 * std::sin(0.3 * t + 1.0)), static_cast<float>(0.05 + 0.01 * (i % 7))};
+    }
+
+    quad_sdk::VelocitySequenceBuilder builder;
+    Motion motion;
+    std::string wire;
+    auto build = [&] {
+        builder.Clear();
+        builder.Reserve(setpoints.size());
+        for (const auto& s : setpoints)
+            builder.Add(s.vx, s.vy, s.wz, s.duration_s);
+        motion.Clear();
+        motion.set_motion_id("walk");
+    };
+
+    double text_encode = MicrosPerCall(iterations, [&] {
+        build();
+        builder.AddTo(&motion);
+        motion.SerializeToString(&wire);
+    });
+    const std::string text_wire = wire;
+
+    double typed_encode = MicrosPerCall(iterations, [&] {
+        build();
+        builder.AddTypedTo(&motion);
+        motion.SerializeToString(&wire);
+    });
+    const std::string typed_wire = wire;
+
+    VelocitySegments parsed;
+    std::string error;
+    double text_decode = MicrosPerCall(iterations, [&] {
+        motion.ParseFromString(text_wire);
+        if (!quad_sdk::ParseVelocitySequence(motion.parameters(0).string_value(), &parsed, &error))
+            std::cerr << "Parse failed: " << error << std::endl;
+        g_sink = TotalDuration(parsed);
+    });
+    double text_total = TotalDuration(parsed);
+
+    double typed_decode = MicrosPerCall(iterations, [&] {
+        motion.ParseFromString(typed_wire);
+        g_sink = TotalDuration(motion.parameters(0).velocity_segments());
+    });
+    double typed_total = TotalDuration(motion.parameters(0).velocity_segments());
+
+    std::cout << "Velocity sequence encoding, " << segments << " segments, " << iterations << " iterations\n"
+              << std::endl;
+    std::cout << std::left << std::setw(18) << "encoding" << std::right << std::setw(12) << "wire bytes"
+              << std::setw(14) << "encode us" << std::setw(14) << "decode us" << std::setw(16) << "duration s"
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(18) << "text" << std::right << std::setw(12) << text_wire.size()
+              << std::setw(14) << text_encode << std::setw(14) << text_decode << std::setw(16)
+              << std::setprecision(3) << text_total << std::setprecision(1) << std::endl;
+    std::cout << std::left << std::setw(18) << "velocity_segments" << std::right << std::setw(12)
+              << typed_wire.size() << std::setw(14) << typed_encode << std::setw(14) << typed_decode << std::setw(16)
+              << std::setprecision(3) << typed_total << std::endl;
+    return text_total == typed_total ? 0 : 1;
+}
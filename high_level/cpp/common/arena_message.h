@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <google/protobuf/arena.h>
+
+namespace quad_sdk {
+
+// A protobuf message on an arena whose first block lives inside this object. Reset()
+// hands back an empty message and drops everything the previous one allocated, so a
+// request or response reused call after call stays off the heap as long as it fits in
+// kBlockSize (a RobotState is about 1 KiB, a 10-motion sequence about 2 KiB).
+//
+//   quad_sdk::ArenaMessage<grpc_comm::ExecuteSequenceRequest> request;
+//   while (running) {
+//       auto& r = request.Reset();
+//       ... fill r, send it ...
+//   }
+//
+// Parsing or building on another thread than the one that called Reset() gives that
+// thread its own (heap) block inside the arena; Reset() frees those again.
+template <typename Message, size_t kBlockSize = 4096>
+class ArenaMessage
+{
+public:
+    ArenaMessage()
+        : arena_(Options(block_))
+        , message_(google::protobuf::Arena::CreateMessage<Message>(&arena_))
+    {
+    }
+
+    ArenaMessage(const ArenaMessage&) = delete;
+    ArenaMessage& operator=(const ArenaMessage&) = delete;
+
+    Message& Reset()
+    {
+        arena_.Reset();
+        message_ = google::protobuf::Arena::CreateMessage<Message>(&arena_);
+        return *message_;
+    }
+
+    Message* get() { return message_; }
+    const Message* get() const { return message_; }
+    Message& operator*() { return *message_; }
+    const Message& operator*() const { return *message_; }
+    Message* operator->() { return message_; }
+    const Message* operator->() const { return message_; }
+
+    // Bytes handed out by the arena since the last Reset().
+    uint64_t SpaceUsed() const { return arena_.SpaceUsed(); }
+
+private:
+    static google::protobuf::ArenaOptions Options(char* block)
+    {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = block;
+        options.initial_block_size = kBlockSize;
+        return options;
+    }
+
+    alignas(8) char block_[kBlockSize]; // declared before arena_, which points into it
+    google::protobuf::Arena arena_;
+    Message* message_;
+};
+
+} // namespace quad_sdk
@@ -0,0 +1,92 @@
+#include "common/control_session.h"
+
+namespace quad_sdk {
+
+ControlSession::ControlSession(RobotClient& client, EventCallback on_event)
+    : on_event_(std::move(on_event))
+    , next_id_(1)
+    , writes_done_(false)
+    , finished_(false)
+{
+    stream_ = client.Stub()->ControlSession(&context_);
+    reader_ = std::thread(&ControlSession::ReadLoop, this);
+}
+
+ControlSession::~ControlSession()
+{
+    if (!finished_) {
+        Cancel();
+        Finish();
+    }
+}
+
+uint64_t ControlSession::Start(const grpc_comm::MotionSequence& sequence)
+{
+    grpc_comm::ControlCommand command;
+    *command.mutable_start() = sequence;
+    return Send(&command);
+}
+
+uint64_t ControlSession::Append(const grpc_comm::Motion& motion)
+{
+    grpc_comm::ControlCommand command;
+    *command.mutable_append() = motion;
+    return Send(&command);
+}
+
+uint64_t ControlSession::SetVelocity(float vx, float vy, float wz, float timeout_s)
+{
+    grpc_comm::ControlCommand command;
+    auto* setpoint = command.mutable_velocity();
+    setpoint->set_vx(vx);
+    setpoint->set_vy(vy);
+    setpoint->set_wz(wz);
+    setpoint->set_timeout_s(timeout_s);
+    return Send(&command);
+}
+
+uint64_t ControlSession::Stop()
+{
+    grpc_comm::ControlCommand command;
+    command.set_stop(true);
+    return Send(&command);
+}
+
+uint64_t ControlSession::Send(grpc_comm::ControlCommand* command)
+{
+    // A sync stream allows one writer at a time.
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    if (writes_done_)
+        return 0;
+    uint64_t id = next_id_++;
+    command->set_command_id(id);
+    return stream_->Write(*command) ? id : 0;
+}
+
+grpc::Status ControlSession::Finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (!writes_done_) {
+            writes_done_ = true;
+            stream_->WritesDone();
+        }
+    }
+    if (!finished_) {
+        reader_.join();
+        status_ = stream_->Finish();
+        finished_ = true;
+    }
+    return status_;
+}
+
+void ControlSession::ReadLoop()
+{
+    grpc_comm::ControlEvent event;
+    while (stream_->Read(&event)) {
+        if (on_event_)
+            on_event_(event);
+    }
+}
+
+} // namespace quad_sdk
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+#include "common/robot_client.h"
+
+namespace quad_sdk {
+
+// Client side of the ControlSession RPC: queue motions and steer the running gait
+// while the robot executes, without cancelling and resubmitting sequences.
+//
+//   quad_sdk::ControlSession session(client, [](const grpc_comm::ControlEvent& e) { ... });
+//   session.Start(sequence);                 // e.g. path_to_state WALK, then walk
+//   while (perceiving)
+//       session.SetVelocity(vx, 0, wz, 0.2); // 20-50 Hz; robot zeroes velocity after 0.2 s of silence
+//   session.Append(stand_down);
+//   session.Finish();                        // wait for the queue to drain
+//
+// Every command gets an id (returned, 0 if the stream is broken) that the robot echoes
+// in the ACCEPTED/REJECTED event and in the events of the motions it queued. Events
+// arrive on an internal reader thread; keep the callback short. Commands may be sent
+// from any thread.
+class ControlSession
+{
+public:
+    using EventCallback = std::function<void(const grpc_comm::ControlEvent&)>;
+
+    ControlSession(RobotClient& client, EventCallback on_event);
+    ~ControlSession();
+
+    ControlSession(const ControlSession&) = delete;
+    ControlSession& operator=(const ControlSession&) = delete;
+
+    uint64_t Start(const grpc_comm::MotionSequence& sequence);
+    uint64_t Append(const grpc_comm::Motion& motion);
+    uint64_t SetVelocity(float vx, float vy, float wz, float timeout_s);
+    uint64_t Stop();
+
+    // Closes the sending side and waits until the robot has finished the queued
+    // motions and ended the session.
+    grpc::Status Finish();
+    // Ends the session immediately; Finish() then reports CANCELLED.
+    void Cancel() { context_.TryCancel(); }
+
+private:
+    uint64_t Send(grpc_comm::ControlCommand* command);
+    void ReadLoop();
+
+    EventCallback on_event_;
+    grpc::ClientContext context_;
+    std::unique_ptr<grpc::ClientReaderWriter<grpc_comm::ControlCommand, grpc_comm::ControlEvent>> stream_;
+    std::mutex write_mutex_;
+    uint64_t next_id_;
+    bool writes_done_;
+    bool finished_;
+    grpc::Status status_;
+    std::thread reader_;
+};
+
+} // namespace quad_sdk
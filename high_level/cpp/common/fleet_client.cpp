@@ -0,0 +1,82 @@
+#include "common/fleet_client.h"
+
+#include <algorithm>
+
+namespace quad_sdk {
+
+int64_t WallClockMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+FleetClient::FleetClient(const std::vector<std::string>& addresses)
+    : state_latency_(addresses.size())
+{
+    for (const auto& address : addresses)
+        robots_.emplace_back(new RobotClient(address));
+}
+
+std::vector<std::shared_ptr<SequenceCall>> FleetClient::ExecuteSequence(
+    const grpc_comm::ExecuteSequenceRequest& request, std::chrono::milliseconds lead, int64_t* start_time_us)
+{
+    grpc_comm::ExecuteSequenceRequest scheduled = request;
+    scheduled.set_start_time_us(WallClockMicros()
+                                + std::chrono::duration_cast<std::chrono::microseconds>(lead).count());
+    if (start_time_us)
+        *start_time_us = scheduled.start_time_us();
+
+    std::vector<std::shared_ptr<SequenceCall>> calls;
+    calls.reserve(robots_.size());
+    for (auto& robot : robots_)
+        calls.push_back(robot->ExecuteSequence(scheduled));
+    return calls;
+}
+
+std::vector<FleetState> FleetClient::GetRobotState(const grpc_comm::GetRobotStateRequest& request)
+{
+    using Clock = std::chrono::steady_clock;
+    std::vector<FleetState> states(robots_.size());
+    std::vector<Clock::time_point> received(robots_.size());
+    auto sent = Clock::now();
+    for (size_t i = 0; i < robots_.size(); ++i) {
+        // The callback runs on robot i's completion queue thread before Wait() returns.
+        states[i].call = robots_[i]->GetRobotState(
+            request, [&received, i](const grpc::Status&, const grpc_comm::GetRobotStateResponse&) {
+                received[i] = Clock::now();
+            });
+    }
+    for (size_t i = 0; i < robots_.size(); ++i) {
+        states[i].call->Wait();
+        states[i].latency_us = std::chrono::duration<double, std::micro>(received[i] - sent).count();
+        if (states[i].call->status().ok())
+            state_latency_[i].Add(states[i].latency_us);
+    }
+    return states;
+}
+
+void FleetClient::CancelAll()
+{
+    for (auto& robot : robots_)
+        robot->CancelAll();
+}
+
+StartSkew MeasureStartSkew(const std::vector<std::shared_ptr<SequenceCall>>& calls, int64_t start_time_us)
+{
+    StartSkew skew;
+    int64_t earliest = 0, latest = 0;
+    for (const auto& call : calls) {
+        if (!call->Done() || !call->status().ok() || call->response().started_at_us() == 0)
+            continue;
+        int64_t started = call->response().started_at_us();
+        earliest = skew.robots == 0 ? started : std::min(earliest, started);
+        latest = skew.robots == 0 ? started : std::max(latest, started);
+        double late = static_cast<double>(started - start_time_us);
+        skew.max_late_us = skew.robots == 0 ? late : std::max(skew.max_late_us, late);
+        skew.robots++;
+    }
+    skew.skew_us = static_cast<double>(latest - earliest);
+    return skew;
+}
+
+} // namespace quad_sdk
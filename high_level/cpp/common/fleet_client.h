@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+#include "common/latency_stats.h"
+#include "common/robot_client.h"
+
+namespace quad_sdk {
+
+// One robot's answer to a fleet-wide state query.
+struct FleetState
+{
+    std::shared_ptr<StateCall> call; // status() and response()
+    double latency_us;               // request sent -> response received
+};
+
+// Spread of the actual start times reported by the robots (started_at_us).
+struct StartSkew
+{
+    size_t robots = 0;          // robots that reported a start
+    double skew_us = 0.0;       // latest start - earliest start
+    double max_late_us = 0.0;   // worst start relative to the scheduled start_time_us
+};
+
+// Drives several robots as one: one RobotClient (channel and completion queue thread)
+// per robot, every RPC fanned out to all of them concurrently.
+//
+//   quad_sdk::FleetClient fleet({"192.168.5.2:50051", "192.168.5.3:50051"});
+//   int64_t start_us;
+//   auto calls = fleet.ExecuteSequence(request, std::chrono::milliseconds(500), &start_us);
+//   for (auto& call : calls) call->Wait();
+//   quad_sdk::StartSkew skew = quad_sdk::MeasureStartSkew(calls, start_us);
+//
+// Synchronized starts rely on start_time_us, which the robots interpret on their own
+// wall clocks, so the robots (and this host) need synchronized clocks (NTP, PTP).
+class FleetClient
+{
+public:
+    explicit FleetClient(const std::vector<std::string>& addresses);
+
+    FleetClient(const FleetClient&) = delete;
+    FleetClient& operator=(const FleetClient&) = delete;
+
+    size_t Size() const { return robots_.size(); }
+    RobotClient& Robot(size_t index) { return *robots_[index]; }
+
+    // Sends `request` to every robot with start_time_us set to now + lead, which must
+    // cover the time to reach the slowest robot. Returns one call per robot, in order.
+    std::vector<std::shared_ptr<SequenceCall>> ExecuteSequence(const grpc_comm::ExecuteSequenceRequest& request,
+                                                               std::chrono::milliseconds lead,
+                                                               int64_t* start_time_us = nullptr);
+
+    // Queries every robot at once and waits for all answers. Latencies are also added
+    // to the per-robot StateLatency() statistics.
+    std::vector<FleetState> GetRobotState(const grpc_comm::GetRobotStateRequest& request = {});
+    LatencyStats& StateLatency(size_t index) { return state_latency_[index]; }
+
+    void CancelAll();
+
+private:
+    std::vector<std::unique_ptr<RobotClient>> robots_;
+    std::vector<LatencyStats> state_latency_;
+};
+
+// Start skew over the calls that completed successfully.
+StartSkew MeasureStartSkew(const std::vector<std::shared_ptr<SequenceCall>>& calls, int64_t start_time_us);
+
+// Wall-clock time in the unit of start_time_us / started_at_us.
+int64_t WallClockMicros();
+
+} // namespace quad_sdk
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace quad_sdk {
+
+// Latency samples in microseconds with exact percentiles. Meant for benchmarks and
+// load tests: each worker thread fills its own instance and the results are merged
+// once at the end, so Add() needs no locking.
+class LatencyStats
+{
+public:
+    void Add(double us)
+    {
+        samples_.push_back(us);
+        sorted_ = false;
+    }
+
+    void Merge(const LatencyStats& other)
+    {
+        samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+        sorted_ = false;
+    }
+
+    size_t Count() const { return samples_.size(); }
+
+    double Mean() const
+    {
+        double sum = 0.0;
+        for (double s : samples_)
+            sum += s;
+        return samples_.empty() ? 0.0 : sum / samples_.size();
+    }
+
+    // p in [0, 100]; nearest-rank on the sorted samples.
+    double Percentile(double p)
+    {
+        if (samples_.empty())
+            return 0.0;
+        Sort();
+        size_t rank = static_cast<size_t>(p / 100.0 * (samples_.size() - 1) + 0.5);
+        return samples_[std::min(rank, samples_.size() - 1)];
+    }
+
+    double Max()
+    {
+        Sort();
+        return samples_.empty() ? 0.0 : samples_.back();
+    }
+
+    void Print(std::ostream& os, const std::string& label)
+    {
+        std::ios::fmtflags flags = os.flags();
+        std::streamsize precision = os.precision();
+        os << std::fixed << std::setprecision(1) << label << ": n=" << Count() << " mean=" << Mean()
+           << "us p50=" << Percentile(50) << "us p90=" << Percentile(90) << "us p99=" << Percentile(99)
+           << "us max=" << Max() << "us" << std::endl;
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+private:
+    void Sort()
+    {
+        if (!sorted_)
+            std::sort(samples_.begin(), samples_.end());
+        sorted_ = true;
+    }
+
+    std::vector<double> samples_;
+    bool sorted_ = true;
+};
+
+} // namespace quad_sdk
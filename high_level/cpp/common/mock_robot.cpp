@@ -0,0 +1,701 @@
+#include "common/mock_robot.h"
+#include "common/packed_state.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace quad_sdk {
+
+namespace {
+
+const double kDefaultBpm = 120.0;
+const double kStateSwitchSeconds = 1.5;
+const double kDefaultStreamHz = 50.0;
+const double kMaxStreamHz = 500.0;
+const double kPi = 3.14159265358979323846;
+
+// Nominal standing pose per leg (hip, thigh, knee), mirrored left/right.
+const float kStandPose[12] = {-0.05f, 0.85f, -1.70f, 0.05f, 0.85f, -1.70f,
+                              -0.05f, 0.85f, -1.70f, 0.05f, 0.85f, -1.70f};
+
+// Parses "vx,vy,wz,duration;..." and returns the total duration, or -1 if malformed.
+double VelocityTextDuration(const std::string& text)
+{
+    double total = 0.0;
+    std::stringstream segments(text);
+    std::string segment;
+    while (std::getline(segments, segment, ';')) {
+        if (segment.empty())
+            continue;
+        std::stringstream fields(segment);
+        std::string field;
+        int n = 0;
+        double value = 0.0;
+        while (std::getline(fields, field, ',')) {
+            char* end = nullptr;
+            value = std::strtod(field.c_str(), &end);
+            if (end == field.c_str())
+                return -1.0;
+            n++;
+        }
+        if (n != 4 || value < 0.0)
+            return -1.0;
+        total += value;
+    }
+    return total;
+}
+
+// Total duration of a velocity_sequence parameter in either form, or -1 if malformed.
+double VelocitySequenceDuration(const grpc_comm::Parameter& param)
+{
+    if (param.value_case() != grpc_comm::Parameter::kVelocitySegments)
+        return VelocityTextDuration(param.string_value());
+    double total = 0.0;
+    for (const auto& segment : param.velocity_segments().segments()) {
+        if (!std::isfinite(segment.vx()) || !std::isfinite(segment.vy()) || !std::isfinite(segment.wz())
+            || !(segment.duration_s() >= 0.0f) || !std::isfinite(segment.duration_s()))
+            return -1.0;
+        total += segment.duration_s();
+    }
+    return total;
+}
+
+// An unset or empty velocity_sequence leaves a gait running open-ended.
+bool IsEmptyVelocitySequence(const grpc_comm::Parameter* param)
+{
+    if (!param)
+        return true;
+    if (param->value_case() == grpc_comm::Parameter::kVelocitySegments)
+        return param->velocity_segments().segments_size() == 0;
+    return param->string_value().empty();
+}
+
+int64_t WallClockMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+const grpc_comm::Parameter* FindParam(const grpc_comm::Motion& motion, const std::string& key)
+{
+    for (const auto& param : motion.parameters()) {
+        if (param.key() == key)
+            return &param;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+MockRobotService::MockRobotService(double time_scale)
+    : time_scale_(time_scale)
+    , start_(std::chrono::steady_clock::now())
+    , calls_(0)
+    , executions_(0)
+    , generation_(0)
+{
+    const char* switches[][3] = {
+        {"passive", "PASSIVE", "Trigger FSM to PASSIVE once"},
+        {"stand_down", "STAND_DOWN", "Trigger FSM to STAND_DOWN once"},
+        {"stand_up", "STAND_UP", "Trigger FSM to STAND_UP once"},
+        {"x_legs", "STAND_UP", "Trigger FSM to X_LEGS once"},
+        {"balance_stand", "BALANCE_STAND", "Trigger FSM to BALANCE_STAND once"},
+        {"wave", "WAVE", "Trigger FSM to WAVE once"},
+        {"dance0", "DANCE0", "Trigger FSM to DANCE0 once"},
+        {"jump", "JUMP", "Trigger FSM to JUMP once"},
+        {"backflip", "BACK_FLIP", "Trigger FSM to BACK_FLIP once"},
+        {"kill_robot", "", "Stop all motion and switch to PASSIVE"},
+    };
+    for (const auto& s : switches)
+        AddMotion(s[0], s[1], s[2], kStateSwitchSeconds);
+
+    AddMotion("path_to_state", "", "Find and execute the FSM transition path to target_state", 2 * kStateSwitchSeconds);
+    AddStringParam("path_to_state", "target_state", "BALANCE_STAND");
+
+    const char* gaits[][3] = {
+        {"walk", "WALK", "Trigger FSM to WALK with velocity sequence support"},
+        {"flying_trot", "FLYING_TROT", "Trigger FSM to FLYING_TROT with velocity sequence support"},
+        {"rl", "RL", "Trigger FSM to RL with velocity sequence support"},
+    };
+    for (const auto& g : gaits) {
+        AddMotion(g[0], g[1], g[2], 0.0);
+        AddStringParam(g[0], "velocity_sequence", "");
+    }
+
+    const char* balance[][2] = {
+        {"balance_pitch", "Control robot pitch angle in balance stand with sinusoidal motion"},
+        {"balance_yaw", "Control robot yaw angle in balance stand with sinusoidal motion"},
+        {"balance_roll", "Control robot roll angle in balance stand with sinusoidal motion"},
+        {"balance_height", "Control robot body height in balance stand with sinusoidal motion"},
+        {"balance_neutral", "Return to neutral posture in balance stand"},
+    };
+    for (const auto& b : balance) {
+        AddMotion(b[0], "BALANCE_STAND", b[1], 0.0);
+        AddFloatParam(b[0], "beats", 1.0f);
+        AddFloatParam(b[0], "amplitude", 1.0f);
+    }
+    catalogue_version_ = CatalogueVersion();
+}
+
+std::string MockRobotService::CatalogueVersion() const
+{
+    // FNV-1a over everything a client can observe, in catalogue order.
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](const std::string& bytes) {
+        for (unsigned char c : bytes) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        hash ^= 0xff; // field separator
+        hash *= 1099511628211ull;
+    };
+    std::string bytes;
+    for (const auto& entry : catalogue_) {
+        entry.second.defaults.SerializeToString(&bytes);
+        mix(bytes);
+        mix(entry.second.description);
+        mix(entry.second.fsm_state);
+    }
+    char version[17];
+    std::snprintf(version, sizeof(version), "%016llx", static_cast<unsigned long long>(hash));
+    return version;
+}
+
+void MockRobotService::AddMotion(const std::string& id, const std::string& fsm_state, const std::string& description,
+                                 double fixed_duration_s)
+{
+    MotionInfo& info = catalogue_[id];
+    info.defaults.set_motion_id(id);
+    info.description = description;
+    info.fsm_state = fsm_state;
+    info.fixed_duration_s = fixed_duration_s;
+}
+
+void MockRobotService::AddFloatParam(const std::string& id, const std::string& key, float value)
+{
+    auto* param = catalogue_[id].defaults.add_parameters();
+    param->set_key(key);
+    param->set_float_value(value);
+}
+
+void MockRobotService::AddStringParam(const std::string& id, const std::string& key, const std::string& value)
+{
+    auto* param = catalogue_[id].defaults.add_parameters();
+    param->set_key(key);
+    param->set_string_value(value);
+}
+
+grpc::Status MockRobotService::GetAvailableMotions(grpc::ServerContext* /*context*/,
+                                                   const grpc_comm::GetMotionsRequest* request,
+                                                   grpc_comm::GetMotionsResponse* response)
+{
+    calls_++;
+    response->set_success(true);
+    response->set_catalogue_version(catalogue_version_);
+    if (!request->if_none_match().empty() && request->if_none_match() == catalogue_version_) {
+        response->set_not_modified(true);
+        response->set_message("Mock robot: catalogue not modified");
+        return grpc::Status::OK;
+    }
+    for (const auto& entry : catalogue_) {
+        const MotionInfo& info = entry.second;
+        if (!request->fsm_state().empty() && !info.fsm_state.empty() && info.fsm_state != request->fsm_state())
+            continue;
+        *response->add_motions() = info.defaults;
+        (*response->mutable_descriptions())[entry.first] = info.description;
+    }
+    response->set_message("Mock robot: " + std::to_string(response->motions_size()) + " motions");
+    return grpc::Status::OK;
+}
+
+double MockRobotService::MotionDuration(const grpc_comm::Motion& motion, double bpm, std::string* error) const
+{
+    auto it = catalogue_.find(motion.motion_id());
+    if (it == catalogue_.end()) {
+        *error = "Unknown motion: " + motion.motion_id();
+        return -1.0;
+    }
+    const MotionInfo& info = it->second;
+    const grpc_comm::Parameter* beats = FindParam(motion, "beats");
+    if (!beats)
+        beats = FindParam(info.defaults, "beats");
+    const grpc_comm::Parameter* velocity = FindParam(motion, "velocity_sequence");
+
+    if (beats) {
+        double value;
+        if (beats->value_case() == grpc_comm::Parameter::kFloatValue)
+            value = beats->float_value();
+        else if (beats->value_case() == grpc_comm::Parameter::kIntValue)
+            value = beats->int_value();
+        else
+            value = -1.0;
+        if (!(value > 0.0)) {
+            *error = "beats for " + motion.motion_id() + " must be a positive number";
+            return -1.0;
+        }
+        return value * 60.0 / bpm;
+    }
+    if (velocity) {
+        double d = VelocitySequenceDuration(*velocity);
+        if (d < 0.0)
+            *error = "Malformed velocity_sequence for " + motion.motion_id();
+        return d;
+    }
+    return info.fixed_duration_s;
+}
+
+double MockRobotService::SequenceDuration(const grpc_comm::MotionSequence& sequence, std::string* error) const
+{
+    double bpm = sequence.bpm() > 0.0f ? sequence.bpm() : kDefaultBpm;
+    double total = 0.0;
+    for (const auto& motion : sequence.motions()) {
+        double d = MotionDuration(motion, bpm, error);
+        if (d < 0.0)
+            return -1.0;
+        total += d;
+    }
+    return total;
+}
+
+bool MockRobotService::IsGait(const std::string& motion_id) const
+{
+    auto it = catalogue_.find(motion_id);
+    return it != catalogue_.end() && FindParam(it->second.defaults, "velocity_sequence") != nullptr;
+}
+
+grpc::Status MockRobotService::ExecuteSequence(grpc::ServerContext* context,
+                                               const grpc_comm::ExecuteSequenceRequest* request,
+                                               grpc_comm::ExecuteSequenceResponse* response)
+{
+    calls_++;
+    std::string error;
+    double duration_s = SequenceDuration(request->sequence(), &error);
+    if (duration_s < 0.0) {
+        response->set_success(false);
+        response->set_message(error);
+        return grpc::Status::OK;
+    }
+
+    uint64_t generation = ++generation_;
+    response->set_execution_id("mock_exec_" + std::to_string(++executions_));
+
+    // A scheduled start is wall-clock time and is not scaled.
+    auto start = std::chrono::steady_clock::now();
+    if (request->start_time_us() > 0) {
+        start += std::chrono::microseconds(request->start_time_us() - WallClockMicros());
+        while (std::chrono::steady_clock::now() < start) {
+            if (context->IsCancelled())
+                return grpc::Status(grpc::StatusCode::CANCELLED, "Sequence cancelled");
+            if (generation_.load() != generation) {
+                response->set_success(false);
+                response->set_message("Preempted by a newer sequence");
+                return grpc::Status::OK;
+            }
+            auto slice = std::chrono::steady_clock::now() + std::chrono::milliseconds(5);
+            std::this_thread::sleep_until(std::min(start, slice));
+        }
+    }
+    response->set_started_at_us(WallClockMicros());
+
+    bool loop = request->sequence().loop();
+    auto deadline = std::max(start, std::chrono::steady_clock::now())
+                    + std::chrono::microseconds(static_cast<int64_t>(duration_s * time_scale_ * 1e6));
+    while (loop || std::chrono::steady_clock::now() < deadline) {
+        if (context->IsCancelled())
+            return grpc::Status(grpc::StatusCode::CANCELLED, "Sequence cancelled");
+        if (generation_.load() != generation) {
+            response->set_success(false);
+            response->set_message("Preempted by a newer sequence");
+            return grpc::Status::OK;
+        }
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(loop ? std::chrono::milliseconds(5)
+                                         : std::min<std::chrono::steady_clock::duration>(
+                                               remaining, std::chrono::milliseconds(5)));
+    }
+
+    response->set_success(true);
+    response->set_message("Sequence completed");
+    return grpc::Status::OK;
+}
+
+grpc::Status MockRobotService::GetRobotState(grpc::ServerContext* /*context*/,
+                                             const grpc_comm::GetRobotStateRequest* request,
+                                             grpc_comm::GetRobotStateResponse* response)
+{
+    calls_++;
+    if (request->packed()) {
+        grpc_comm::RobotState state;
+        FillRobotState(&state);
+        PackedStateV1 packed;
+        ToPackedState(state, &packed);
+        PackState(packed, response->mutable_packed_state());
+    } else {
+        FillRobotState(response->mutable_robot_state());
+    }
+    response->set_success(true);
+    response->set_message("State retrieved");
+    return grpc::Status::OK;
+}
+
+grpc::Status MockRobotService::StreamRobotState(grpc::ServerContext* context,
+                                                const grpc_comm::StreamRobotStateRequest* request,
+                                                grpc::ServerWriter<grpc_comm::RobotStateUpdate>* writer)
+{
+    calls_++;
+    const auto* descriptor = grpc_comm::RobotState::descriptor();
+    std::vector<const google::protobuf::FieldDescriptor*> fields;
+    for (const auto& name : request->fields()) {
+        const auto* field = descriptor->FindFieldByName(name);
+        if (!field)
+            return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "Unknown RobotState field: " + name);
+        fields.push_back(field);
+    }
+
+    double rate_hz = request->rate_hz() > 0.0f ? std::min<double>(request->rate_hz(), kMaxStreamHz) : kDefaultStreamHz;
+    auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / rate_hz));
+
+    grpc_comm::RobotStateUpdate update;
+    grpc_comm::RobotState full;
+    PackedStateV1 packed;
+    auto next = std::chrono::steady_clock::now();
+    for (uint64_t seq = 0; !context->IsCancelled(); ++seq) {
+        auto now = std::chrono::steady_clock::now();
+        while (now < next && !context->IsCancelled()) {
+            // Sleep in slices so slow streams still notice cancellation promptly.
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(next - now,
+                                                                                      std::chrono::milliseconds(50)));
+            now = std::chrono::steady_clock::now();
+        }
+        if (now - next > period) {
+            // Fell behind (slow client or writer): skip the missed samples, seq shows the gap.
+            seq += (now - next) / period;
+            next = now;
+        }
+        next += period;
+
+        update.set_seq(seq);
+        update.set_timestamp_us(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+        if (request->packed()) {
+            FillRobotState(&full);
+            ToPackedState(full, &packed);
+            PackState(packed, update.mutable_packed_state());
+        } else if (fields.empty()) {
+            FillRobotState(update.mutable_robot_state());
+        } else {
+            FillRobotState(&full);
+            update.mutable_robot_state()->Clear();
+            full.GetReflection()->SwapFields(&full, update.mutable_robot_state(), fields);
+        }
+        if (!writer->Write(update))
+            break; // client went away
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status MockRobotService::ControlSession(
+    grpc::ServerContext* context, grpc::ServerReaderWriter<grpc_comm::ControlEvent, grpc_comm::ControlCommand>* stream)
+{
+    using Clock = std::chrono::steady_clock;
+    using grpc_comm::ControlCommand;
+    using grpc_comm::ControlEvent;
+    calls_++;
+    uint64_t generation = ++generation_;
+
+    // Commands are read on a second thread so the session can wake up for them
+    // immediately while it also runs the motion clock.
+    std::mutex inbox_mutex;
+    std::condition_variable inbox_cv;
+    std::deque<ControlCommand> inbox;
+    bool client_closed = false;
+    std::thread reader([&] {
+        ControlCommand command;
+        while (stream->Read(&command)) {
+            std::lock_guard<std::mutex> lock(inbox_mutex);
+            inbox.push_back(command);
+            inbox_cv.notify_one();
+        }
+        std::lock_guard<std::mutex> lock(inbox_mutex);
+        client_closed = true;
+        inbox_cv.notify_one();
+    });
+
+    struct Queued
+    {
+        grpc_comm::Motion motion;
+        uint64_t command_id;
+        double duration_s; // < 0: open-ended gait, runs until something else is queued
+    };
+    struct Active
+    {
+        Queued entry;
+        uint32_t index;
+        Clock::time_point start;
+        uint32_t beats_total;
+        uint32_t beats_sent;
+    };
+    std::deque<Queued> queue;
+    std::unique_ptr<Active> current;
+    uint32_t next_index = 0;
+    bool idle_reported = true;
+    double bpm = kDefaultBpm;
+    Clock::time_point velocity_deadline = Clock::time_point::max();
+    bool writer_ok = true;
+
+    auto emit = [&](ControlEvent::Type type, uint64_t command_id, const std::string& message) {
+        ControlEvent event;
+        event.set_type(type);
+        event.set_command_id(command_id);
+        if (current) {
+            event.set_motion_id(current->entry.motion.motion_id());
+            event.set_motion_index(current->index);
+            event.set_beat(current->beats_sent);
+            if (current->entry.duration_s > 0.0) {
+                double elapsed = std::chrono::duration<double>(Clock::now() - current->start).count() / time_scale_;
+                event.set_progress(static_cast<float>(std::min(1.0, elapsed / current->entry.duration_s)));
+            }
+        }
+        event.set_timestamp_us(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count());
+        event.set_message(message);
+        writer_ok = writer_ok && stream->Write(event);
+    };
+    auto finish_current = [&](const std::string& message) {
+        if (!current)
+            return;
+        emit(ControlEvent::MOTION_FINISHED, current->entry.command_id, message);
+        current.reset();
+        velocity_deadline = Clock::time_point::max();
+    };
+    // Validates a motion for the queue; returns false with `error` set if invalid.
+    auto make_entry = [&](const grpc_comm::Motion& motion, uint64_t command_id, Queued* entry, std::string* error) {
+        entry->motion = motion;
+        entry->command_id = command_id;
+        const grpc_comm::Parameter* velocity = FindParam(motion, "velocity_sequence");
+        if (IsGait(motion.motion_id()) && IsEmptyVelocitySequence(velocity)) {
+            entry->duration_s = -1.0;
+            return true;
+        }
+        entry->duration_s = MotionDuration(motion, bpm, error);
+        return entry->duration_s >= 0.0;
+    };
+
+    grpc::Status result = grpc::Status::OK;
+    const auto tick = std::chrono::milliseconds(10);
+    auto next_tick = Clock::now();
+    while (writer_ok) {
+        std::deque<ControlCommand> commands;
+        bool closed;
+        {
+            std::unique_lock<std::mutex> lock(inbox_mutex);
+            inbox_cv.wait_until(lock, next_tick, [&] { return !inbox.empty() || client_closed; });
+            commands.swap(inbox);
+            closed = client_closed;
+        }
+        if (Clock::now() >= next_tick)
+            next_tick = Clock::now() + tick;
+        if (context->IsCancelled()) {
+            result = grpc::Status(grpc::StatusCode::CANCELLED, "Session cancelled");
+            break;
+        }
+        if (generation_.load() != generation) {
+            result = grpc::Status(grpc::StatusCode::ABORTED, "Preempted by a newer sequence");
+            break;
+        }
+
+        for (const auto& command : commands) {
+            uint64_t id = command.command_id();
+            std::string error;
+            switch (command.command_case()) {
+                case ControlCommand::kStart: {
+                    const auto& sequence = command.start();
+                    double previous_bpm = bpm;
+                    if (sequence.bpm() > 0.0f)
+                        bpm = sequence.bpm();
+                    std::deque<Queued> entries;
+                    for (const auto& motion : sequence.motions()) {
+                        Queued entry;
+                        if (!make_entry(motion, id, &entry, &error))
+                            break;
+                        entries.push_back(entry);
+                    }
+                    if (!error.empty()) {
+                        bpm = previous_bpm;
+                        emit(ControlEvent::REJECTED, id, error);
+                        break;
+                    }
+                    finish_current("Replaced by a new sequence");
+                    queue.swap(entries);
+                    emit(ControlEvent::ACCEPTED, id, "");
+                    break;
+                }
+                case ControlCommand::kAppend: {
+                    Queued entry;
+                    if (!make_entry(command.append(), id, &entry, &error)) {
+                        emit(ControlEvent::REJECTED, id, error);
+                        break;
+                    }
+                    queue.push_back(entry);
+                    emit(ControlEvent::ACCEPTED, id, "");
+                    break;
+                }
+                case ControlCommand::kVelocity: {
+                    if (!current || !IsGait(current->entry.motion.motion_id())) {
+                        emit(ControlEvent::REJECTED, id, "No gait is running");
+                        break;
+                    }
+                    const auto& setpoint = command.velocity();
+                    // A real-time watchdog on the client's loop, so not scaled by time_scale.
+                    velocity_deadline = setpoint.timeout_s() > 0.0f
+                                            ? Clock::now()
+                                                  + std::chrono::duration_cast<Clock::duration>(
+                                                      std::chrono::duration<double>(setpoint.timeout_s()))
+                                            : Clock::time_point::max();
+                    emit(ControlEvent::ACCEPTED, id, "");
+                    break;
+                }
+                case ControlCommand::kStop:
+                    queue.clear();
+                    finish_current("Stopped");
+                    emit(ControlEvent::ACCEPTED, id, "");
+                    break;
+                default:
+                    emit(ControlEvent::REJECTED, id, "Empty command");
+                    break;
+            }
+        }
+
+        auto now = Clock::now();
+        if (current) {
+            double elapsed = std::chrono::duration<double>(now - current->start).count() / time_scale_;
+            uint32_t beats_now = static_cast<uint32_t>(elapsed * bpm / 60.0);
+            while (current->beats_sent < std::min(beats_now, current->beats_total)) {
+                current->beats_sent++;
+                emit(ControlEvent::BEAT, 0, "");
+            }
+            if (now >= velocity_deadline) {
+                velocity_deadline = Clock::time_point::max();
+                emit(ControlEvent::VELOCITY_TIMEOUT, 0, "No setpoint within timeout_s, velocity zeroed");
+            }
+            bool open = current->entry.duration_s < 0.0;
+            if (!open && elapsed >= current->entry.duration_s)
+                finish_current("");
+            else if (open && (!queue.empty() || closed))
+                finish_current(queue.empty() ? "Session closed" : "Next motion queued");
+        }
+        if (!current && !queue.empty()) {
+            current.reset(new Active {queue.front(), next_index++, now, 0, 0});
+            queue.pop_front();
+            const grpc_comm::Parameter* beats = FindParam(current->entry.motion, "beats");
+            auto info = catalogue_.find(current->entry.motion.motion_id());
+            if (!beats && info != catalogue_.end())
+                beats = FindParam(info->second.defaults, "beats");
+            current->beats_total = beats ? static_cast<uint32_t>(std::ceil(beats->float_value())) : 0;
+            idle_reported = false;
+            emit(ControlEvent::MOTION_STARTED, current->entry.command_id, "");
+        }
+        if (!current && queue.empty()) {
+            if (!idle_reported) {
+                idle_reported = true;
+                emit(ControlEvent::QUEUE_EMPTY, 0, "");
+            }
+            if (closed)
+                break;
+        }
+    }
+
+    {
+        // Unblock the reader if the client has not closed its side yet.
+        std::lock_guard<std::mutex> lock(inbox_mutex);
+        if (!client_closed)
+            context->TryCancel();
+    }
+    reader.join();
+    return result;
+}
+
+void MockRobotService::FillRobotState(grpc_comm::RobotState* state) const
+{
+    state->Clear();
+    double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    for (int i = 0; i < 12; ++i) {
+        double phase = 2 * kPi * 0.5 * t + i;
+        float q = kStandPose[i] + 0.05f * static_cast<float>(std::sin(phase));
+        float dq = 0.05f * static_cast<float>(2 * kPi * 0.5 * std::cos(phase));
+        float tau = (i % 3 == 2 ? -8.0f : 5.0f) + 0.5f * static_cast<float>(std::sin(phase));
+        state->add_jpos_leg(q);
+        state->add_jpos_leg_des(kStandPose[i]);
+        state->add_jvel_leg(dq);
+        state->add_jvel_leg_des(0.0f);
+        state->add_jtau_leg(tau);
+        state->add_jtau_leg_des(tau);
+    }
+    for (int i = 0; i < 3; ++i) {
+        state->add_pos_body(i == 2 ? 0.32f : 0.0f);
+        state->add_vel_body(0.0f);
+        state->add_acc_body(i == 2 ? 9.81f : 0.0f);
+        state->add_omega_body(0.01f * static_cast<float>(std::sin(t + i)));
+        state->add_ori_body(0.02f * static_cast<float>(std::sin(0.5 * t + i)));
+    }
+    for (int foot = 0; foot < 2; ++foot) {
+        for (int k = 0; k < 3; ++k) {
+            state->add_grf_left(k == 2 ? 45.0f : 0.0f);
+            state->add_grf_right(k == 2 ? 45.0f : 0.0f);
+        }
+    }
+    state->add_grf_vertical_filtered(90.0f);
+    state->add_grf_vertical_filtered(90.0f);
+
+    float temp[10] = {90.0f, 90.0f, 180.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 25.2f, 25.18f};
+    for (float v : temp)
+        state->add_temp(v);
+}
+
+MockRobotServer::MockRobotServer(double time_scale)
+    : service_(time_scale)
+{
+}
+
+MockRobotServer::~MockRobotServer()
+{
+    Shutdown();
+}
+
+bool MockRobotServer::Start(const std::string& address)
+{
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(address, grpc::InsecureServerCredentials(), &port);
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    if (!server_ || port == 0) {
+        std::cerr << "Failed to start mock robot on " << address << std::endl;
+        server_.reset();
+        return false;
+    }
+    address_ = address.substr(0, address.rfind(':') + 1) + std::to_string(port);
+    return true;
+}
+
+void MockRobotServer::Shutdown()
+{
+    if (server_) {
+        // Deadline so running ExecuteSequence calls are cancelled instead of awaited.
+        server_->Shutdown(std::chrono::system_clock::now() + std::chrono::milliseconds(100));
+        server_.reset();
+    }
+}
+
+} // namespace quad_sdk
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+
+namespace quad_sdk {
+
+// Stand-in for the robot's gRPCService, for running the high-level clients and load
+// tests without hardware.
+//
+//   GetAvailableMotions  the motion catalogue the examples use, with default
+//                        parameters and descriptions; fsm_state filters it. The
+//                        catalogue_version is a hash of the catalogue, and a matching
+//                        if_none_match gets an empty not_modified answer.
+//   ExecuteSequence      validates every motion and blocks for the simulated duration:
+//                        beats * 60 / bpm for beat-based motions, the sum of segment
+//                        durations for velocity sequences (text or velocity_segments),
+//                        and a fixed time for state switches. Cancellation returns
+//                        CANCELLED; a new sequence preempts the running one, as on the
+//                        robot. start_time_us delays the start to that wall-clock time.
+//   GetRobotState        synthetic, time-varying state with the field sizes the
+//                        robot reports (temp[8]/temp[9] are battery voltages).
+//   StreamRobotState     the same state at the requested rate (default 50 Hz, at most
+//                        500 Hz), restricted to the requested fields.
+// Both state RPCs answer with PackedRobotState when the request asks for packed.
+//   ControlSession       a motion queue driven by the client's commands on a 10 ms
+//                        clock: gaits without a velocity_sequence run until the next
+//                        motion is queued and accept velocity setpoints; beat-based
+//                        motions report every beat. Commands are handled on arrival.
+//
+// time_scale shrinks every simulated duration (0.01 runs a 10 s sequence in 100 ms).
+class MockRobotService final : public grpc_comm::gRPCService::Service
+{
+public:
+    explicit MockRobotService(double time_scale = 1.0);
+
+    grpc::Status GetAvailableMotions(grpc::ServerContext* context,
+                                     const grpc_comm::GetMotionsRequest* request,
+                                     grpc_comm::GetMotionsResponse* response) override;
+    grpc::Status ExecuteSequence(grpc::ServerContext* context,
+                                 const grpc_comm::ExecuteSequenceRequest* request,
+                                 grpc_comm::ExecuteSequenceResponse* response) override;
+    grpc::Status GetRobotState(grpc::ServerContext* context,
+                               const grpc_comm::GetRobotStateRequest* request,
+                               grpc_comm::GetRobotStateResponse* response) override;
+    grpc::Status StreamRobotState(grpc::ServerContext* context,
+                                  const grpc_comm::StreamRobotStateRequest* request,
+                                  grpc::ServerWriter<grpc_comm::RobotStateUpdate>* writer) override;
+    grpc::Status ControlSession(
+        grpc::ServerContext* context,
+        grpc::ServerReaderWriter<grpc_comm::ControlEvent, grpc_comm::ControlCommand>* stream) override;
+
+    // Simulated duration of a sequence or motion in seconds (before time_scale), or a
+    // negative value with `error` set when it is invalid.
+    double SequenceDuration(const grpc_comm::MotionSequence& sequence, std::string* error) const;
+    double MotionDuration(const grpc_comm::Motion& motion, double bpm, std::string* error) const;
+    // Gait motions (walk, flying_trot, rl) take velocity setpoints.
+    bool IsGait(const std::string& motion_id) const;
+
+    uint64_t CallCount() const { return calls_.load(); }
+
+private:
+    struct MotionInfo
+    {
+        grpc_comm::Motion defaults;
+        std::string description;
+        std::string fsm_state; // state the motion runs in; empty = any
+        double fixed_duration_s;
+    };
+
+    void AddMotion(const std::string& id, const std::string& fsm_state, const std::string& description,
+                   double fixed_duration_s);
+    void AddFloatParam(const std::string& id, const std::string& key, float value);
+    void AddStringParam(const std::string& id, const std::string& key, const std::string& value);
+    void FillRobotState(grpc_comm::RobotState* state) const;
+    std::string CatalogueVersion() const;
+
+    double time_scale_;
+    std::map<std::string, MotionInfo> catalogue_;
+    std::string catalogue_version_;
+    std::chrono::steady_clock::time_point start_;
+    std::atomic<uint64_t> calls_;
+    std::atomic<uint64_t> executions_;
+    std::atomic<uint64_t> generation_; // bumped by every accepted sequence
+};
+
+// Owns a grpc::Server running a MockRobotService. Start("127.0.0.1:0") picks a free
+// port, so several mock robots can run side by side in one process.
+class MockRobotServer
+{
+public:
+    explicit MockRobotServer(double time_scale = 1.0);
+    ~MockRobotServer();
+
+    // Returns false if the address could not be bound.
+    bool Start(const std::string& address);
+    void Shutdown();
+
+    // host:port actually bound (with the chosen port when ":0" was requested).
+    const std::string& Address() const { return address_; }
+    MockRobotService& Service() { return service_; }
+
+private:
+    MockRobotService service_;
+    std::unique_ptr<grpc::Server> server_;
+    std::string address_;
+};
+
+} // namespace quad_sdk
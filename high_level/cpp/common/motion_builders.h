@@ -0,0 +1,422 @@
+// Generated by motion_codegen from mock_robot_server.cache, motion catalogue version 0d165fa27473acfe.
+// Do not edit; regenerate against the robot when its motion library changes.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "proto/grpc_service.pb.h"
+
+namespace quad_sdk {
+namespace motions {
+
+// Compare with MotionCatalogueSnapshot::Version() to detect a robot whose catalogue
+// differs from the one these builders were generated from.
+constexpr const char kCatalogueVersion[] = "0d165fa27473acfe";
+
+// Trigger FSM to BACK_FLIP once
+struct Backflip
+{
+    static constexpr const char* MotionId() { return "backflip"; }
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        motion->clear_parameters();
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Control robot body height in balance stand with sinusoidal motion
+struct BalanceHeight
+{
+    static constexpr const char* MotionId() { return "balance_height"; }
+
+    float beats = 1.0f;
+    float amplitude = 1.0f;
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        auto* parameters = motion->mutable_parameters();
+        parameters->Clear();
+        {
+            auto* param = parameters->Add();
+            param->set_key("beats");
+            param->set_float_value(beats);
+        }
+        {
+            auto* param = parameters->Add();
+            param->set_key("amplitude");
+            param->set_float_value(amplitude);
+        }
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Return to neutral posture in balance stand
+struct BalanceNeutral
+{
+    static constexpr const char* MotionId() { return "balance_neutral"; }
+
+    float beats = 1.0f;
+    float amplitude = 1.0f;
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        auto* parameters = motion->mutable_parameters();
+        parameters->Clear();
+        {
+            auto* param = parameters->Add();
+            param->set_key("beats");
+            param->set_float_value(beats);
+        }
+        {
+            auto* param = parameters->Add();
+            param->set_key("amplitude");
+            param->set_float_value(amplitude);
+        }
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Control robot pitch angle in balance stand with sinusoidal motion
+struct BalancePitch
+{
+    static constexpr const char* MotionId() { return "balance_pitch"; }
+
+    float beats = 1.0f;
+    float amplitude = 1.0f;
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        auto* parameters = motion->mutable_parameters();
+        parameters->Clear();
+        {
+            auto* param = parameters->Add();
+            param->set_key("beats");
+            param->set_float_value(beats);
+        }
+        {
+            auto* param = parameters->Add();
+            param->set_key("amplitude");
+            param->set_float_value(amplitude);
+        }
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Control robot roll angle in balance stand with sinusoidal motion
+struct BalanceRoll
+{
+    static constexpr const char* MotionId() { return "balance_roll"; }
+
+    float beats = 1.0f;
+    float amplitude = 1.0f;
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        auto* parameters = motion->mutable_parameters();
+        parameters->Clear();
+        {
+            auto* param = parameters->Add();
+            param->set_key("beats");
+            param->set_float_value(beats);
+        }
+        {
+            auto* param = parameters->Add();
+            param->set_key("amplitude");
+            param->set_float_value(amplitude);
+        }
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to BALANCE_STAND once
+struct BalanceStand
+{
+    static constexpr const char* MotionId() { return "balance_stand"; }
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        motion->clear_parameters();
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Control robot yaw angle in balance stand with sinusoidal motion
+struct BalanceYaw
+{
+    static constexpr const char* MotionId() { return "balance_yaw"; }
+
+    float beats = 1.0f;
+    float amplitude = 1.0f;
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        auto* parameters = motion->mutable_parameters();
+        parameters->Clear();
+        {
+            auto* param = parameters->Add();
+            param->set_key("beats");
+            param->set_float_value(beats);
+        }
+        {
+            auto* param = parameters->Add();
+            param->set_key("amplitude");
+            param->set_float_value(amplitude);
+        }
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to DANCE0 once
+struct Dance0
+{
+    static constexpr const char* MotionId() { return "dance0"; }
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        motion->clear_parameters();
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to FLYING_TROT with velocity sequence support
+struct FlyingTrot
+{
+    static constexpr const char* MotionId() { return "flying_trot"; }
+
+    std::string velocity_sequence = "";
+    // Sent as velocity_segments instead of velocity_sequence when non-empty; robot
+    // firmware must support that field.
+    grpc_comm::VelocitySegments velocity_sequence_segments;
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        auto* parameters = motion->mutable_parameters();
+        parameters->Clear();
+        {
+            auto* param = parameters->Add();
+            param->set_key("velocity_sequence");
+            if (velocity_sequence_segments.segments_size() > 0)
+                *param->mutable_velocity_segments() = velocity_sequence_segments;
+            else
+                param->set_string_value(velocity_sequence);
+        }
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to JUMP once
+struct Jump
+{
+    static constexpr const char* MotionId() { return "jump"; }
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        motion->clear_parameters();
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Stop all motion and switch to PASSIVE
+struct KillRobot
+{
+    static constexpr const char* MotionId() { return "kill_robot"; }
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        motion->clear_parameters();
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to PASSIVE once
+struct Passive
+{
+    static constexpr const char* MotionId() { return "passive"; }
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        motion->clear_parameters();
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Find and execute the FSM transition path to target_state
+struct PathToState
+{
+    static constexpr const char* MotionId() { return "path_to_state"; }
+
+    std::string target_state = "BALANCE_STAND";
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        auto* parameters = motion->mutable_parameters();
+        parameters->Clear();
+        {
+            auto* param = parameters->Add();
+            param->set_key("target_state");
+            param->set_string_value(target_state);
+        }
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to RL with velocity sequence support
+struct Rl
+{
+    static constexpr const char* MotionId() { return "rl"; }
+
+    std::string velocity_sequence = "";
+    // Sent as velocity_segments instead of velocity_sequence when non-empty; robot
+    // firmware must support that field.
+    grpc_comm::VelocitySegments velocity_sequence_segments;
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        auto* parameters = motion->mutable_parameters();
+        parameters->Clear();
+        {
+            auto* param = parameters->Add();
+            param->set_key("velocity_sequence");
+            if (velocity_sequence_segments.segments_size() > 0)
+                *param->mutable_velocity_segments() = velocity_sequence_segments;
+            else
+                param->set_string_value(velocity_sequence);
+        }
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to STAND_DOWN once
+struct StandDown
+{
+    static constexpr const char* MotionId() { return "stand_down"; }
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        motion->clear_parameters();
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to STAND_UP once
+struct StandUp
+{
+    static constexpr const char* MotionId() { return "stand_up"; }
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        motion->clear_parameters();
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to WALK with velocity sequence support
+struct Walk
+{
+    static constexpr const char* MotionId() { return "walk"; }
+
+    std::string velocity_sequence = "";
+    // Sent as velocity_segments instead of velocity_sequence when non-empty; robot
+    // firmware must support that field.
+    grpc_comm::VelocitySegments velocity_sequence_segments;
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        auto* parameters = motion->mutable_parameters();
+        parameters->Clear();
+        {
+            auto* param = parameters->Add();
+            param->set_key("velocity_sequence");
+            if (velocity_sequence_segments.segments_size() > 0)
+                *param->mutable_velocity_segments() = velocity_sequence_segments;
+            else
+                param->set_string_value(velocity_sequence);
+        }
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to WAVE once
+struct Wave
+{
+    static constexpr const char* MotionId() { return "wave"; }
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        motion->clear_parameters();
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+// Trigger FSM to X_LEGS once
+struct XLegs
+{
+    static constexpr const char* MotionId() { return "x_legs"; }
+
+    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.
+    void WriteTo(grpc_comm::Motion* motion) const
+    {
+        motion->set_motion_id(MotionId());
+        motion->clear_parameters();
+    }
+
+    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }
+};
+
+} // namespace motions
+} // namespace quad_sdk
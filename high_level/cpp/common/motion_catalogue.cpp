@@ -0,0 +1,156 @@
+#include "common/motion_catalogue.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <google/protobuf/util/message_differencer.h>
+
+namespace quad_sdk {
+
+namespace {
+
+// Robots that predate catalogue_version always answer with the full catalogue; then the
+// content decides whether it changed.
+bool SameCatalogue(const grpc_comm::GetMotionsResponse& a, const grpc_comm::GetMotionsResponse& b)
+{
+    if (!a.catalogue_version().empty() || !b.catalogue_version().empty())
+        return a.catalogue_version() == b.catalogue_version();
+    return google::protobuf::util::MessageDifferencer::Equals(a, b);
+}
+
+} // namespace
+
+MotionCatalogueSnapshot::MotionCatalogueSnapshot(grpc_comm::GetMotionsResponse response)
+    : response_(std::move(response))
+{
+    index_.reserve(response_.motions_size());
+    for (const auto& motion : response_.motions()) {
+        Entry& entry = index_[motion.motion_id()];
+        entry.motion = &motion;
+        auto desc_it = response_.descriptions().find(motion.motion_id());
+        entry.description = desc_it != response_.descriptions().end() ? &desc_it->second : nullptr;
+        entry.params.reserve(motion.parameters_size());
+        for (const auto& param : motion.parameters())
+            entry.params.emplace(param.key(), &param);
+    }
+}
+
+const grpc_comm::Motion* MotionCatalogueSnapshot::Find(const std::string& motion_id) const
+{
+    auto it = index_.find(motion_id);
+    return it != index_.end() ? it->second.motion : nullptr;
+}
+
+const grpc_comm::Parameter* MotionCatalogueSnapshot::FindParam(const std::string& motion_id,
+                                                               const std::string& key) const
+{
+    auto it = index_.find(motion_id);
+    if (it == index_.end())
+        return nullptr;
+    auto param_it = it->second.params.find(key);
+    return param_it != it->second.params.end() ? param_it->second : nullptr;
+}
+
+const std::string& MotionCatalogueSnapshot::Description(const std::string& motion_id) const
+{
+    static const std::string kEmpty;
+    auto it = index_.find(motion_id);
+    return it != index_.end() && it->second.description ? *it->second.description : kEmpty;
+}
+
+void MotionCatalogue::OnChange(ChangeCallback callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    on_change_ = std::move(callback);
+}
+
+std::shared_ptr<const MotionCatalogueSnapshot> MotionCatalogue::Current() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_;
+}
+
+grpc::Status MotionCatalogue::Refresh(RobotClient& client, bool* changed)
+{
+    if (changed)
+        *changed = false;
+    auto current = Current();
+    grpc_comm::GetMotionsRequest request;
+    request.set_if_none_match(current->Version());
+    auto call = client.GetAvailableMotions(request);
+    call->Wait();
+    if (!call->status().ok())
+        return call->status();
+    const grpc_comm::GetMotionsResponse& response = call->response();
+    if (!response.success())
+        return grpc::Status(grpc::StatusCode::UNKNOWN, "Failed to retrieve motions: " + response.message());
+    if (response.not_modified() || SameCatalogue(current->Response(), response))
+        return grpc::Status::OK;
+
+    Install(std::make_shared<MotionCatalogueSnapshot>(response));
+    if (changed)
+        *changed = true;
+    return grpc::Status::OK;
+}
+
+bool MotionCatalogue::Save(const std::string& path, std::string* error) const
+{
+    auto current = Current();
+    std::string bytes;
+    if (current->Size() == 0 || !current->Response().SerializeToString(&bytes)) {
+        if (error)
+            *error = "Nothing to save: the catalogue is empty";
+        return false;
+    }
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), bytes.size());
+        if (!out.flush()) {
+            if (error)
+                *error = "Cannot write " + tmp;
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        if (error)
+            *error = "Cannot replace " + path;
+        return false;
+    }
+    return true;
+}
+
+bool MotionCatalogue::Load(const std::string& path, std::string* error)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        if (error)
+            *error = "Cannot open " + path;
+        return false;
+    }
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    grpc_comm::GetMotionsResponse response;
+    if (!response.ParseFromString(bytes) || response.motions_size() == 0) {
+        if (error)
+            *error = "Not a motion catalogue: " + path;
+        return false;
+    }
+    if (!SameCatalogue(Current()->Response(), response))
+        Install(std::make_shared<MotionCatalogueSnapshot>(std::move(response)));
+    return true;
+}
+
+void MotionCatalogue::Install(std::shared_ptr<const MotionCatalogueSnapshot> snapshot)
+{
+    ChangeCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_ = snapshot;
+        callback = on_change_;
+    }
+    if (callback)
+        callback(snapshot);
+}
+
+} // namespace quad_sdk
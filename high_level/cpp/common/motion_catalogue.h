@@ -0,0 +1,90 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+#include "common/robot_client.h"
+
+namespace quad_sdk {
+
+// Immutable, indexed copy of one catalogue version. Lookups are hash-map hits and the
+// returned pointers stay valid for as long as the snapshot is held.
+class MotionCatalogueSnapshot
+{
+public:
+    explicit MotionCatalogueSnapshot(grpc_comm::GetMotionsResponse response);
+
+    MotionCatalogueSnapshot(const MotionCatalogueSnapshot&) = delete;
+    MotionCatalogueSnapshot& operator=(const MotionCatalogueSnapshot&) = delete;
+
+    // Motion with its default parameters, or nullptr if the robot has no such motion.
+    const grpc_comm::Motion* Find(const std::string& motion_id) const;
+    // Default value of one parameter, or nullptr.
+    const grpc_comm::Parameter* FindParam(const std::string& motion_id, const std::string& key) const;
+    // Empty if the motion is unknown or has no description.
+    const std::string& Description(const std::string& motion_id) const;
+
+    const std::string& Version() const { return response_.catalogue_version(); }
+    size_t Size() const { return static_cast<size_t>(response_.motions_size()); }
+    // The full GetAvailableMotions answer, motions in the robot's order.
+    const grpc_comm::GetMotionsResponse& Response() const { return response_; }
+
+private:
+    struct Entry
+    {
+        const grpc_comm::Motion* motion;
+        const std::string* description;
+        std::unordered_map<std::string, const grpc_comm::Parameter*> params;
+    };
+
+    grpc_comm::GetMotionsResponse response_;
+    std::unordered_map<std::string, Entry> index_;
+};
+
+// Client-side cache of the robot's motion catalogue, for code that looks up motion
+// defaults constantly (planners, UIs) and should not fetch the whole catalogue each time.
+//
+//   quad_sdk::MotionCatalogue catalogue;
+//   catalogue.Load("motions.cache");        // cold start without the robot, optional
+//   catalogue.Refresh(client);              // conditional: cheap when nothing changed
+//   auto motions = catalogue.Current();
+//   if (const auto* beats = motions->FindParam("balance_pitch", "beats")) ...
+//   catalogue.Save("motions.cache");
+//
+// Refresh() sends the cached catalogue_version as if_none_match, so an unchanged
+// catalogue costs one small round trip. A new version replaces the snapshot and runs the
+// change callback. Current() may be called from any thread while another refreshes.
+class MotionCatalogue
+{
+public:
+    using ChangeCallback = std::function<void(const std::shared_ptr<const MotionCatalogueSnapshot>&)>;
+
+    // Called with the new snapshot whenever Refresh() or Load() installs a new version.
+    void OnChange(ChangeCallback callback);
+
+    // Fetches the catalogue unless the robot reports it unchanged. `changed` (optional)
+    // tells whether a new version was installed. On failure the cache is left as it was.
+    grpc::Status Refresh(RobotClient& client, bool* changed = nullptr);
+
+    // Latest snapshot; empty (Size() == 0, Version() == "") before the first Refresh/Load.
+    std::shared_ptr<const MotionCatalogueSnapshot> Current() const;
+
+    // Persist the current snapshot / restore one saved earlier. Save writes a temporary
+    // file and renames it, so a crash never leaves a truncated cache behind.
+    bool Save(const std::string& path, std::string* error = nullptr) const;
+    bool Load(const std::string& path, std::string* error = nullptr);
+
+private:
+    void Install(std::shared_ptr<const MotionCatalogueSnapshot> snapshot);
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<const MotionCatalogueSnapshot> current_ =
+        std::make_shared<MotionCatalogueSnapshot>(grpc_comm::GetMotionsResponse());
+    ChangeCallback on_change_;
+};
+
+} // namespace quad_sdk
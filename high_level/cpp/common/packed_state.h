@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "proto/grpc_service.pb.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "PackedRobotState is little-endian; decoding by memcpy needs a little-endian host"
+#endif
+
+namespace quad_sdk {
+
+// In-memory image of PackedRobotState.data, schema_version 1 (see grpc_service.proto).
+// Decoding is one memcpy; the named fields replace RobotState's temp[] indices.
+struct PackedStateV1
+{
+    static const uint32_t kVersion = 1;
+
+    float jpos_leg[12];
+    float jpos_leg_des[12];
+    float jvel_leg[12];
+    float jtau_leg[12];
+    float jvel_leg_des[12];
+    float jtau_leg_des[12];
+
+    float pos_body[3];
+    float vel_body[3];
+    float acc_body[3];
+    float omega_body[3];
+    float ori_body[3];
+
+    float grf_left[6];
+    float grf_right[6];
+    float grf_vertical_filtered[2];
+
+    float contact_force_left;
+    float contact_force_right;
+    float contact_force_total;
+    float grf_total_x;
+    float reserved[4];
+    float battery_voltage_1;
+    float battery_voltage_2;
+};
+
+static_assert(std::is_trivially_copyable<PackedStateV1>::value, "PackedStateV1 must be a POD");
+static_assert(sizeof(PackedStateV1) == 444, "PackedStateV1 layout mismatch");
+static_assert(offsetof(PackedStateV1, pos_body) == 288, "PackedStateV1 layout mismatch");
+static_assert(offsetof(PackedStateV1, grf_left) == 348, "PackedStateV1 layout mismatch");
+static_assert(offsetof(PackedStateV1, contact_force_left) == 404, "PackedStateV1 layout mismatch");
+static_assert(offsetof(PackedStateV1, battery_voltage_1) == 436, "PackedStateV1 layout mismatch");
+
+// Named offsets of schema version 1, for generic consumers (loggers, plotting,
+// bindings in other languages) that address fields by name.
+struct PackedStateField
+{
+    const char* name;
+    size_t offset; // bytes
+    int count;     // float32 values
+};
+
+#define QUAD_SDK_PACKED_FIELD(f) \
+    {#f, offsetof(PackedStateV1, f), static_cast<int>(sizeof(PackedStateV1::f) / sizeof(float))}
+const PackedStateField kPackedStateV1Fields[] = {
+    QUAD_SDK_PACKED_FIELD(jpos_leg),
+    QUAD_SDK_PACKED_FIELD(jpos_leg_des),
+    QUAD_SDK_PACKED_FIELD(jvel_leg),
+    QUAD_SDK_PACKED_FIELD(jtau_leg),
+    QUAD_SDK_PACKED_FIELD(jvel_leg_des),
+    QUAD_SDK_PACKED_FIELD(jtau_leg_des),
+    QUAD_SDK_PACKED_FIELD(pos_body),
+    QUAD_SDK_PACKED_FIELD(vel_body),
+    QUAD_SDK_PACKED_FIELD(acc_body),
+    QUAD_SDK_PACKED_FIELD(omega_body),
+    QUAD_SDK_PACKED_FIELD(ori_body),
+    QUAD_SDK_PACKED_FIELD(grf_left),
+    QUAD_SDK_PACKED_FIELD(grf_right),
+    QUAD_SDK_PACKED_FIELD(grf_vertical_filtered),
+    QUAD_SDK_PACKED_FIELD(contact_force_left),
+    QUAD_SDK_PACKED_FIELD(contact_force_right),
+    QUAD_SDK_PACKED_FIELD(contact_force_total),
+    QUAD_SDK_PACKED_FIELD(grf_total_x),
+    QUAD_SDK_PACKED_FIELD(reserved),
+    QUAD_SDK_PACKED_FIELD(battery_voltage_1),
+    QUAD_SDK_PACKED_FIELD(battery_voltage_2),
+};
+#undef QUAD_SDK_PACKED_FIELD
+
+inline void PackState(const PackedStateV1& state, grpc_comm::PackedRobotState* msg)
+{
+    msg->set_schema_version(PackedStateV1::kVersion);
+    msg->set_data(&state, sizeof(state));
+}
+
+// Returns false for an unknown schema version or a truncated block.
+inline bool UnpackState(const grpc_comm::PackedRobotState& msg, PackedStateV1* state)
+{
+    if (msg.schema_version() != PackedStateV1::kVersion || msg.data().size() != sizeof(PackedStateV1))
+        return false;
+    std::memcpy(state, msg.data().data(), sizeof(PackedStateV1));
+    return true;
+}
+
+// Converts a RobotState into the packed layout; missing values read as zero.
+inline void ToPackedState(const grpc_comm::RobotState& src, PackedStateV1* dst)
+{
+    std::memset(dst, 0, sizeof(*dst));
+    auto copy = [](const google::protobuf::RepeatedField<float>& from, float* to, int n) {
+        if (!from.empty())
+            std::memcpy(to, from.data(), sizeof(float) * std::min(n, from.size()));
+    };
+    copy(src.jpos_leg(), dst->jpos_leg, 12);
+    copy(src.jpos_leg_des(), dst->jpos_leg_des, 12);
+    copy(src.jvel_leg(), dst->jvel_leg, 12);
+    copy(src.jtau_leg(), dst->jtau_leg, 12);
+    copy(src.jvel_leg_des(), dst->jvel_leg_des, 12);
+    copy(src.jtau_leg_des(), dst->jtau_leg_des, 12);
+    copy(src.pos_body(), dst->pos_body, 3);
+    copy(src.vel_body(), dst->vel_body, 3);
+    copy(src.acc_body(), dst->acc_body, 3);
+    copy(src.omega_body(), dst->omega_body, 3);
+    copy(src.ori_body(), dst->ori_body, 3);
+    copy(src.grf_left(), dst->grf_left, 6);
+    copy(src.grf_right(), dst->grf_right, 6);
+    copy(src.grf_vertical_filtered(), dst->grf_vertical_filtered, 2);
+    float temp[10] = {};
+    copy(src.temp(), temp, 10);
+    dst->contact_force_left = temp[0];
+    dst->contact_force_right = temp[1];
+    dst->contact_force_total = temp[2];
+    dst->grf_total_x = temp[3];
+    std::memcpy(dst->reserved, temp + 4, sizeof(dst->reserved));
+    dst->battery_voltage_1 = temp[8];
+    dst->battery_voltage_2 = temp[9];
+}
+
+} // namespace quad_sdk
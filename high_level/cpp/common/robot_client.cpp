@@ -0,0 +1,97 @@
+#include "common/robot_client.h"
+
+namespace quad_sdk {
+
+RobotClient::RobotClient(const std::string& server_address)
+    : RobotClient(grpc::CreateChannel(server_address, grpc::InsecureChannelCredentials()), server_address)
+{
+}
+
+RobotClient::RobotClient(std::shared_ptr<grpc::Channel> channel, const std::string& server_address)
+    : server_address_(server_address)
+    , channel_(std::move(channel))
+    , stub_(grpc_comm::gRPCService::NewStub(channel_))
+    , sequence_calls_(std::make_shared<CallPool<grpc_comm::ExecuteSequenceResponse>>())
+    , state_calls_(std::make_shared<CallPool<grpc_comm::GetRobotStateResponse>>())
+    , motions_calls_(std::make_shared<CallPool<grpc_comm::GetMotionsResponse>>())
+{
+    poller_ = std::thread(&RobotClient::PollLoop, this);
+}
+
+RobotClient::~RobotClient()
+{
+    CancelAll();
+    // Next() keeps returning the cancelled calls' tags until the queue is drained.
+    cq_.Shutdown();
+    poller_.join();
+}
+
+template <typename Response, typename Request, typename Prepare>
+std::shared_ptr<AsyncCall<Response>> RobotClient::Start(CallPool<Response>& pool, const Request& request,
+                                                        typename AsyncCall<Response>::Callback callback,
+                                                        Prepare prepare)
+{
+    std::shared_ptr<AsyncCall<Response>> call = pool.Acquire();
+    call->callback_ = std::move(callback);
+    call->self_ = call;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_.insert(call.get());
+    }
+    call->reader_ = (stub_.get()->*prepare)(call->context_.get(), request, &cq_);
+    call->reader_->StartCall();
+    call->reader_->Finish(call->response_.get(), &call->status_, static_cast<AsyncCallBase*>(call.get()));
+    return call;
+}
+
+std::shared_ptr<SequenceCall> RobotClient::ExecuteSequence(const grpc_comm::ExecuteSequenceRequest& request,
+                                                           SequenceCall::Callback callback)
+{
+    return Start<grpc_comm::ExecuteSequenceResponse>(*sequence_calls_, request, std::move(callback),
+                                                     &grpc_comm::gRPCService::Stub::PrepareAsyncExecuteSequence);
+}
+
+std::shared_ptr<StateCall> RobotClient::GetRobotState(const grpc_comm::GetRobotStateRequest& request,
+                                                      StateCall::Callback callback)
+{
+    return Start<grpc_comm::GetRobotStateResponse>(*state_calls_, request, std::move(callback),
+                                                   &grpc_comm::gRPCService::Stub::PrepareAsyncGetRobotState);
+}
+
+std::shared_ptr<MotionsCall> RobotClient::GetAvailableMotions(const grpc_comm::GetMotionsRequest& request,
+                                                              MotionsCall::Callback callback)
+{
+    return Start<grpc_comm::GetMotionsResponse>(*motions_calls_, request, std::move(callback),
+                                                &grpc_comm::gRPCService::Stub::PrepareAsyncGetAvailableMotions);
+}
+
+void RobotClient::CancelAll()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto* call : in_flight_)
+        call->Cancel();
+}
+
+size_t RobotClient::InFlight() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_.size();
+}
+
+void RobotClient::PollLoop()
+{
+    void* tag;
+    bool ok;
+    while (cq_.Next(&tag, &ok)) {
+        // Finish() always reports ok = true; errors and cancellation are in the status.
+        auto* call = static_cast<AsyncCallBase*>(tag);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            in_flight_.erase(call);
+        }
+        std::shared_ptr<AsyncCallBase> keep = std::move(call->self_);
+        call->Complete();
+    }
+}
+
+} // namespace quad_sdk
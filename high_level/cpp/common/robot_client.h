@@ -0,0 +1,249 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+#include "common/arena_message.h"
+
+namespace quad_sdk {
+
+class RobotClient;
+template <typename Response>
+class CallPool;
+
+// Common part of an in-flight unary call; the completion queue thread owns the tag.
+class AsyncCallBase
+{
+public:
+    virtual ~AsyncCallBase() = default;
+
+    // Requests cancellation; completion (with CANCELLED) is still reported as usual.
+    void Cancel() { context_->TryCancel(); }
+
+    bool Done() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return done_;
+    }
+
+    // Blocks until the call completes.
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return done_; });
+    }
+
+    // Returns false if the call is still running after `timeout`.
+    template <typename Rep, typename Period>
+    bool WaitFor(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [this] { return done_; });
+    }
+
+    // Blocks until the call completes, cancelling it once `interrupt` becomes true
+    // (e.g. set by a SIGINT handler, which cannot signal a condition variable itself).
+    // Completion wakes the caller immediately; `interrupt` is checked every 10 ms.
+    // Returns true if the call was cancelled here.
+    bool WaitInterruptible(const std::atomic<bool>& interrupt)
+    {
+        bool cancelled = false;
+        while (!WaitFor(std::chrono::milliseconds(10))) {
+            if (!cancelled && interrupt.load()) {
+                Cancel();
+                cancelled = true;
+            }
+        }
+        return cancelled;
+    }
+
+    const grpc::Status& status() const { return status_; } // valid once Done()
+    grpc::ClientContext& context() { return *context_; }   // set deadline/metadata before the call starts
+
+protected:
+    friend class RobotClient;
+
+    // Called on the completion queue thread when the call finishes.
+    virtual void Complete() = 0;
+
+    void MarkDone()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    // Readies a recycled call for its next RPC (a ClientContext serves one RPC only).
+    void ResetBase()
+    {
+        context_.reset(new grpc::ClientContext());
+        status_ = grpc::Status::OK;
+        done_ = false;
+    }
+
+    std::unique_ptr<grpc::ClientContext> context_ {new grpc::ClientContext()};
+    grpc::Status status_;
+    std::shared_ptr<AsyncCallBase> self_; // keeps the call alive while it is in flight
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool done_ = false;
+};
+
+template <typename Response>
+class AsyncCall final : public AsyncCallBase
+{
+public:
+    using Callback = std::function<void(const grpc::Status&, const Response&)>;
+
+    const Response& response() const { return *response_; } // valid once Done()
+
+private:
+    friend class RobotClient;
+    friend class CallPool<Response>;
+
+    void Complete() override
+    {
+        if (callback_)
+            callback_(status_, *response_);
+        MarkDone();
+    }
+
+    void Reset()
+    {
+        reader_.reset(); // lives in the old context's call arena, so goes first
+        ResetBase();
+        response_.Reset();
+        callback_ = nullptr;
+    }
+
+    // The response is parsed into an arena that is reset, not freed, between calls.
+    ArenaMessage<Response> response_;
+    Callback callback_;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<Response>> reader_;
+};
+
+// Finished calls of one response type, kept for reuse so a client polling at a high
+// rate does not allocate a call object, arena and response for every request. The
+// handles given out return their call here when the last reference goes away, or
+// delete it if the pool (its client) is gone by then.
+template <typename Response>
+class CallPool : public std::enable_shared_from_this<CallPool<Response>>
+{
+public:
+    explicit CallPool(size_t max_idle = 16)
+        : max_idle_(max_idle)
+    {
+    }
+
+    std::shared_ptr<AsyncCall<Response>> Acquire()
+    {
+        std::unique_ptr<AsyncCall<Response>> call;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!idle_.empty()) {
+                call = std::move(idle_.back());
+                idle_.pop_back();
+            }
+        }
+        if (call)
+            call->Reset();
+        else
+            call.reset(new AsyncCall<Response>());
+        std::weak_ptr<CallPool> pool = this->shared_from_this();
+        return std::shared_ptr<AsyncCall<Response>>(call.release(), [pool](AsyncCall<Response>* done) {
+            if (auto owner = pool.lock())
+                owner->Release(done);
+            else
+                delete done;
+        });
+    }
+
+private:
+    void Release(AsyncCall<Response>* call)
+    {
+        std::unique_ptr<AsyncCall<Response>> owned(call);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (idle_.size() < max_idle_)
+            idle_.push_back(std::move(owned));
+    }
+
+    const size_t max_idle_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<AsyncCall<Response>>> idle_;
+};
+
+using SequenceCall = AsyncCall<grpc_comm::ExecuteSequenceResponse>;
+using StateCall = AsyncCall<grpc_comm::GetRobotStateResponse>;
+using MotionsCall = AsyncCall<grpc_comm::GetMotionsResponse>;
+
+// Asynchronous gRPCService client: one channel, one stub and one completion queue
+// thread shared by any number of in-flight calls. Calls return immediately with a
+// handle that can be waited on, polled or cancelled; the optional callback runs on
+// the completion queue thread as soon as the call finishes, so keep it short.
+// Call objects, with their arena-backed responses, are recycled once released, so
+// steady polling reuses the same few allocations.
+//
+//   quad_sdk::RobotClient client("192.168.5.2:50051");
+//   auto call = client.ExecuteSequence(request);
+//   call->WaitInterruptible(g_interrupt);
+//   if (call->status().ok() && call->response().success()) ...
+//
+// Destroying the client cancels whatever is still in flight and waits for it.
+class RobotClient
+{
+public:
+    explicit RobotClient(const std::string& server_address);
+    explicit RobotClient(std::shared_ptr<grpc::Channel> channel, const std::string& server_address = "");
+    ~RobotClient();
+
+    RobotClient(const RobotClient&) = delete;
+    RobotClient& operator=(const RobotClient&) = delete;
+
+    std::shared_ptr<SequenceCall> ExecuteSequence(const grpc_comm::ExecuteSequenceRequest& request,
+                                                  SequenceCall::Callback callback = nullptr);
+    std::shared_ptr<StateCall> GetRobotState(const grpc_comm::GetRobotStateRequest& request,
+                                             StateCall::Callback callback = nullptr);
+    std::shared_ptr<MotionsCall> GetAvailableMotions(const grpc_comm::GetMotionsRequest& request,
+                                                     MotionsCall::Callback callback = nullptr);
+
+    // Cancels every call that is still in flight.
+    void CancelAll();
+    size_t InFlight() const;
+
+    const std::string& Address() const { return server_address_; }
+    const std::shared_ptr<grpc::Channel>& Channel() const { return channel_; }
+    // For RPCs not wrapped here (streams); shares the same channel.
+    grpc_comm::gRPCService::Stub* Stub() { return stub_.get(); }
+
+private:
+    template <typename Response, typename Request, typename Prepare>
+    std::shared_ptr<AsyncCall<Response>> Start(CallPool<Response>& pool, const Request& request,
+                                               typename AsyncCall<Response>::Callback callback, Prepare prepare);
+    void PollLoop();
+
+    std::string server_address_;
+    std::shared_ptr<grpc::Channel> channel_;
+    std::unique_ptr<grpc_comm::gRPCService::Stub> stub_;
+    std::shared_ptr<CallPool<grpc_comm::ExecuteSequenceResponse>> sequence_calls_;
+    std::shared_ptr<CallPool<grpc_comm::GetRobotStateResponse>> state_calls_;
+    std::shared_ptr<CallPool<grpc_comm::GetMotionsResponse>> motions_calls_;
+    grpc::CompletionQueue cq_;
+    mutable std::mutex mutex_;
+    std::set<AsyncCallBase*> in_flight_;
+    std::thread poller_;
+};
+
+} // namespace quad_sdk
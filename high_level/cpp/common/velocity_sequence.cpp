@@ -0,0 +1,175 @@
+#include "common/velocity_sequence.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace quad_sdk {
+
+namespace {
+
+const char kVelocitySequenceKey[] = "velocity_sequence";
+
+bool WithinLimit(float value, float limit)
+{
+    return limit <= 0.0f || std::fabs(value) <= limit;
+}
+
+// Shortest fixed-point decimal that parses back to `value`, always with a '.', so round
+// values keep the "0.0,0.6,3.0" form robot firmware has always been sent.
+void AppendDecimal(float value, std::string* out)
+{
+    char buffer[64];
+    for (int precision = 1; precision <= 9; ++precision) {
+        int n = std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+        if (n > 0 && n < static_cast<int>(sizeof(buffer)) && std::strtof(buffer, nullptr) == value) {
+            out->append(buffer, n);
+            return;
+        }
+    }
+    // Very large or tiny magnitudes: %.9g round-trips any float.
+    int n = std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    out->append(buffer, n);
+    if (std::isfinite(value) && out->find_first_of(".e", out->size() - n) == std::string::npos)
+        out->append(".0");
+}
+
+} // namespace
+
+VelocitySequenceBuilder& VelocitySequenceBuilder::Limits(float max_vx, float max_vy, float max_wz)
+{
+    max_vx_ = max_vx;
+    max_vy_ = max_vy;
+    max_wz_ = max_wz;
+    return *this;
+}
+
+VelocitySequenceBuilder& VelocitySequenceBuilder::Add(float vx, float vy, float wz, float duration_s)
+{
+    if (!error_.empty())
+        return *this;
+    const char* problem = nullptr;
+    if (!std::isfinite(vx) || !std::isfinite(vy) || !std::isfinite(wz) || !std::isfinite(duration_s))
+        problem = "values must be finite";
+    else if (duration_s <= 0.0f)
+        problem = "duration must be positive";
+    else if (!WithinLimit(vx, max_vx_) || !WithinLimit(vy, max_vy_) || !WithinLimit(wz, max_wz_))
+        problem = "velocity exceeds limits";
+    if (problem) {
+        error_ = "velocity segment " + std::to_string(segments_.segments_size()) + ": " + problem;
+        return *this;
+    }
+
+    auto* segment = segments_.add_segments();
+    segment->set_vx(vx);
+    segment->set_vy(vy);
+    segment->set_wz(wz);
+    segment->set_duration_s(duration_s);
+    duration_s_ += duration_s;
+    return *this;
+}
+
+void VelocitySequenceBuilder::Clear()
+{
+    segments_.Clear();
+    duration_s_ = 0.0;
+    error_.clear();
+}
+
+bool VelocitySequenceBuilder::CheckBuildable(std::string* error) const
+{
+    std::string message = error_;
+    if (message.empty() && segments_.segments_size() == 0)
+        message = "velocity sequence is empty";
+    if (message.empty())
+        return true;
+    if (error)
+        *error = message;
+    return false;
+}
+
+bool VelocitySequenceBuilder::AddTo(grpc_comm::Motion* motion, std::string* error) const
+{
+    if (!CheckBuildable(error))
+        return false;
+    auto* param = motion->add_parameters();
+    param->set_key(kVelocitySequenceKey);
+    param->set_string_value(ToText());
+    return true;
+}
+
+bool VelocitySequenceBuilder::AddTypedTo(grpc_comm::Motion* motion, std::string* error) const
+{
+    if (!CheckBuildable(error))
+        return false;
+    auto* param = motion->add_parameters();
+    param->set_key(kVelocitySequenceKey);
+    *param->mutable_velocity_segments() = segments_;
+    return true;
+}
+
+std::string VelocitySequenceBuilder::ToText() const
+{
+    std::string text;
+    text.reserve(segments_.segments_size() * 32);
+    for (const auto& s : segments_.segments()) {
+        AppendDecimal(s.vx(), &text);
+        text += ',';
+        AppendDecimal(s.vy(), &text);
+        text += ',';
+        AppendDecimal(s.wz(), &text);
+        text += ',';
+        AppendDecimal(s.duration_s(), &text);
+        text += ';';
+    }
+    return text;
+}
+
+bool ParseVelocitySequence(const std::string& text, grpc_comm::VelocitySegments* segments, std::string* error)
+{
+    segments->Clear();
+    const char* p = text.c_str();
+    const char* end = p + text.size();
+    while (p < end) {
+        if (*p == ';' || std::isspace(static_cast<unsigned char>(*p))) {
+            p++;
+            continue;
+        }
+        float values[4];
+        for (int i = 0; i < 4; i++) {
+            char* next = nullptr;
+            values[i] = std::strtof(p, &next);
+            if (next == p) {
+                *error = "malformed velocity segment " + std::to_string(segments->segments_size());
+                return false;
+            }
+            p = next;
+            while (p < end && *p == ' ')
+                p++;
+            char expected = i < 3 ? ',' : ';';
+            if (p < end && *p != expected) {
+                *error = "malformed velocity segment " + std::to_string(segments->segments_size());
+                return false;
+            }
+            if (p < end)
+                p++;
+            else if (i < 3) {
+                *error = "velocity segment " + std::to_string(segments->segments_size()) + " has fewer than 4 values";
+                return false;
+            }
+        }
+        if (values[3] < 0.0f) {
+            *error = "velocity segment " + std::to_string(segments->segments_size()) + " has a negative duration";
+            return false;
+        }
+        auto* segment = segments->add_segments();
+        segment->set_vx(values[0]);
+        segment->set_vy(values[1]);
+        segment->set_wz(values[2]);
+        segment->set_duration_s(values[3]);
+    }
+    return true;
+}
+
+} // namespace quad_sdk
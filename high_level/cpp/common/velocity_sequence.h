@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "proto/grpc_service.pb.h"
+
+namespace quad_sdk {
+
+// Builds and validates the velocity_sequence parameter of a gait motion (walk,
+// flying_trot, rl). AddTo() writes the "vx,vy,wz,duration;..." string that robot
+// firmware parses. AddTypedTo() writes typed VelocitySegments instead, which skips text
+// parsing and keeps full float precision, but only robots that implement the
+// velocity_segments field (currently the mock robot) understand it.
+//
+//   quad_sdk::VelocitySequenceBuilder velocity;
+//   velocity.Limits(0.8f, 0.4f, 1.0f)
+//       .Add(0.0f, 0.0f, 0.6f, 3.0f)   // turn left in place for 3 s
+//       .Add(0.6f, 0.0f, 0.0f, 3.0f)   // forward for 3 s
+//       .Hold(1.0f);                   // stop for 1 s
+//   std::string error;
+//   if (!velocity.AddTo(walk_motion, &error)) ...
+//
+// Segments are validated as they are added: values must be finite, durations positive
+// and velocities within Limits(). The first failure is kept in Error() and makes AddTo()
+// refuse, so a chain of Add() calls needs one check at the end.
+class VelocitySequenceBuilder
+{
+public:
+    // Magnitude limits checked by later Add() calls; 0 leaves an axis unchecked (default).
+    VelocitySequenceBuilder& Limits(float max_vx, float max_vy, float max_wz);
+
+    VelocitySequenceBuilder& Add(float vx, float vy, float wz, float duration_s);
+    // Zero velocity for duration_s.
+    VelocitySequenceBuilder& Hold(float duration_s) { return Add(0.0f, 0.0f, 0.0f, duration_s); }
+    // Pre-sizes the segment list for long choreographies.
+    void Reserve(size_t segments) { segments_.mutable_segments()->Reserve(static_cast<int>(segments)); }
+    void Clear();
+
+    bool Ok() const { return error_.empty(); }
+    const std::string& Error() const { return error_; }
+    size_t Size() const { return static_cast<size_t>(segments_.segments_size()); }
+    double Duration() const { return duration_s_; }
+    const grpc_comm::VelocitySegments& Segments() const { return segments_; }
+
+    // Appends a "velocity_sequence" string parameter holding the segments to `motion`.
+    // Returns false and leaves `motion` untouched if the sequence is empty or invalid.
+    bool AddTo(grpc_comm::Motion* motion, std::string* error = nullptr) const;
+    // Same, as typed velocity_segments. Requires robot support for that field.
+    bool AddTypedTo(grpc_comm::Motion* motion, std::string* error = nullptr) const;
+    // "vx,vy,wz,duration;..." with each value in the shortest decimal that round-trips
+    // and always a '.': 0.6f -> "0.6", 3.0f -> "3.0".
+    std::string ToText() const;
+
+private:
+    bool CheckBuildable(std::string* error) const;
+
+    grpc_comm::VelocitySegments segments_;
+    float max_vx_ = 0.0f;
+    float max_vy_ = 0.0f;
+    float max_wz_ = 0.0f;
+    double duration_s_ = 0.0;
+    std::string error_;
+};
+
+// Parses the "vx,vy,wz,duration;..." string (empty segments are skipped).
+// Returns false with `error` set on a malformed segment or a negative duration.
+bool ParseVelocitySequence(const std::string& text, grpc_comm::VelocitySegments* segments, std::string* error);
+
+} // namespace quad_sdk
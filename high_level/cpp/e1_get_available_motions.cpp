@@ -2,51 +2,61 @@
 #include <string>
 #include <grpcpp/grpcpp.h>
 #include "proto/grpc_service.grpc.pb.h"
+#include "common/motion_catalogue.h"
+#include "common/robot_client.h"
 
-using grpc_comm::GetMotionsRequest;
 using grpc_comm::GetMotionsResponse;
-using grpc_comm::gRPCService;
 
 class MotionClient
 {
 public:
     explicit MotionClient(const std::string& server_address)
-        : server_address_(server_address)
+        : client_(server_address)
     {
-        auto channel = grpc::CreateChannel(server_address_, grpc::InsecureChannelCredentials());
-        stub_ = gRPCService::NewStub(channel);
     }
 
-    // Query and print all available motions.
-    bool Run()
+    // Query and print all available motions. With a cache file, the catalogue is loaded
+    // from it first and only re-fetched if the robot's catalogue_version differs.
+    bool Run(const std::string& cache_file)
     {
-        std::cout << "Connected to server: " << server_address_ << std::endl;
+        std::cout << "Connected to server: " << client_.Address() << std::endl;
         std::cout << "Example 1: Get Available Motions" << std::endl;
 
-        GetMotionsRequest request;
-        GetMotionsResponse response;
-        grpc::ClientContext context;
+        quad_sdk::MotionCatalogue catalogue;
+        std::string error;
+        if (!cache_file.empty()) {
+            if (catalogue.Load(cache_file, &error))
+                std::cout << "Loaded " << catalogue.Current()->Size() << " motions from " << cache_file
+                          << " (version " << catalogue.Current()->Version() << ")" << std::endl;
+            else
+                std::cout << "No usable cache: " << error << std::endl;
+        }
 
-        auto status = stub_->GetAvailableMotions(&context, request, &response);
+        bool changed = false;
+        grpc::Status status = catalogue.Refresh(client_, &changed);
         if (!status.ok()) {
             std::cout << "RPC failed: " << status.error_message() << std::endl;
             return false;
         }
-        if (!response.success()) {
-            std::cout << "Failed to retrieve motions: " << response.message() << std::endl;
-            return false;
-        }
+        auto motions = catalogue.Current();
+        if (changed)
+            std::cout << "Successfully retrieved motion list: " << motions->Response().message() << std::endl;
+        else
+            std::cout << "Motion list unchanged, using the cached copy" << std::endl;
+        if (!cache_file.empty() && changed && !catalogue.Save(cache_file, &error))
+            std::cout << "Could not save the cache: " << error << std::endl;
 
-        std::cout << "Successfully retrieved motion list: " << response.message() << std::endl;
-        std::cout << "Found " << response.motions_size() << " motions:\n" << std::endl;
+        const GetMotionsResponse& response = motions->Response();
+        std::cout << "Found " << response.motions_size() << " motions (version " << motions->Version() << "):\n"
+                  << std::endl;
 
         for (const auto& motion : response.motions()) {
             const std::string& motion_id = motion.motion_id();
             std::cout << "  [" << motion_id << "]" << std::endl;
 
-            auto desc_it = response.descriptions().find(motion_id);
-            if (desc_it != response.descriptions().end()) {
-                std::cout << "    Description: " << desc_it->second << std::endl;
+            const std::string& description = motions->Description(motion_id);
+            if (!description.empty()) {
+                std::cout << "    Description: " << description << std::endl;
             }
 
             if (motion.parameters_size() > 0) {
@@ -66,6 +76,9 @@ public:
                         case grpc_comm::Parameter::kBoolValue:
                             std::cout << (param.bool_value() ? "true" : "false") << " (bool)";
                             break;
+                        case grpc_comm::Parameter::kVelocitySegments:
+                            std::cout << param.velocity_segments().segments_size() << " segments (velocity_segments)";
+                            break;
                         default:
                             std::cout << "(not set)";
                             break;
@@ -79,13 +92,13 @@ public:
     }
 
 private:
-    std::unique_ptr<gRPCService::Stub> stub_;
-    std::string server_address_;
+    quad_sdk::RobotClient client_;
 };
 
 int main(int argc, char** argv)
 {
     const std::string server_address = (argc > 1) ? argv[1] : "192.168.5.2:50051";
+    const std::string cache_file = (argc > 2) ? argv[2] : "";
     MotionClient client(server_address);
-    return client.Run() ? 0 : 1;
+    return client.Run(cache_file) ? 0 : 1;
 }
@@ -1,16 +1,14 @@
 #include <atomic>
-#include <chrono>
 #include <csignal>
 #include <iostream>
 #include <memory>
 #include <string>
-#include <thread>
 #include <grpcpp/grpcpp.h>
 #include "proto/grpc_service.grpc.pb.h"
+#include "common/robot_client.h"
 
 using grpc_comm::ExecuteSequenceRequest;
 using grpc_comm::ExecuteSequenceResponse;
-using grpc_comm::gRPCService;
 using grpc_comm::MotionSequence;
 
 std::atomic<bool> g_interrupt {false};
@@ -22,15 +20,13 @@ class AutoStateSwitchClient
 {
 public:
     explicit AutoStateSwitchClient(const std::string& server_address)
-        : server_address_(server_address)
+        : client_(server_address)
     {
-        auto channel = grpc::CreateChannel(server_address_, grpc::InsecureChannelCredentials());
-        stub_ = gRPCService::NewStub(channel);
     }
 
     bool Run(const std::string& target_state)
     {
-        std::cout << "Connected to server: " << server_address_ << std::endl;
+        std::cout << "Connected to server: " << client_.Address() << std::endl;
         std::cout << "Example 3: PATH_TO_STATE Automatic State Switching Demo" << std::endl;
         std::cout << "Target state: " << target_state << std::endl;
 
@@ -50,25 +46,10 @@ public:
 
         std::cout << "\nSequence is running... Press Ctrl+C to cancel." << std::endl;
 
-        ExecuteSequenceResponse response;
-        grpc::ClientContext context;
-        grpc::Status status;
-        bool finished = false;
-        bool cancelled = false;
-
-        std::thread rpc_thread([&] {
-            status = stub_->ExecuteSequence(&context, request, &response);
-            finished = true;
-        });
-        rpc_thread.detach();
-
-        while (!finished) {
-            if (g_interrupt.exchange(false)) {
-                cancelled = true;
-                context.TryCancel();
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
+        auto call = client_.ExecuteSequence(request);
+        bool cancelled = call->WaitInterruptible(g_interrupt);
+        const grpc::Status& status = call->status();
+        const ExecuteSequenceResponse& response = call->response();
 
         if (!status.ok()) {
             if (status.error_code() == grpc::StatusCode::CANCELLED && cancelled) {
@@ -113,8 +94,7 @@ public:
     }
 
 private:
-    std::unique_ptr<gRPCService::Stub> stub_;
-    std::string server_address_;
+    quad_sdk::RobotClient client_;
 };
 
 int main(int argc, char** argv)
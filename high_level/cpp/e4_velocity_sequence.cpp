@@ -1,16 +1,15 @@
 #include <atomic>
-#include <chrono>
 #include <csignal>
 #include <iostream>
 #include <memory>
 #include <string>
-#include <thread>
 #include <grpcpp/grpcpp.h>
 #include "proto/grpc_service.grpc.pb.h"
+#include "common/robot_client.h"
+#include "common/velocity_sequence.h"
 
 using grpc_comm::ExecuteSequenceRequest;
 using grpc_comm::ExecuteSequenceResponse;
-using grpc_comm::gRPCService;
 using grpc_comm::MotionSequence;
 
 std::atomic<bool> g_interrupt {false};
@@ -22,17 +21,18 @@ void SignalHandler(int)
 class VelocitySequenceClient
 {
 public:
-    explicit VelocitySequenceClient(const std::string& server_address)
-        : server_address_(server_address)
+    // typed sends velocity_segments instead of the "vx,vy,wz,duration;..." string; only
+    // robots that implement that field (e.g. the mock robot) accept it.
+    VelocitySequenceClient(const std::string& server_address, bool typed)
+        : client_(server_address)
+        , typed_(typed)
     {
-        auto channel = grpc::CreateChannel(server_address_, grpc::InsecureChannelCredentials());
-        stub_ = gRPCService::NewStub(channel);
     }
 
     // Execute the walk demo sequence.
     bool RunWalkDemo()
     {
-        std::cout << "Connected to server: " << server_address_ << std::endl;
+        std::cout << "Connected to server: " << client_.Address() << std::endl;
         std::cout << "Example 4a: Walk 3D Velocity Sequence Demo" << std::endl;
         std::cout << "Move forward, backward, left, right + rotate\n" << std::endl;
 
@@ -47,11 +47,17 @@ public:
         motion1->mutable_parameters()->Add()->set_key("target_state");
         motion1->mutable_parameters(0)->set_string_value("WALK");
 
+        quad_sdk::VelocitySequenceBuilder velocity;
+        velocity.Add(0.0f, 0.0f, 0.6f, 3.0f)  // turn left in place
+            .Add(0.0f, 0.0f, -0.6f, 3.0f)    // turn right in place
+            .Hold(1.0f)
+            .Add(0.6f, 0.0f, 0.0f, 3.0f)     // forward
+            .Add(-0.6f, 0.0f, 0.0f, 3.0f)    // backward
+            .Hold(1.0f);
         auto* motion2 = sequence->add_motions();
         motion2->set_motion_id("walk");
-        motion2->mutable_parameters()->Add()->set_key("velocity_sequence");
-        motion2->mutable_parameters(0)->set_string_value(
-            "0.0,0.0,0.6,3.0;0.0,0.0,-0.6,3.0;0.0,0.0,0.0,1.0;0.6,0.0,0.0,3.0;-0.6,0.0,0.0,3.0;0.0,0.0,0.0,1.0;");
+        if (!AddVelocity(velocity, motion2))
+            return false;
 
         auto* motion3 = sequence->add_motions();
         motion3->set_motion_id("path_to_state");
@@ -61,23 +67,10 @@ public:
         request.set_immediate_start(true);
 
         std::cout << "Sequence is running... Press Ctrl+C to stop." << std::endl;
-        ExecuteSequenceResponse response;
-        grpc::ClientContext context;
-        grpc::Status status;
-        bool finished = false, cancelled = false;
-
-        std::thread([&] {
-            status = stub_->ExecuteSequence(&context, request, &response);
-            finished = true;
-        }).detach();
-
-        while (!finished) {
-            if (g_interrupt.exchange(false)) {
-                cancelled = true;
-                context.TryCancel();
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
+        auto call = client_.ExecuteSequence(request);
+        bool cancelled = call->WaitInterruptible(g_interrupt);
+        const grpc::Status& status = call->status();
+        const ExecuteSequenceResponse& response = call->response();
 
         if (status.ok() || (status.error_code() == grpc::StatusCode::CANCELLED && cancelled)) {
             if (response.success()) {
@@ -95,7 +88,7 @@ public:
     // Execute the flying trot demo sequence.
     bool RunFlyingTrotDemo()
     {
-        std::cout << "Connected to server: " << server_address_ << std::endl;
+        std::cout << "Connected to server: " << client_.Address() << std::endl;
         std::cout << "Example 4b: Flying Trot 3D Velocity Sequence Demo" << std::endl;
         std::cout << "High-speed sprint + sharp turns + rapid rotation\n" << std::endl;
 
@@ -111,10 +104,12 @@ public:
         motion1->mutable_parameters()->Add()->set_key("target_state");
         motion1->mutable_parameters(0)->set_string_value("FLYING_TROT");
 
+        quad_sdk::VelocitySequenceBuilder velocity;
+        velocity.Add(0.0f, 0.0f, 0.2f, 1.5f).Add(0.0f, 0.0f, -0.2f, 1.5f).Hold(1.0f);
         auto* motion2 = sequence->add_motions();
         motion2->set_motion_id("flying_trot");
-        motion2->mutable_parameters()->Add()->set_key("velocity_sequence");
-        motion2->mutable_parameters(0)->set_string_value("0.0,0.0,0.2,1.5;0.0,0.0,-0.2,1.5;0.0,0.0,0.0,1.0");
+        if (!AddVelocity(velocity, motion2))
+            return false;
 
         auto* motion3 = sequence->add_motions();
         motion3->set_motion_id("path_to_state");
@@ -124,24 +119,12 @@ public:
         request.set_immediate_start(true);
 
         std::cout << "Sequence is running... Press Ctrl+C to stop." << std::endl;
-        ExecuteSequenceResponse response;
-        grpc::ClientContext context;
-        grpc::Status status;
-        bool finished = false, cancelled = false;
-
-        std::thread([&] {
-            status = stub_->ExecuteSequence(&context, request, &response);
-            finished = true;
-        }).detach();
-
-        while (!finished) {
-            if (g_interrupt.exchange(false)) {
-                cancelled = true;
-                std::cout << "\nKeyboardInterrupt detected, cancelling execution..." << std::endl;
-                context.TryCancel();
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
+        auto call = client_.ExecuteSequence(request);
+        bool cancelled = call->WaitInterruptible(g_interrupt);
+        const grpc::Status& status = call->status();
+        const ExecuteSequenceResponse& response = call->response();
+        if (cancelled)
+            std::cout << "\nKeyboardInterrupt detected, execution cancelled" << std::endl;
 
         if (status.ok() || (status.error_code() == grpc::StatusCode::CANCELLED && cancelled)) {
             if (response.success()) {
@@ -157,8 +140,20 @@ public:
     }
 
 private:
-    std::unique_ptr<gRPCService::Stub> stub_;
-    std::string server_address_;
+    bool AddVelocity(const quad_sdk::VelocitySequenceBuilder& velocity, grpc_comm::Motion* motion)
+    {
+        std::string error;
+        bool ok = typed_ ? velocity.AddTypedTo(motion, &error) : velocity.AddTo(motion, &error);
+        if (!ok)
+            std::cout << "Invalid velocity sequence: " << error << std::endl;
+        else
+            std::cout << velocity.Size() << " velocity segments, " << velocity.Duration() << " s ("
+                      << (typed_ ? "typed" : "text") << ")" << std::endl;
+        return ok;
+    }
+
+    quad_sdk::RobotClient client_;
+    bool typed_;
 };
 
 int main(int argc, char** argv)
@@ -167,12 +162,12 @@ int main(int argc, char** argv)
     std::signal(SIGINT, SignalHandler);
 
     const std::string server_address = (argc > 1) ? argv[1] : "192.168.5.2:50051";
-    VelocitySequenceClient client(server_address);
-
     std::string choice = "1";
     if (argc > 2) {
         choice = argv[2];
     }
+    const bool typed = (argc > 3) && std::string(argv[3]) == "typed";
+    VelocitySequenceClient client(server_address, typed);
 
     if (choice == "2") {
         return client.RunFlyingTrotDemo() ? 0 : 1;
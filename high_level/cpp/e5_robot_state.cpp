@@ -4,31 +4,32 @@
 #include <string>
 #include <grpcpp/grpcpp.h>
 #include "proto/grpc_service.grpc.pb.h"
+#include "common/robot_client.h"
+#include "common/packed_state.h"
 
 using grpc_comm::GetRobotStateRequest;
 using grpc_comm::GetRobotStateResponse;
-using grpc_comm::gRPCService;
+using quad_sdk::PackedStateV1;
 
 class RobotStateClient
 {
 public:
     explicit RobotStateClient(const std::string& server_address)
-        : server_address_(server_address)
+        : client_(server_address)
     {
-        auto channel = grpc::CreateChannel(server_address_, grpc::InsecureChannelCredentials());
-        stub_ = gRPCService::NewStub(channel);
     }
 
-    bool PrintState()
+    bool PrintState(bool packed)
     {
-        std::cout << "Connected to server: " << server_address_ << std::endl;
+        std::cout << "Connected to server: " << client_.Address() << std::endl;
         std::cout << "\nFetching robot state..." << std::endl;
 
         GetRobotStateRequest request;
-        GetRobotStateResponse response;
-        grpc::ClientContext context;
-
-        auto status = stub_->GetRobotState(&context, request, &response);
+        request.set_packed(packed);
+        auto call = client_.GetRobotState(request);
+        call->Wait();
+        const grpc::Status& status = call->status();
+        const GetRobotStateResponse& response = call->response();
         if (!status.ok()) {
             std::cout << "Failed to get robot state: " << status.error_message() << std::endl;
             return false;
@@ -43,15 +44,21 @@ public:
         std::cout << "  Message: " << response.message() << "\n" << std::endl;
         std::cout << "Robot State Data:" << std::endl;
 
+        if (packed) {
+            PackedStateV1 packed_state;
+            if (!quad_sdk::UnpackState(response.packed_state(), &packed_state)) {
+                std::cout << "Unsupported packed state (schema version " << response.packed_state().schema_version()
+                          << ", " << response.packed_state().data().size() << " bytes)" << std::endl;
+                return false;
+            }
+            PrintPackedState(packed_state);
+            std::cout << "\n" << std::string(60, '=') << std::endl;
+            return true;
+        }
+
         const auto& state = response.robot_state();
         auto print_array = [](const google::protobuf::RepeatedField<float>& arr, const std::string& label) {
-            std::cout << label << ": [";
-            for (int i = 0; i < arr.size(); ++i) {
-                if (i > 0)
-                    std::cout << ", ";
-                std::cout << std::fixed << std::setprecision(2) << arr[i];
-            }
-            std::cout << "]" << std::endl;
+            PrintArray(arr.data(), arr.size(), label);
         };
 
         std::cout << "\nLeg Joints [rad] / [rad/s] / [Nm]:" << std::endl;
@@ -83,11 +90,11 @@ public:
 
         if (state.temp_size() >= 10) {
             std::cout << "\nAdditional Data:" << std::endl;
-            std::cout << "  Total Contact Force X [N]: " << std::fixed << std::setprecision(2) << state.temp(0)
+            std::cout << "  Left Foot Contact Force [N]: " << std::fixed << std::setprecision(2) << state.temp(0)
                       << std::endl;
-            std::cout << "  Total Contact Force Y [N]: " << std::fixed << std::setprecision(2) << state.temp(1)
+            std::cout << "  Right Foot Contact Force [N]: " << std::fixed << std::setprecision(2) << state.temp(1)
                       << std::endl;
-            std::cout << "  Total Contact Force Z [N]: " << std::fixed << std::setprecision(2) << state.temp(2)
+            std::cout << "  Total Contact Force [N]: " << std::fixed << std::setprecision(2) << state.temp(2)
                       << std::endl;
             std::cout << "  Total GRF X [N]: " << std::fixed << std::setprecision(2) << state.temp(3) << std::endl;
             std::cout << "  Battery Voltage 1 [V]: " << std::fixed << std::setprecision(2) << state.temp(8)
@@ -101,13 +108,58 @@ public:
     }
 
 private:
-    std::unique_ptr<gRPCService::Stub> stub_;
-    std::string server_address_;
+    static void PrintArray(const float* values, int n, const std::string& label)
+    {
+        std::cout << label << ": [";
+        for (int i = 0; i < n; ++i) {
+            if (i > 0)
+                std::cout << ", ";
+            std::cout << std::fixed << std::setprecision(2) << values[i];
+        }
+        std::cout << "]" << std::endl;
+    }
+
+    // Same report from the packed block: fixed sizes and named fields instead of temp[] indices.
+    static void PrintPackedState(const PackedStateV1& state)
+    {
+        std::cout << "\nLeg Joints [rad] / [rad/s] / [Nm]:" << std::endl;
+        PrintArray(state.jpos_leg, 12, "  Positions [rad]");
+        PrintArray(state.jpos_leg_des, 12, "  Desired Positions [rad]");
+        PrintArray(state.jvel_leg, 12, "  Velocities [rad/s]");
+        PrintArray(state.jvel_leg_des, 12, "  Desired Velocities [rad/s]");
+        PrintArray(state.jtau_leg, 12, "  Torques [Nm]");
+        PrintArray(state.jtau_leg_des, 12, "  Desired Torques [Nm]");
+
+        std::cout << "\nBody State:" << std::endl;
+        PrintArray(state.pos_body, 3, "  Position (x,y,z) [m]");
+        PrintArray(state.vel_body, 3, "  Velocity [m/s]");
+        PrintArray(state.acc_body, 3, "  Acceleration [m/s²]");
+        PrintArray(state.omega_body, 3, "  Angular Velocity [rad/s]");
+        PrintArray(state.ori_body, 3, "  Orientation (roll,pitch,yaw) [rad]");
+
+        std::cout << "\nContact Forces [N]:" << std::endl;
+        PrintArray(state.grf_left, 6, "  Left Foot [N]");
+        PrintArray(state.grf_right, 6, "  Right Foot [N]");
+        PrintArray(state.grf_vertical_filtered, 2, "  Vertical Filtered [N]");
+
+        std::cout << "\nAdditional Data:" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "  Left Foot Contact Force [N]: " << state.contact_force_left << std::endl;
+        std::cout << "  Right Foot Contact Force [N]: " << state.contact_force_right << std::endl;
+        std::cout << "  Total Contact Force [N]: " << state.contact_force_total << std::endl;
+        std::cout << "  Total GRF X [N]: " << state.grf_total_x << std::endl;
+        std::cout << "  Battery Voltage 1 [V]: " << state.battery_voltage_1 << std::endl;
+        std::cout << "  Battery Voltage 2 [V]: " << state.battery_voltage_2 << std::endl;
+    }
+
+    quad_sdk::RobotClient client_;
 };
 
 int main(int argc, char** argv)
 {
     const std::string server_address = (argc > 1) ? argv[1] : "192.168.5.2:50051";
+    // "packed" requests the fixed-layout PackedRobotState instead of RobotState.
+    bool packed = (argc > 2) && std::string(argv[2]) == "packed";
     RobotStateClient client(server_address);
-    return client.PrintState() ? 0 : 1;
+    return client.PrintState(packed) ? 0 : 1;
 }
@@ -1,16 +1,15 @@
 #include <atomic>
-#include <chrono>
 #include <csignal>
 #include <iostream>
 #include <memory>
 #include <string>
-#include <thread>
 #include <grpcpp/grpcpp.h>
 #include "proto/grpc_service.grpc.pb.h"
+#include "common/motion_builders.h"
+#include "common/robot_client.h"
 
 using grpc_comm::ExecuteSequenceRequest;
 using grpc_comm::ExecuteSequenceResponse;
-using grpc_comm::gRPCService;
 using grpc_comm::MotionSequence;
 
 std::atomic<bool> g_interrupt {false};
@@ -23,16 +22,14 @@ class BalanceMotionsClient
 {
 public:
     explicit BalanceMotionsClient(const std::string& server_address)
-        : server_address_(server_address)
+        : client_(server_address)
     {
-        auto channel = grpc::CreateChannel(server_address_, grpc::InsecureChannelCredentials());
-        stub_ = gRPCService::NewStub(channel);
     }
 
     // Execute balance motions demo with optional BPM parameter.
     bool Run(double bpm = 120.0)
     {
-        std::cout << "Connected to server: " << server_address_ << "\n" << std::endl;
+        std::cout << "Connected to server: " << client_.Address() << "\n" << std::endl;
         std::cout << "Example 6: Balance Motions Demo" << std::endl;
 
         ExecuteSequenceRequest request;
@@ -42,50 +39,28 @@ public:
         sequence->set_bpm(bpm);
         sequence->set_loop(false);
 
-        auto add_motion = [sequence](const std::string& id, float beats, float amp) {
-            auto* m = sequence->add_motions();
-            m->set_motion_id(id);
-            m->mutable_parameters()->Add()->set_key("beats");
-            m->mutable_parameters(0)->set_float_value(beats);
-            m->mutable_parameters()->Add()->set_key("amplitude");
-            m->mutable_parameters(1)->set_float_value(amp);
-        };
-
-        auto* motion = sequence->add_motions();
-        motion->set_motion_id("path_to_state");
-        motion->mutable_parameters()->Add()->set_key("target_state");
-        motion->mutable_parameters(0)->set_string_value("BALANCE_STAND");
-
-        add_motion("balance_pitch", 1.0f, 0.8f);
-        add_motion("balance_pitch", 1.0f, -0.8f);
-        add_motion("balance_yaw", 1.0f, 0.8f);
-        add_motion("balance_yaw", 1.0f, -0.8f);
-        add_motion("balance_roll", 1.0f, 0.8f);
-        add_motion("balance_roll", 1.0f, -0.8f);
-        add_motion("balance_height", 2.0f, -0.8f);
-        add_motion("balance_neutral", 1.0f, 0.0f);
+        // Typed builders generated from the motion catalogue (tools/motion_codegen.cpp):
+        // a misspelt motion or parameter does not compile. Fields are {beats, amplitude}.
+        using namespace quad_sdk::motions;
+        sequence->mutable_motions()->Reserve(9);
+        PathToState {"BALANCE_STAND"}.AppendTo(sequence);
+        BalancePitch {1.0f, 0.8f}.AppendTo(sequence);
+        BalancePitch {1.0f, -0.8f}.AppendTo(sequence);
+        BalanceYaw {1.0f, 0.8f}.AppendTo(sequence);
+        BalanceYaw {1.0f, -0.8f}.AppendTo(sequence);
+        BalanceRoll {1.0f, 0.8f}.AppendTo(sequence);
+        BalanceRoll {1.0f, -0.8f}.AppendTo(sequence);
+        BalanceHeight {2.0f, -0.8f}.AppendTo(sequence);
+        BalanceNeutral {1.0f, 0.0f}.AppendTo(sequence);
 
         request.set_immediate_start(true);
 
         std::cout << "Sequence is running... Press Ctrl+C to stop." << std::endl;
 
-        ExecuteSequenceResponse response;
-        grpc::ClientContext context;
-        grpc::Status status;
-        bool finished = false, cancelled = false;
-
-        std::thread([&] {
-            status = stub_->ExecuteSequence(&context, request, &response);
-            finished = true;
-        }).detach();
-
-        while (!finished) {
-            if (g_interrupt.exchange(false)) {
-                cancelled = true;
-                context.TryCancel();
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
+        auto call = client_.ExecuteSequence(request);
+        bool cancelled = call->WaitInterruptible(g_interrupt);
+        const grpc::Status& status = call->status();
+        const ExecuteSequenceResponse& response = call->response();
 
         if (status.ok() || (status.error_code() == grpc::StatusCode::CANCELLED && cancelled)) {
             if (response.success()) {
@@ -101,8 +76,7 @@ public:
     }
 
 private:
-    std::unique_ptr<gRPCService::Stub> stub_;
-    std::string server_address_;
+    quad_sdk::RobotClient client_;
 };
 
 int main(int argc, char** argv)
@@ -0,0 +1,138 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <google/protobuf/reflection.h>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+#include "common/robot_client.h"
+
+using grpc_comm::RobotState;
+using grpc_comm::RobotStateUpdate;
+using grpc_comm::StreamRobotStateRequest;
+
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
+{
+    g_interrupt.store(true);
+}
+
+class RobotStateStreamClient
+{
+public:
+    explicit RobotStateStreamClient(const std::string& server_address)
+        : client_(server_address)
+    {
+    }
+
+    // Subscribe to the state stream and print a summary once per second until Ctrl+C.
+    bool Run(double rate_hz, const std::vector<std::string>& fields)
+    {
+        std::cout << "Connected to server: " << client_.Address() << std::endl;
+        std::cout << "\nStreaming robot state at " << rate_hz << " Hz";
+        if (!fields.empty()) {
+            std::cout << " (fields:";
+            for (const auto& f : fields)
+                std::cout << " " << f;
+            std::cout << ")";
+        }
+        std::cout << "... Press Ctrl+C to stop.\n" << std::endl;
+
+        StreamRobotStateRequest request;
+        request.set_rate_hz(static_cast<float>(rate_hz));
+        for (const auto& f : fields)
+            request.add_fields(f);
+
+        grpc::ClientContext context;
+        std::atomic<bool> done {false};
+        std::thread canceller([&] {
+            while (!done) {
+                if (g_interrupt) {
+                    context.TryCancel();
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+        });
+
+        auto reader = client_.Stub()->StreamRobotState(&context, request);
+        RobotStateUpdate update;
+        uint64_t received = 0, gaps = 0, last_seq = 0, window_count = 0;
+        auto window_start = std::chrono::steady_clock::now();
+        while (reader->Read(&update)) {
+            if (received > 0 && update.seq() > last_seq + 1)
+                gaps += update.seq() - last_seq - 1;
+            last_seq = update.seq();
+            received++;
+            window_count++;
+
+            auto now = std::chrono::steady_clock::now();
+            double window_s = std::chrono::duration<double>(now - window_start).count();
+            if (window_s >= 1.0) {
+                std::cout << "[" << update.seq() << "] " << std::fixed << std::setprecision(1)
+                          << window_count / window_s << " Hz, skipped " << gaps << std::endl;
+                PrintState(update.robot_state());
+                window_start = now;
+                window_count = 0;
+            }
+        }
+        grpc::Status status = reader->Finish();
+        done = true;
+        canceller.join();
+
+        std::cout << "\nReceived " << received << " updates, " << gaps << " skipped by the server" << std::endl;
+        if (status.ok() || (status.error_code() == grpc::StatusCode::CANCELLED && g_interrupt))
+            return true;
+        std::cout << "Stream failed: " << status.error_message() << std::endl;
+        return false;
+    }
+
+private:
+    // Prints every populated field, so a field mask shows up as a shorter summary.
+    static void PrintState(const RobotState& state)
+    {
+        const auto* descriptor = state.GetDescriptor();
+        const auto* reflection = state.GetReflection();
+        for (int i = 0; i < descriptor->field_count(); ++i) {
+            const auto* field = descriptor->field(i);
+            auto values = reflection->GetRepeatedFieldRef<float>(state, field);
+            if (values.empty())
+                continue;
+            std::cout << "  " << std::left << std::setw(22) << field->name() << std::right << "[";
+            for (int k = 0; k < values.size(); ++k) {
+                if (k > 0)
+                    std::cout << ", ";
+                std::cout << std::fixed << std::setprecision(2) << values.Get(k);
+            }
+            std::cout << "]" << std::endl;
+        }
+    }
+
+    quad_sdk::RobotClient client_;
+};
+
+int main(int argc, char** argv)
+{
+    // Register Ctrl+C handler
+    std::signal(SIGINT, SignalHandler);
+
+    const std::string server_address = (argc > 1) ? argv[1] : "192.168.5.2:50051";
+    double rate_hz = (argc > 2) ? std::stod(argv[2]) : 50.0;
+    // Comma-separated RobotState field names, e.g. "jpos_leg,ori_body"; empty = all fields.
+    std::vector<std::string> fields;
+    std::stringstream ss((argc > 3) ? argv[3] : "");
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+        if (!field.empty())
+            fields.push_back(field);
+    }
+
+    RobotStateStreamClient client(server_address);
+    return client.Run(rate_hz, fields) ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+#include "common/control_session.h"
+#include "common/latency_stats.h"
+#include "common/robot_client.h"
+
+using grpc_comm::ControlEvent;
+using grpc_comm::Motion;
+using grpc_comm::MotionSequence;
+
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
+{
+    g_interrupt.store(true);
+}
+
+const char* EventName(ControlEvent::Type type)
+{
+    switch (type) {
+        case ControlEvent::ACCEPTED:
+            return "ACCEPTED";
+        case ControlEvent::REJECTED:
+            return "REJECTED";
+        case ControlEvent::MOTION_STARTED:
+            return "MOTION_STARTED";
+        case ControlEvent::MOTION_FINISHED:
+            return "MOTION_FINISHED";
+        case ControlEvent::BEAT:
+            return "BEAT";
+        case ControlEvent::VELOCITY_TIMEOUT:
+            return "VELOCITY_TIMEOUT";
+        case ControlEvent::QUEUE_EMPTY:
+            return "QUEUE_EMPTY";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+Motion PathToState(const std::string& target_state)
+{
+    Motion motion;
+    motion.set_motion_id("path_to_state");
+    auto* param = motion.add_parameters();
+    param->set_key("target_state");
+    param->set_string_value(target_state);
+    return motion;
+}
+
+// Steers a walking robot from a simulated perception loop: one ControlSession keeps
+// the gait running while velocity setpoints stream in at rate_hz.
+class ControlSessionDemo
+{
+public:
+    explicit ControlSessionDemo(const std::string& server_address)
+        : client_(server_address)
+    {
+    }
+
+    bool Run(double rate_hz, double duration_s)
+    {
+        std::cout << "Connected to server: " << client_.Address() << std::endl;
+        std::cout << "Example 8: Control Session Demo" << std::endl;
+        std::cout << "Walk and steer at " << rate_hz << " Hz for " << duration_s << " s, then stand down\n"
+                  << std::endl;
+
+        quad_sdk::ControlSession session(client_, [this](const ControlEvent& event) { OnEvent(event); });
+
+        MotionSequence sequence;
+        sequence.set_sequence_id("demo_control_session");
+        *sequence.add_motions() = PathToState("WALK");
+        // No velocity_sequence: the gait runs until the next motion is queued.
+        sequence.add_motions()->set_motion_id("walk");
+        if (session.Start(sequence) == 0) {
+            std::cout << "Failed to start the session" << std::endl;
+            return false;
+        }
+
+        std::cout << "Waiting for the gait... Press Ctrl+C to stop." << std::endl;
+        while (!walking_ && !g_interrupt && !ended_)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        // Perception loop: keep walking forward and weave as if tracking a target.
+        auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rate_hz));
+        auto start = std::chrono::steady_clock::now();
+        auto next = start;
+        while (walking_ && !g_interrupt) {
+            double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (t >= duration_s)
+                break;
+            float wz = static_cast<float>(0.5 * std::sin(2.0 * M_PI * t / 4.0));
+            {
+                // Held across Send so the ACCEPTED event cannot be looked up before it is recorded.
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto sent = std::chrono::steady_clock::now();
+                uint64_t id = session.SetVelocity(0.4f, 0.0f, wz, static_cast<float>(3.0 / rate_hz));
+                if (id == 0)
+                    break;
+                pending_[id] = sent;
+            }
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+
+        if (g_interrupt) {
+            std::cout << "\nKeyboardInterrupt detected, cancelling session..." << std::endl;
+            session.Cancel();
+        } else {
+            session.Append(PathToState("STAND_DOWN"));
+        }
+        grpc::Status status = session.Finish();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::cout << "\nSetpoints: " << ack_latency_.Count() << " accepted, " << rejected_ << " rejected" << std::endl;
+        if (ack_latency_.Count() > 0)
+            ack_latency_.Print(std::cout, "Setpoint -> ACCEPTED latency");
+        if (status.ok())
+            return rejected_ == 0;
+        if (status.error_code() == grpc::StatusCode::CANCELLED && g_interrupt)
+            return true;
+        std::cout << "Session failed: " << status.error_message() << std::endl;
+        return false;
+    }
+
+private:
+    // Runs on the session's reader thread.
+    void OnEvent(const ControlEvent& event)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(event.command_id());
+        if (it != pending_.end()) {
+            if (event.type() == ControlEvent::ACCEPTED)
+                ack_latency_.Add(
+                    std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - it->second).count());
+            else if (event.type() == ControlEvent::REJECTED)
+                rejected_++;
+            pending_.erase(it);
+            if (event.type() == ControlEvent::ACCEPTED)
+                return; // one per setpoint, too many to print
+        }
+        if (event.type() == ControlEvent::MOTION_STARTED)
+            walking_ = event.motion_id() == "walk";
+        else if (event.type() == ControlEvent::MOTION_FINISHED && event.motion_id() == "walk")
+            walking_ = false;
+        else if (event.type() == ControlEvent::QUEUE_EMPTY)
+            ended_ = true;
+
+        std::cout << "  [" << EventName(event.type()) << "] " << event.motion_id();
+        if (!event.message().empty())
+            std::cout << " - " << event.message();
+        std::cout << std::endl;
+    }
+
+    quad_sdk::RobotClient client_;
+    std::mutex mutex_;
+    std::map<uint64_t, std::chrono::steady_clock::time_point> pending_;
+    quad_sdk::LatencyStats ack_latency_;
+    uint64_t rejected_ = 0;
+    std::atomic<bool> walking_ {false};
+    std::atomic<bool> ended_ {false};
+};
+
+int main(int argc, char** argv)
+{
+    // Register Ctrl+C handler
+    std::signal(SIGINT, SignalHandler);
+
+    const std::string server_address = (argc > 1) ? argv[1] : "192.168.5.2:50051";
+    double rate_hz = (argc > 2) ? std::stod(argv[2]) : 20.0;
+    double duration_s = (argc > 3) ? std::stod(argv[3]) : 10.0;
+
+    ControlSessionDemo demo(server_address);
+    return demo.Run(rate_hz, duration_s) ? 0 : 1;
+}
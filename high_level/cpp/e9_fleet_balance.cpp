@@ -0,0 +1,148 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+#include "common/fleet_client.h"
+#include "common/motion_builders.h"
+
+using grpc_comm::ExecuteSequenceRequest;
+
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
+{
+    g_interrupt.store(true);
+}
+
+std::vector<std::string> SplitAddresses(const std::string& list)
+{
+    std::vector<std::string> addresses;
+    std::stringstream stream(list);
+    std::string address;
+    while (std::getline(stream, address, ','))
+        if (!address.empty())
+            addresses.push_back(address);
+    return addresses;
+}
+
+// Runs the E6 balance routine on several robots at the same bpm with a shared start
+// time, polling every robot's state while they move.
+class FleetBalanceClient
+{
+public:
+    explicit FleetBalanceClient(const std::vector<std::string>& addresses)
+        : addresses_(addresses)
+        , fleet_(addresses)
+    {
+    }
+
+    bool Run(double bpm, int lead_ms)
+    {
+        std::cout << "Example 9: Fleet Balance Motions Demo (" << fleet_.Size() << " robots)" << std::endl;
+        for (const auto& state : fleet_.GetRobotState()) {
+            if (!state.call->status().ok()) {
+                std::cout << "Robot unreachable: " << state.call->status().error_message() << std::endl;
+                return false;
+            }
+        }
+
+        ExecuteSequenceRequest request;
+        auto* sequence = request.mutable_sequence();
+        sequence->set_sequence_id("demo_fleet_balance");
+        sequence->set_sequence_name("Fleet Balance Motions Demo");
+        sequence->set_bpm(bpm);
+        sequence->set_loop(false);
+        using namespace quad_sdk::motions;
+        PathToState {"BALANCE_STAND"}.AppendTo(sequence);
+        BalancePitch {1.0f, 0.8f}.AppendTo(sequence);
+        BalancePitch {1.0f, -0.8f}.AppendTo(sequence);
+        BalanceYaw {1.0f, 0.8f}.AppendTo(sequence);
+        BalanceYaw {1.0f, -0.8f}.AppendTo(sequence);
+        BalanceRoll {1.0f, 0.8f}.AppendTo(sequence);
+        BalanceRoll {1.0f, -0.8f}.AppendTo(sequence);
+        BalanceHeight {2.0f, -0.8f}.AppendTo(sequence);
+        BalanceNeutral {1.0f, 0.0f}.AppendTo(sequence);
+        request.set_immediate_start(true);
+
+        int64_t start_us = 0;
+        auto calls = fleet_.ExecuteSequence(request, std::chrono::milliseconds(lead_ms), &start_us);
+        std::cout << "Sequence scheduled " << lead_ms << " ms ahead on all robots... Press Ctrl+C to stop."
+                  << std::endl;
+
+        // Collect state from the whole fleet at 10 Hz until every robot has finished.
+        bool cancelled = false;
+        auto all_done = [&calls] {
+            for (const auto& call : calls)
+                if (!call->Done())
+                    return false;
+            return true;
+        };
+        while (!all_done()) {
+            if (g_interrupt && !cancelled) {
+                std::cout << "\nKeyboardInterrupt detected, cancelling on all robots..." << std::endl;
+                fleet_.CancelAll();
+                cancelled = true;
+            }
+            fleet_.GetRobotState();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        bool ok = true;
+        std::cout << std::endl;
+        for (size_t i = 0; i < calls.size(); ++i) {
+            const auto& call = calls[i];
+            std::cout << "  [" << addresses_[i] << "] ";
+            if (!call->status().ok()) {
+                std::cout << "RPC failed: " << call->status().error_message() << std::endl;
+                ok = false;
+            } else if (!call->response().success()) {
+                std::cout << "Execution failed: " << call->response().message() << std::endl;
+                ok = false;
+            } else if (call->response().started_at_us() == 0) {
+                // Firmware without scheduled starts ignores start_time_us and leaves this unset.
+                std::cout << "completed, start time not reported" << std::endl;
+            } else {
+                std::cout << "completed, started " << std::fixed << std::setprecision(1)
+                          << (call->response().started_at_us() - start_us) / 1000.0 << " ms after the scheduled start"
+                          << std::endl;
+            }
+        }
+
+        quad_sdk::StartSkew skew = quad_sdk::MeasureStartSkew(calls, start_us);
+        if (skew.robots > 1)
+            std::cout << "\nStart skew across " << skew.robots << " robots: " << std::fixed << std::setprecision(1)
+                      << skew.skew_us / 1000.0 << " ms (latest start " << skew.max_late_us / 1000.0
+                      << " ms after schedule)" << std::endl;
+        std::cout << "\nGetRobotState latency per robot:" << std::endl;
+        for (size_t i = 0; i < fleet_.Size(); ++i)
+            fleet_.StateLatency(i).Print(std::cout, "  " + addresses_[i]);
+        return ok || cancelled;
+    }
+
+private:
+    std::vector<std::string> addresses_;
+    quad_sdk::FleetClient fleet_;
+};
+
+int main(int argc, char** argv)
+{
+    // Register Ctrl+C handler
+    std::signal(SIGINT, SignalHandler);
+
+    const std::vector<std::string> addresses = SplitAddresses((argc > 1) ? argv[1] : "192.168.5.2:50051");
+    double bpm = (argc > 2) ? std::stod(argv[2]) : 120.0;
+    int lead_ms = (argc > 3) ? std::stoi(argv[3]) : 500;
+    if (addresses.empty()) {
+        std::cout << "Usage: " << argv[0] << " [address1,address2,...] [bpm=120] [lead_ms=500]" << std::endl;
+        return 1;
+    }
+
+    FleetBalanceClient client(addresses);
+    return client.Run(bpm, lead_ms) ? 0 : 1;
+}
@@ -1,16 +1,14 @@
 #include <atomic>
-#include <chrono>
 #include <csignal>
 #include <iostream>
 #include <memory>
 #include <string>
-#include <thread>
 #include <grpcpp/grpcpp.h>
 #include "proto/grpc_service.grpc.pb.h"
+#include "common/robot_client.h"
 
 using grpc_comm::ExecuteSequenceRequest;
 using grpc_comm::ExecuteSequenceResponse;
-using grpc_comm::gRPCService;
 using grpc_comm::MotionSequence;
 
 std::atomic<bool> g_interrupt {false};
@@ -23,15 +21,13 @@ class KillRobotClient
 {
 public:
     explicit KillRobotClient(const std::string& server_address)
-        : server_address_(server_address)
+        : client_(server_address)
     {
-        auto channel = grpc::CreateChannel(server_address_, grpc::InsecureChannelCredentials());
-        stub_ = gRPCService::NewStub(channel);
     }
 
     bool Run()
     {
-        std::cout << "Connected to server: " << server_address_ << std::endl;
+        std::cout << "Connected to server: " << client_.Address() << std::endl;
         std::cout << "Executing KILL_ROBOT command..." << std::endl;
         std::cout << "WARNING: This will switch robot to PASSIVE, wait 5s, and KILL all controller processes!"
                   << std::endl;
@@ -48,31 +44,13 @@ public:
 
         request.set_immediate_start(true);
 
-        ExecuteSequenceResponse response;
-        grpc::ClientContext context;
-        grpc::Status status;
-        bool finished = false;
-        bool cancelled = false;
-
-        std::thread rpc_thread([&] {
-            status = stub_->ExecuteSequence(&context, request, &response);
-            finished = true;
-        });
-        rpc_thread.detach();
-
-        while (!finished) {
-            if (g_interrupt.exchange(false)) {
-                cancelled = true;
-                context.TryCancel();
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-        return response.success();
+        auto call = client_.ExecuteSequence(request);
+        call->WaitInterruptible(g_interrupt);
+        return call->response().success();
     }
 
 private:
-    std::unique_ptr<gRPCService::Stub> stub_;
-    std::string server_address_;
+    quad_sdk::RobotClient client_;
 };
 
 int main(int argc, char** argv)
@@ -0,0 +1,168 @@
+// Load generator for gRPCService: N concurrent clients, each with its own channel
+// (like N separate dashboards), issue unary RPCs in a closed loop or at a fixed rate.
+// Reports throughput, errors and latency percentiles per concurrency level.
+//
+// Usage: ./load_generator [server_address|inprocess] [rpc] [clients] [rate_hz] [duration_s]
+//   rpc       state (GetRobotState, default) | motions (GetAvailableMotions) | mixed (9:1)
+//   clients   one count or a comma-separated sweep, e.g. 1,4,16,64 (default 1,2,4,8,16)
+//   rate_hz   per-client request rate; 0 = back-to-back (default)
+//   "inprocess" starts a MockRobotServer on a free local port first.
+// Example: how many 10 Hz dashboards can poll one robot?
+//   ./load_generator 192.168.5.2:50051 state 1,8,32,128 10 10
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+#include "proto/grpc_service.grpc.pb.h"
+#include "common/latency_stats.h"
+#include "common/mock_robot.h"
+
+using grpc_comm::GetMotionsRequest;
+using grpc_comm::GetMotionsResponse;
+using grpc_comm::GetRobotStateRequest;
+using grpc_comm::GetRobotStateResponse;
+using grpc_comm::gRPCService;
+using quad_sdk::LatencyStats;
+
+struct ClientResult
+{
+    LatencyStats latency;
+    uint64_t calls = 0;
+    uint64_t errors = 0;
+};
+
+class LoadClient
+{
+public:
+    LoadClient(const std::string& server_address, const std::string& rpc)
+        : rpc_(rpc)
+    {
+        // A private subchannel pool gives every client its own TCP connection.
+        grpc::ChannelArguments args;
+        args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+        auto channel = grpc::CreateCustomChannel(server_address, grpc::InsecureChannelCredentials(), args);
+        stub_ = gRPCService::NewStub(channel);
+    }
+
+    void Run(std::chrono::steady_clock::time_point end, double rate_hz, ClientResult* result)
+    {
+        auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(rate_hz > 0.0 ? 1.0 / rate_hz : 0.0));
+        auto next = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; std::chrono::steady_clock::now() < end; ++i) {
+            if (rate_hz > 0.0) {
+                std::this_thread::sleep_until(next);
+                next += period;
+            }
+            grpc::ClientContext context;
+            context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+            bool motions = rpc_ == "motions" || (rpc_ == "mixed" && i % 10 == 9);
+
+            auto start = std::chrono::steady_clock::now();
+            grpc::Status status;
+            bool success;
+            if (motions) {
+                GetMotionsResponse response;
+                status = stub_->GetAvailableMotions(&context, GetMotionsRequest(), &response);
+                success = response.success();
+            } else {
+                GetRobotStateResponse response;
+                status = stub_->GetRobotState(&context, GetRobotStateRequest(), &response);
+                success = response.success();
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            result->calls++;
+            if (!status.ok() || !success)
+                result->errors++;
+            else
+                result->latency.Add(std::chrono::duration<double, std::micro>(elapsed).count());
+        }
+    }
+
+private:
+    std::string rpc_;
+    std::unique_ptr<gRPCService::Stub> stub_;
+};
+
+// Runs one concurrency level and prints a summary line.
+void RunLevel(const std::string& server_address, const std::string& rpc, int clients, double rate_hz,
+              double duration_s)
+{
+    std::vector<std::unique_ptr<LoadClient>> load_clients;
+    for (int i = 0; i < clients; ++i)
+        load_clients.emplace_back(new LoadClient(server_address, rpc));
+    std::vector<ClientResult> results(clients);
+
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                           std::chrono::duration<double>(duration_s));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < clients; ++i)
+        threads.emplace_back(&LoadClient::Run, load_clients[i].get(), end, rate_hz, &results[i]);
+    for (auto& t : threads)
+        t.join();
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ClientResult total;
+    for (const auto& r : results) {
+        total.latency.Merge(r.latency);
+        total.calls += r.calls;
+        total.errors += r.errors;
+    }
+    std::cout << std::fixed << std::setprecision(1) << std::setw(7) << clients << std::setw(10) << total.calls
+              << std::setw(10) << total.calls / wall_s << std::setw(10) << total.calls / wall_s / clients
+              << std::setw(8) << total.errors << std::setw(10) << total.latency.Percentile(50) << std::setw(10)
+              << total.latency.Percentile(90) << std::setw(10) << total.latency.Percentile(99) << std::setw(10)
+              << total.latency.Max() << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::string server_address = (argc > 1) ? argv[1] : "192.168.5.2:50051";
+    const std::string rpc = (argc > 2) ? argv[2] : "state";
+    const std::string sweep = (argc > 3) ? argv[3] : "1,2,4,8,16";
+    double rate_hz = (argc > 4) ? std::stod(argv[4]) : 0.0;
+    double duration_s = (argc > 5) ? std::stod(argv[5]) : 5.0;
+
+    if (rpc != "state" && rpc != "motions" && rpc != "mixed") {
+        std::cout << "Unknown rpc '" << rpc << "', expected state, motions or mixed" << std::endl;
+        return 1;
+    }
+    std::vector<int> levels;
+    std::stringstream ss(sweep);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int n = std::stoi(item);
+        if (n < 1) {
+            std::cout << "Client counts must be >= 1" << std::endl;
+            return 1;
+        }
+        levels.push_back(n);
+    }
+
+    std::unique_ptr<quad_sdk::MockRobotServer> mock;
+    if (server_address == "inprocess") {
+        mock.reset(new quad_sdk::MockRobotServer());
+        if (!mock->Start("127.0.0.1:0"))
+            return 1;
+        server_address = mock->Address();
+    }
+
+    std::cout << "Target: " << server_address << ", rpc=" << rpc << ", ";
+    if (rate_hz > 0.0)
+        std::cout << rate_hz << " Hz per client, ";
+    else
+        std::cout << "closed loop, ";
+    std::cout << duration_s << " s per level\n" << std::endl;
+    std::cout << "clients     calls     rps  rps/clnt  errors   p50(us)   p90(us)   p99(us)   max(us)" << std::endl;
+    for (int clients : levels)
+        RunLevel(server_address, rpc, clients, rate_hz, duration_s);
+    return 0;
+}
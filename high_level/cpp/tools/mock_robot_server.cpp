@@ -0,0 +1,53 @@
+// Standalone mock robot: serves gRPCService on a local port so the examples and load
+// tests run without hardware, e.g.
+//   ./mock_robot_server 127.0.0.1:50051 &
+//   ./e6_balance_motions 127.0.0.1:50051 120
+//
+// Usage: ./mock_robot_server [address=0.0.0.0:50051] [time_scale=1.0] [count=1]
+//   count > 1 starts that many robots on consecutive ports (fleet testing).
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/mock_robot.h"
+
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
+{
+    g_interrupt.store(true);
+}
+
+int main(int argc, char** argv)
+{
+    std::signal(SIGINT, SignalHandler);
+
+    const std::string address = (argc > 1) ? argv[1] : "0.0.0.0:50051";
+    double time_scale = (argc > 2) ? std::stod(argv[2]) : 1.0;
+    int count = (argc > 3) ? std::stoi(argv[3]) : 1;
+
+    std::string host = address.substr(0, address.rfind(':') + 1);
+    int port = std::stoi(address.substr(address.rfind(':') + 1));
+
+    std::vector<std::unique_ptr<quad_sdk::MockRobotServer>> servers;
+    for (int i = 0; i < count; ++i) {
+        std::unique_ptr<quad_sdk::MockRobotServer> server(new quad_sdk::MockRobotServer(time_scale));
+        if (!server->Start(host + std::to_string(port == 0 ? 0 : port + i)))
+            return 1;
+        std::cout << "Mock robot listening on " << server->Address() << std::endl;
+        servers.push_back(std::move(server));
+    }
+    std::cout << "time_scale=" << time_scale << ", press Ctrl+C to stop." << std::endl;
+
+    while (!g_interrupt)
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    for (auto& server : servers) {
+        std::cout << server->Address() << ": " << server->Service().CallCount() << " calls served" << std::endl;
+        server->Shutdown();
+    }
+    return 0;
+}
@@ -0,0 +1,245 @@
+// Generates typed motion builders from the robot's motion catalogue, so parameter keys
+// and types are checked by the compiler instead of by the robot at runtime:
+//
+//   ./motion_codegen 192.168.5.2:50051 ../common/motion_builders.h
+//   ./motion_codegen motions.cache     ../common/motion_builders.h   # saved by e1 / MotionCatalogue
+//
+// Every motion becomes an aggregate named after its motion_id (balance_pitch ->
+// BalancePitch) with one member per parameter, initialized to the catalogue default:
+//
+//   quad_sdk::motions::BalancePitch{1.0f, 0.8f}.AppendTo(&sequence);   // beats, amplitude
+//
+// Members take the type of the catalogue default. Robot firmware reports
+// velocity_sequence as a string, so its builders get a std::string member (see
+// VelocitySequenceBuilder::ToText()) plus an opt-in <member>_segments member: when
+// non-empty it is sent as velocity_segments instead, which needs robot support.
+//
+// Usage: ./motion_codegen <server_address | catalogue file> [output=motion_builders.h]
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include "common/motion_catalogue.h"
+#include "common/robot_client.h"
+
+namespace {
+
+const char kVelocitySequenceKey[] = "velocity_sequence";
+
+// balance_pitch -> BalancePitch
+std::string TypeName(const std::string& motion_id)
+{
+    std::string name;
+    bool upper = true;
+    for (char c : motion_id) {
+        if (!std::isalnum(static_cast<unsigned char>(c))) {
+            upper = true;
+            continue;
+        }
+        name += upper ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+        upper = false;
+    }
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])))
+        name = "Motion" + name;
+    return name;
+}
+
+std::string MemberName(const std::string& key)
+{
+    static const std::set<std::string> kReserved = {"auto",   "bool",   "char",  "class",  "default", "delete",
+                                                    "double", "float",  "int",   "new",    "operator", "private",
+                                                    "public", "return", "short", "signed", "static",  "struct",
+                                                    "switch", "this",   "union", "unsigned", "void"};
+    std::string name;
+    for (char c : key) {
+        unsigned char u = static_cast<unsigned char>(c);
+        name += std::isalnum(u) ? static_cast<char>(std::tolower(u)) : '_';
+    }
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])))
+        name = "p_" + name;
+    if (kReserved.count(name))
+        name += '_';
+    return name;
+}
+
+std::string StringLiteral(const std::string& value)
+{
+    std::string out = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (std::isprint(static_cast<unsigned char>(c))) {
+            out += c;
+        } else {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\%03o", static_cast<unsigned char>(c));
+            out += escaped;
+        }
+    }
+    return out + "\"";
+}
+
+std::string FloatLiteral(float value)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    std::string literal = buffer;
+    if (literal.find_first_of(".e") == std::string::npos)
+        literal += ".0";
+    return literal + "f";
+}
+
+bool IsVelocitySequence(const grpc_comm::Parameter& param)
+{
+    return param.key() == kVelocitySequenceKey && param.value_case() == grpc_comm::Parameter::kStringValue;
+}
+
+// Writes one builder struct; parameters without a default value are skipped.
+void WriteMotion(std::ostream& out, const grpc_comm::Motion& motion, const std::string& description)
+{
+    const std::string type = TypeName(motion.motion_id());
+    if (!description.empty())
+        out << "// " << description << "\n";
+    out << "struct " << type << "\n{\n";
+    out << "    static constexpr const char* MotionId() { return " << StringLiteral(motion.motion_id()) << "; }\n\n";
+
+    // Members first, in catalogue order, so aggregate initialization follows it; the
+    // opt-in typed members come after them.
+    std::ostringstream typed;
+    std::ostringstream write;
+    int params = 0;
+    for (const auto& param : motion.parameters()) {
+        const std::string member = MemberName(param.key());
+        const std::string key = StringLiteral(param.key());
+        if (IsVelocitySequence(param)) {
+            const std::string segments = member + "_segments";
+            out << "    std::string " << member << " = " << StringLiteral(param.string_value()) << ";\n";
+            typed << "    // Sent as velocity_segments instead of " << member << " when non-empty; robot\n"
+                  << "    // firmware must support that field.\n"
+                  << "    grpc_comm::VelocitySegments " << segments << ";\n";
+            write << "        {\n"
+                  << "            auto* param = parameters->Add();\n"
+                  << "            param->set_key(" << key << ");\n"
+                  << "            if (" << segments << ".segments_size() > 0)\n"
+                  << "                *param->mutable_velocity_segments() = " << segments << ";\n"
+                  << "            else\n"
+                  << "                param->set_string_value(" << member << ");\n"
+                  << "        }\n";
+            params++;
+            continue;
+        }
+        std::string setter;
+        switch (param.value_case()) {
+            case grpc_comm::Parameter::kFloatValue:
+                out << "    float " << member << " = " << FloatLiteral(param.float_value()) << ";\n";
+                setter = "set_float_value";
+                break;
+            case grpc_comm::Parameter::kIntValue:
+                out << "    int32_t " << member << " = " << param.int_value() << ";\n";
+                setter = "set_int_value";
+                break;
+            case grpc_comm::Parameter::kStringValue:
+                out << "    std::string " << member << " = " << StringLiteral(param.string_value()) << ";\n";
+                setter = "set_string_value";
+                break;
+            case grpc_comm::Parameter::kBoolValue:
+                out << "    bool " << member << " = " << (param.bool_value() ? "true" : "false") << ";\n";
+                setter = "set_bool_value";
+                break;
+            case grpc_comm::Parameter::kVelocitySegments:
+                out << "    grpc_comm::VelocitySegments " << member << ";\n";
+                write << "        {\n"
+                      << "            auto* param = parameters->Add();\n"
+                      << "            param->set_key(" << key << ");\n"
+                      << "            *param->mutable_velocity_segments() = " << member << ";\n"
+                      << "        }\n";
+                params++;
+                continue;
+            default:
+                std::cerr << "Skipping " << motion.motion_id() << "." << param.key() << ": no default value"
+                          << std::endl;
+                continue;
+        }
+        write << "        {\n"
+              << "            auto* param = parameters->Add();\n"
+              << "            param->set_key(" << key << ");\n"
+              << "            param->" << setter << "(" << member << ");\n"
+              << "        }\n";
+        params++;
+    }
+    out << typed.str();
+    if (params > 0)
+        out << "\n";
+
+    out << "    // Overwrites `motion`; a motion taken from a cleared sequence keeps its allocations.\n";
+    out << "    void WriteTo(grpc_comm::Motion* motion) const\n    {\n";
+    out << "        motion->set_motion_id(MotionId());\n";
+    if (params > 0) {
+        out << "        auto* parameters = motion->mutable_parameters();\n";
+        out << "        parameters->Clear();\n";
+        out << write.str();
+    } else {
+        out << "        motion->clear_parameters();\n";
+    }
+    out << "    }\n\n";
+    out << "    void AppendTo(grpc_comm::MotionSequence* sequence) const { WriteTo(sequence->add_motions()); }\n";
+    out << "};\n\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <server_address | catalogue file> [output=motion_builders.h]"
+                  << std::endl;
+        return 1;
+    }
+    const std::string source = argv[1];
+    const std::string output = (argc > 2) ? argv[2] : "motion_builders.h";
+
+    quad_sdk::MotionCatalogue catalogue;
+    std::string error;
+    if (!std::ifstream(source).good()) {
+        quad_sdk::RobotClient client(source);
+        grpc::Status status = catalogue.Refresh(client);
+        if (!status.ok()) {
+            std::cerr << "Failed to fetch the catalogue from " << source << ": " << status.error_message()
+                      << std::endl;
+            return 1;
+        }
+    } else if (!catalogue.Load(source, &error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    auto motions = catalogue.Current();
+
+    std::ostringstream out;
+    out << "// Generated by motion_codegen from " << source << ", motion catalogue version "
+        << (motions->Version().empty() ? "(unversioned)" : motions->Version()) << ".\n"
+        << "// Do not edit; regenerate against the robot when its motion library changes.\n"
+        << "#pragma once\n\n"
+        << "#include <cstdint>\n"
+        << "#include <string>\n"
+        << "#include \"proto/grpc_service.pb.h\"\n\n"
+        << "namespace quad_sdk {\nnamespace motions {\n\n"
+        << "// Compare with MotionCatalogueSnapshot::Version() to detect a robot whose catalogue\n"
+        << "// differs from the one these builders were generated from.\n"
+        << "constexpr const char kCatalogueVersion[] = " << StringLiteral(motions->Version()) << ";\n\n";
+    for (const auto& motion : motions->Response().motions())
+        WriteMotion(out, motion, motions->Description(motion.motion_id()));
+    out << "} // namespace motions\n} // namespace quad_sdk\n";
+
+    std::ofstream file(output, std::ios::trunc);
+    file << out.str();
+    if (!file.flush()) {
+        std::cerr << "Cannot write " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << motions->Size() << " motion builders to " << output << std::endl;
+    return 0;
+}
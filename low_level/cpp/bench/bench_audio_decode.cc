@@ -0,0 +1,138 @@
+// Benchmark: AudioFileReader (common/audio_file.hpp) decode + downmix + resample to
+// 24 kHz mono S16, against real time.
+//
+// Each file is read in chunk_ms blocks, the way e7_voice_pub streaming pulls it, as
+// fast as possible. Reported per file: source format, time to open and produce the
+// first chunk (start-up delay of a stream), the slowest single chunk (must stay far
+// below chunk_ms for paced publishing to keep up), total wall time and the speed as a
+// multiple of real time.
+//
+// Without file arguments three synthetic 60 s WAV files are written to /tmp and used:
+// 24 kHz mono S16 (pass-through), 44.1 kHz stereo S16 and 48 kHz mono float. Pass
+// FLAC/MP3 files (e.g. ../../../assets/*) to include the libsndfile decoders.
+//
+// Usage: ./bench_audio_decode [chunk_ms=100] [file...]
+#include "common/audio_file.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using quad_sdk::AudioFileReader;
+
+typedef std::chrono::steady_clock Clock;
+
+static double ms_since(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void put_u32(FILE* f, uint32_t v) { fwrite(&v, 4, 1, f); }
+static void put_u16(FILE* f, uint16_t v) { fwrite(&v, 2, 1, f); }
+
+// A speech-band test signal: two tones per channel, 60 s.
+static bool write_test_wav(const std::string& path, uint32_t rate, uint16_t channels, bool float_samples)
+{
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    const uint32_t frames = rate * 60;
+    const uint16_t bits = float_samples ? 32 : 16;
+    const uint32_t data_bytes = frames * channels * bits / 8;
+    fwrite("RIFF", 1, 4, f);
+    put_u32(f, 36 + data_bytes);
+    fwrite("WAVEfmt ", 1, 8, f);
+    put_u32(f, 16);
+    put_u16(f, float_samples ? 3 : 1);
+    put_u16(f, channels);
+    put_u32(f, rate);
+    put_u32(f, rate * channels * bits / 8);
+    put_u16(f, static_cast<uint16_t>(channels * bits / 8));
+    put_u16(f, bits);
+    fwrite("data", 1, 4, f);
+    put_u32(f, data_bytes);
+    std::vector<uint8_t> frame(channels * bits / 8);
+    for (uint32_t i = 0; i < frames; ++i) {
+        double t = static_cast<double>(i) / rate;
+        for (uint16_t c = 0; c < channels; ++c) {
+            double v = 0.25 * std::sin(2 * M_PI * (220.0 + 110.0 * c) * t) + 0.1 * std::sin(2 * M_PI * 3100.0 * t);
+            if (float_samples) {
+                float s = static_cast<float>(v);
+                std::memcpy(&frame[c * 4], &s, 4);
+            } else {
+                int16_t s = static_cast<int16_t>(std::lrint(v * 32767));
+                std::memcpy(&frame[c * 2], &s, 2);
+            }
+        }
+        fwrite(frame.data(), 1, frame.size(), f);
+    }
+    return fclose(f) == 0;
+}
+
+int main(int argc, char** argv)
+{
+    int chunk_ms = (argc > 1) ? std::atoi(argv[1]) : 100;
+    if (chunk_ms < 1 || chunk_ms > 1000) {
+        std::cerr << "Usage: " << argv[0] << " [chunk_ms=100] [file...]" << std::endl;
+        return 1;
+    }
+    std::vector<std::string> files(argv + (argc > 2 ? 2 : argc), argv + argc);
+    if (files.empty()) {
+        const struct
+        {
+            const char* path;
+            uint32_t rate;
+            uint16_t channels;
+            bool float_samples;
+        } synthetic[] = {{"/tmp/bench_audio_24k_mono.wav", 24000, 1, false},
+                         {"/tmp/bench_audio_44k_stereo.wav", 44100, 2, false},
+                         {"/tmp/bench_audio_48k_float.wav", 48000, 1, true}};
+        for (const auto& s : synthetic) {
+            if (!write_test_wav(s.path, s.rate, s.channels, s.float_samples)) {
+                std::cerr << "Failed to write " << s.path << std::endl;
+                return 1;
+            }
+            files.push_back(s.path);
+        }
+    }
+
+    const size_t chunk_samples = static_cast<size_t>(quad_sdk::kVoiceFileSampleRate) * chunk_ms / 1000;
+    std::vector<int16_t> chunk(chunk_samples);
+    std::cout << chunk_ms << " ms chunks of 24 kHz mono S16\n" << std::endl;
+    std::cout << std::left << std::setw(36) << "file" << std::setw(22) << "source" << std::right << std::setw(10)
+              << "audio s" << std::setw(14) << "first ms" << std::setw(14) << "max chunk ms" << std::setw(12)
+              << "total ms" << std::setw(12) << "x realtime" << std::endl;
+    for (const std::string& path : files) {
+        Clock::time_point start = Clock::now();
+        AudioFileReader reader;
+        if (!reader.open(path))
+            continue;
+        size_t samples = reader.read(chunk.data(), chunk.size());
+        double first_ms = ms_since(start);
+        double max_chunk_ms = 0.0;
+        for (;;) {
+            Clock::time_point t = Clock::now();
+            size_t n = reader.read(chunk.data(), chunk.size());
+            max_chunk_ms = std::max(max_chunk_ms, ms_since(t));
+            if (n == 0)
+                break;
+            samples += n;
+        }
+        double total_ms = ms_since(start);
+        double audio_s = static_cast<double>(samples) / quad_sdk::kVoiceFileSampleRate;
+
+        std::string name = path.size() > 34 ? "..." + path.substr(path.size() - 31) : path;
+        std::string source = std::string(reader.decoder().format_name()) + " "
+            + std::to_string(reader.decoder().sample_rate()) + " Hz " + std::to_string(reader.decoder().channels())
+            + "ch";
+        std::cout << std::left << std::setw(36) << name << std::setw(22) << source << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(10) << audio_s << std::setprecision(3) << std::setw(14)
+                  << first_ms << std::setw(14) << max_chunk_ms << std::setprecision(1) << std::setw(12) << total_ms
+                  << std::setprecision(0) << std::setw(12) << audio_s * 1000.0 / total_ms << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,266 @@
+// Benchmark: camera-sized Image_ / CompressedImage_ throughput between two processes on
+// one host. The transport is whatever CYCLONEDDS_URI selects, so run it once per config:
+//
+//   CYCLONEDDS_URI=file://<repo>/cyclonedds_local.xml ./bench_image_transport depth
+//   iox-roudi -c <repo>/iceoryx_roudi.toml &
+//   CYCLONEDDS_URI=file://<repo>/cyclonedds_shm.xml   ./bench_image_transport depth
+//
+// The process forks: the child publishes frames (through publish_loaned, so a loan is
+// used whenever the type allows it) and the parent takes them in place. Publisher and
+// subscriber must be separate processes, since Cyclone delivers in-process samples
+// without touching any transport. Reported: delivered frames/s and MB/s, publish ->
+// take latency, lost frames, and CPU time of each side as a share of one core.
+//
+// Usage: ./bench_image_transport [depth|rgb] [payload_kib] [rate_hz] [duration_s]
+//   defaults: depth 600 (640x480 16UC1) 30 10; rgb defaults to 150 KiB; rate_hz 0 = unpaced
+#include "sensor_msgs/msg/CompressedImage_.hpp"
+#include "sensor_msgs/msg/Image_.hpp"
+#include "common/dds_loan.hpp"
+#include "common/latency_histogram.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using quad_sdk::LatencyHistogram;
+
+const char* const kTopic = "rt/bench/image";
+const int kHistoryDepth = 4;
+
+static int64_t monotonic_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+static double cpu_seconds(int who)
+{
+    rusage usage;
+    getrusage(who, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+struct BenchConfig
+{
+    bool depth;
+    size_t payload_bytes;
+    double rate_hz;
+    double duration_s;
+};
+
+// CLOCK_MONOTONIC is system-wide, so the send time stamped into the header is
+// comparable in the receiving process.
+static void set_stamp(std_msgs::msg::dds_::Header_& header, int64_t t_ns)
+{
+    header.stamp_().sec_(static_cast<int32_t>(t_ns / 1000000000LL));
+    header.stamp_().nanosec_(static_cast<uint32_t>(t_ns % 1000000000LL));
+}
+
+static int64_t get_stamp(const std_msgs::msg::dds_::Header_& header)
+{
+    return static_cast<int64_t>(header.stamp_().sec_()) * 1000000000LL + header.stamp_().nanosec_();
+}
+
+// Fill a message's payload from a prepared pattern and store the sequence number in
+// the first 8 bytes, so the receiver can count lost frames.
+template <typename Msg>
+static void fill_payload(Msg& msg, const std::vector<uint8_t>& pattern, uint64_t seq)
+{
+    msg.data_().resize(pattern.size());
+    std::memcpy(msg.data_().data(), pattern.data(), pattern.size());
+    std::memcpy(msg.data_().data(), &seq, sizeof(seq));
+    set_stamp(msg.header_(), monotonic_ns());
+}
+
+template <typename Msg>
+static uint64_t read_seq(const Msg& msg)
+{
+    uint64_t seq = 0;
+    if (msg.data_().size() >= sizeof(seq))
+        std::memcpy(&seq, msg.data_().data(), sizeof(seq));
+    return seq;
+}
+
+static dds::pub::qos::DataWriterQos writer_qos(const dds::pub::Publisher& publisher)
+{
+    // Shared memory needs KEEP_LAST + VOLATILE; the UDP run uses the same QoS.
+    return publisher.default_datawriter_qos() << dds::core::policy::Reliability::Reliable()
+                                              << dds::core::policy::History::KeepLast(kHistoryDepth)
+                                              << dds::core::policy::Durability::Volatile();
+}
+
+static dds::sub::qos::DataReaderQos reader_qos(const dds::sub::Subscriber& subscriber)
+{
+    return subscriber.default_datareader_qos() << dds::core::policy::Reliability::Reliable()
+                                               << dds::core::policy::History::KeepLast(kHistoryDepth)
+                                               << dds::core::policy::Durability::Volatile();
+}
+
+template <typename Msg>
+static void prepare(Msg& msg, const BenchConfig& config);
+
+template <>
+void prepare(sensor_msgs::msg::dds_::Image_& msg, const BenchConfig& config)
+{
+    msg.width_(640);
+    msg.height_(static_cast<uint32_t>(config.payload_bytes / (640 * 2)));
+    msg.step_(640 * 2);
+    msg.encoding_("16UC1");
+    msg.is_bigendian_(0);
+}
+
+template <>
+void prepare(sensor_msgs::msg::dds_::CompressedImage_& msg, const BenchConfig&)
+{
+    msg.format_("jpeg");
+}
+
+template <typename Msg>
+static int run_publisher(const BenchConfig& config)
+{
+    dds::domain::DomainParticipant participant(dds::domain::default_id());
+    dds::topic::Topic<Msg> topic(participant, kTopic);
+    dds::pub::Publisher publisher(participant);
+    dds::pub::DataWriter<Msg> writer(publisher, topic, writer_qos(publisher));
+
+    int64_t match_deadline = monotonic_ns() + 5000000000LL;
+    while (writer.publication_matched_status().current_count() == 0) {
+        if (monotonic_ns() > match_deadline) {
+            std::cerr << "Publisher: no subscriber matched within 5 s" << std::endl;
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::vector<uint8_t> pattern(config.payload_bytes);
+    for (size_t i = 0; i < pattern.size(); ++i)
+        pattern[i] = static_cast<uint8_t>(i * 31);
+    Msg scratch;
+    prepare(scratch, config);
+
+    double cpu_start = cpu_seconds(RUSAGE_SELF);
+    int64_t start = monotonic_ns();
+    int64_t end = start + static_cast<int64_t>(config.duration_s * 1e9);
+    int64_t period = config.rate_hz > 0.0 ? static_cast<int64_t>(1e9 / config.rate_hz) : 0;
+    uint64_t seq = 0, loaned = 0;
+    for (int64_t deadline = start; deadline < end; deadline += period) {
+        if (period) {
+            timespec ts;
+            ts.tv_sec = deadline / 1000000000LL;
+            ts.tv_nsec = deadline % 1000000000LL;
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+        } else if (monotonic_ns() >= end) {
+            break;
+        }
+        bool loan = quad_sdk::publish_loaned(writer, scratch, [&](Msg& msg) {
+            prepare(msg, config);
+            fill_payload(msg, pattern, seq);
+        });
+        loaned += loan ? 1 : 0;
+        seq++;
+    }
+    double wall_s = (monotonic_ns() - start) / 1e9;
+    double cpu_s = cpu_seconds(RUSAGE_SELF) - cpu_start;
+    std::cout << "publisher: sent=" << seq << " loaned=" << loaned << " cpu=" << 100.0 * cpu_s / wall_s << "%"
+              << std::endl;
+
+    // Give reliable delivery time to drain before the writer goes away.
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    return 0;
+}
+
+template <typename Msg>
+static int run_subscriber(const BenchConfig& config, pid_t child)
+{
+    dds::domain::DomainParticipant participant(dds::domain::default_id());
+    dds::topic::Topic<Msg> topic(participant, kTopic);
+    dds::sub::Subscriber subscriber(participant);
+    dds::sub::DataReader<Msg> reader(subscriber, topic, reader_qos(subscriber));
+    dds::sub::cond::ReadCondition readable(reader, dds::sub::status::DataState::any());
+    dds::core::cond::WaitSet waitset;
+    waitset += readable;
+
+    LatencyHistogram latency;
+    uint64_t received = 0, bytes = 0, max_seq = 0;
+    int64_t first_ns = 0, last_ns = 0;
+    double cpu_start = cpu_seconds(RUSAGE_SELF);
+    int status = 0;
+    bool child_done = false;
+    while (true) {
+        try {
+            waitset.wait(dds::core::Duration::from_millisecs(100));
+        } catch (const dds::core::TimeoutError&) {
+            // Fall through: check whether the publisher has finished.
+        }
+        quad_sdk::take_in_place(reader, [&](const Msg& msg) {
+            int64_t now = monotonic_ns();
+            latency.record_signed(now - get_stamp(msg.header_()));
+            max_seq = std::max(max_seq, read_seq(msg));
+            bytes += msg.data_().size();
+            if (received++ == 0)
+                first_ns = now;
+            last_ns = now;
+        });
+        if (child_done)
+            break;
+        // One more take after the publisher exits picks up anything still in flight.
+        child_done = waitpid(child, &status, WNOHANG) == child;
+    }
+    double cpu_s = cpu_seconds(RUSAGE_SELF) - cpu_start;
+
+    const char* uri = std::getenv("CYCLONEDDS_URI");
+    double span_s = received > 1 ? (last_ns - first_ns) / 1e9 : 0.0;
+    std::cout << "transport: " << (uri ? uri : "(default CycloneDDS config)") << std::endl;
+    std::cout << (config.depth ? "Image_" : "CompressedImage_") << " " << config.payload_bytes / 1024
+              << " KiB: received=" << received << " lost=" << (received ? max_seq + 1 - received : 0);
+    if (span_s > 0.0)
+        std::cout << " rate=" << received / span_s << " frames/s throughput=" << bytes / span_s / 1e6 << " MB/s";
+    std::cout << " subscriber cpu=" << (span_s > 0.0 ? 100.0 * cpu_s / span_s : 0.0) << "%" << std::endl;
+    latency.print(std::cout, "publish -> take");
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig config;
+    config.depth = !(argc > 1 && std::string(argv[1]) == "rgb");
+    int payload_kib = (argc > 2) ? std::atoi(argv[2]) : (config.depth ? 600 : 150);
+    config.rate_hz = (argc > 3) ? std::atof(argv[3]) : 30.0;
+    config.duration_s = (argc > 4) ? std::atof(argv[4]) : 10.0;
+    if (payload_kib < 1 || config.rate_hz < 0.0 || config.duration_s <= 0.0) {
+        std::cerr << "Usage: " << argv[0] << " [depth|rgb] [payload_kib] [rate_hz] [duration_s]" << std::endl;
+        return 1;
+    }
+    config.payload_bytes = static_cast<size_t>(payload_kib) * 1024;
+    if (config.depth) // whole 640-pixel 16-bit rows
+        config.payload_bytes = std::max<size_t>(1, config.payload_bytes / (640 * 2)) * 640 * 2;
+
+    // Fork before either side touches DDS: a forked child must not inherit a live domain.
+    pid_t child = fork();
+    if (child < 0) {
+        std::cerr << "fork failed: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    try {
+        if (child == 0)
+            _exit(config.depth ? run_publisher<sensor_msgs::msg::dds_::Image_>(config)
+                               : run_publisher<sensor_msgs::msg::dds_::CompressedImage_>(config));
+        return config.depth ? run_subscriber<sensor_msgs::msg::dds_::Image_>(config, child)
+                            : run_subscriber<sensor_msgs::msg::dds_::CompressedImage_>(config, child);
+    } catch (const dds::core::Exception& e) {
+        std::cerr << "DDS error: " << e.what() << std::endl;
+        if (child == 0)
+            _exit(1);
+        return 1;
+    }
+}
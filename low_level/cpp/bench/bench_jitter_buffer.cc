@@ -0,0 +1,135 @@
+// Benchmark: JitterBuffer (common/jitter_buffer.hpp) on a simulated Wi-Fi audio link.
+//
+// A sender emits chunk_ms packets of 24 kHz audio in real time. Each packet gets a
+// network delay of 2 ms plus an exponential jitter with mean jitter_ms, is lost with
+// probability loss_pct, and every 10 s the link stalls for stall_ms: packets sent
+// during a stall are held and then arrive together. Independent delays also reorder
+// packets. The receiver plays 10 ms periods. Everything runs in simulated time, so the
+// same seed gives the same result and a 2-minute run takes milliseconds.
+//
+// Fixed target delays are compared with the adaptive one. Reported per configuration:
+// underruns, lost/late packets, concealed audio, audio skipped to shrink the buffer and
+// the arrival -> playout delay.
+//
+// Usage: ./bench_jitter_buffer [chunk_ms=100] [jitter_ms=15] [loss_pct=1] [stall_ms=300]
+//                             [duration_s=120]
+#include "common/jitter_buffer.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using quad_sdk::JitterBuffer;
+using quad_sdk::JitterBufferConfig;
+using quad_sdk::JitterBufferStats;
+
+const int kSampleRate = 24000;
+const int64_t kPeriodNs = 10000000; // playback period
+
+struct Packet
+{
+    uint64_t seq;
+    int64_t arrival_ns;
+};
+
+struct LinkConfig
+{
+    int chunk_ms;
+    double jitter_ms;
+    double loss_pct;
+    int stall_ms;
+    double duration_s;
+};
+
+static std::vector<Packet> simulate_link(const LinkConfig& link)
+{
+    std::mt19937 rng(42);
+    std::exponential_distribution<double> jitter(1.0 / std::max(link.jitter_ms, 1e-3));
+    std::uniform_real_distribution<double> uniform(0.0, 100.0);
+    const int64_t chunk_ns = static_cast<int64_t>(link.chunk_ms) * 1000000LL;
+    const int64_t stall_every_ns = 10000000000LL;
+    std::vector<Packet> packets;
+    for (uint64_t seq = 0; static_cast<double>(seq * chunk_ns) < link.duration_s * 1e9; ++seq) {
+        // Sent once the whole chunk has been captured.
+        int64_t sent = static_cast<int64_t>(seq + 1) * chunk_ns;
+        if (uniform(rng) < link.loss_pct)
+            continue;
+        int64_t arrival = sent + 2000000 + static_cast<int64_t>(jitter(rng) * 1e6);
+        int64_t stall_start = (sent / stall_every_ns) * stall_every_ns + stall_every_ns / 2;
+        int64_t stall_end = stall_start + static_cast<int64_t>(link.stall_ms) * 1000000LL;
+        if (sent >= stall_start && sent < stall_end)
+            arrival = std::max(arrival, stall_end);
+        packets.push_back({seq, arrival});
+    }
+    std::stable_sort(packets.begin(), packets.end(),
+                     [](const Packet& a, const Packet& b) { return a.arrival_ns < b.arrival_ns; });
+    return packets;
+}
+
+static JitterBufferStats run(const LinkConfig& link, const std::vector<Packet>& packets,
+                             const JitterBufferConfig& config)
+{
+    JitterBuffer buffer(config);
+    const size_t chunk_samples = static_cast<size_t>(kSampleRate) * link.chunk_ms / 1000;
+    const size_t period_samples = static_cast<size_t>(kSampleRate) * kPeriodNs / 1000000000LL;
+    std::vector<int16_t> chunk(chunk_samples, 1000);
+    std::vector<int16_t> out(period_samples);
+    size_t next = 0;
+    int64_t end = packets.empty() ? 0 : packets.back().arrival_ns;
+    for (int64_t now = 0; now < end; now += kPeriodNs) {
+        for (; next < packets.size() && packets[next].arrival_ns <= now; ++next)
+            buffer.push(packets[next].seq, chunk.data(), chunk.size(), packets[next].arrival_ns);
+        buffer.read(out.data(), out.size(), now);
+    }
+    return buffer.stats();
+}
+
+int main(int argc, char** argv)
+{
+    LinkConfig link;
+    link.chunk_ms = (argc > 1) ? std::atoi(argv[1]) : 100;
+    link.jitter_ms = (argc > 2) ? std::atof(argv[2]) : 15.0;
+    link.loss_pct = (argc > 3) ? std::atof(argv[3]) : 1.0;
+    link.stall_ms = (argc > 4) ? std::atoi(argv[4]) : 300;
+    link.duration_s = (argc > 5) ? std::atof(argv[5]) : 120.0;
+    if (link.chunk_ms < 5 || link.chunk_ms > 400 || link.jitter_ms < 0.0 || link.loss_pct < 0.0
+        || link.stall_ms < 0 || link.duration_s <= 0.0) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [chunk_ms=100] [jitter_ms=15] [loss_pct=1] [stall_ms=300] [duration_s=120]" << std::endl;
+        return 1;
+    }
+    std::vector<Packet> packets = simulate_link(link);
+
+    std::cout << link.chunk_ms << " ms packets, " << link.jitter_ms << " ms mean jitter, " << link.loss_pct
+              << "% loss, " << link.stall_ms << " ms stall every 10 s, " << link.duration_s << " s\n"
+              << std::endl;
+    std::cout << std::left << std::setw(16) << "target" << std::right << std::setw(10) << "underruns"
+              << std::setw(8) << "lost" << std::setw(8) << "late" << std::setw(14) << "concealed ms"
+              << std::setw(12) << "skipped ms" << std::setw(12) << "mean ms" << std::setw(10) << "p99 ms"
+              << std::endl;
+
+    struct Row
+    {
+        std::string name;
+        bool adaptive;
+        int delay_ms;
+    };
+    const Row rows[] = {{"fixed 40 ms", false, 40},
+                        {"fixed 120 ms", false, 120},
+                        {"fixed 350 ms", false, 350},
+                        {"adaptive", true, 120}};
+    for (const Row& row : rows) {
+        JitterBufferConfig config;
+        config.adaptive = row.adaptive;
+        config.initial_delay_ms = row.delay_ms;
+        JitterBufferStats stats = run(link, packets, config);
+        std::cout << std::left << std::setw(16) << row.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << stats.underruns << std::setw(8) << stats.lost << std::setw(8) << stats.late
+                  << std::setw(14) << stats.concealed_ms << std::setw(12) << stats.dropped_ms << std::setw(12)
+                  << stats.delay.mean() / 1e6 << std::setw(10) << stats.delay.percentile(99.0) / 1e6 << std::endl;
+    }
+    return 0;
+}
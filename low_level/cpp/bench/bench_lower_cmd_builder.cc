@@ -0,0 +1,85 @@
+// Benchmark: building the e9 swing command every cycle.
+// "fresh" constructs and returns a new LowerCmd_ and sets all six fields of every
+// motor (the original createSwingCmd); "builder" patches q in a preallocated
+// LowerCmdBuilder whose mode and gains were set once.
+//
+// Usage: ./bench_lower_cmd_builder [iterations]
+#include "lower_cmd.hpp"
+#include "common/lower_cmd_builder.hpp"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace dobotmh4::msg::dds_;
+using quad_sdk::LowerCmdBuilder;
+using quad_sdk::abs2Hw;
+using quad_sdk::kNumJoints;
+using quad_sdk::kNumMotors;
+
+const std::array<double, kNumMotors> motor_offset
+    = {-0.05, -0.5, 1.17, 0.0, 0.05, -0.5, 1.17, 0.0, -0.05, 0.5, -1.17, 0.0, 0.05, 0.5, -1.17, 0.0};
+std::array<double, kNumMotors> q_init = {0.0};
+
+// Stand-in for publisher->publish(): keeps the compiler from discarding the command.
+static volatile float g_sink;
+static void consume(const LowerCmd_& cmd)
+{
+    g_sink = cmd.motor_cmd()[14].q();
+}
+
+static LowerCmd_ createSwingCmd(double s)
+{
+    LowerCmd_ cmd;
+    double swing = std::sin(2 * M_PI * s) * 0.2; // hoisted as in the builder path: only allocation differs
+    for (int i = 0; i < kNumJoints; ++i) {
+        int hw = abs2Hw(i);
+        double qdes = q_init[hw] + swing + motor_offset[hw];
+        cmd.motor_cmd()[hw].mode(0);
+        cmd.motor_cmd()[hw].q(qdes);
+        cmd.motor_cmd()[hw].dq(0.0f);
+        cmd.motor_cmd()[hw].tau(0.0f);
+        cmd.motor_cmd()[hw].kp(30.0f);
+        cmd.motor_cmd()[hw].kd(1.2f);
+    }
+    return cmd;
+}
+
+template <typename Fn>
+static double ns_per_cycle(int iterations, Fn fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        fn(i);
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(ns) / iterations;
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+
+    for (int i = 0; i < kNumMotors; ++i)
+        q_init[i] = 0.01 * i;
+
+    LowerCmdBuilder builder(motor_offset);
+    builder.set_all(0, 30.0f, 1.2f);
+
+    // Warm up both paths once so neither pays first-touch costs in the timed run.
+    consume(createSwingCmd(0.0));
+
+    double fresh = ns_per_cycle(iterations, [](int i) { consume(createSwingCmd(i / 500.0)); });
+    double patched = ns_per_cycle(iterations, [&](int i) {
+        double swing = std::sin(2 * M_PI * (i / 500.0)) * 0.2;
+        for (int j = 0; j < kNumJoints; ++j)
+            builder.set_q(j, q_init[abs2Hw(j)] + swing);
+        consume(builder.cmd());
+    });
+
+    std::cout << "Iterations: " << iterations << std::endl;
+    std::cout << "  fresh LowerCmd_ per cycle : " << fresh << " ns/cycle" << std::endl;
+    std::cout << "  LowerCmdBuilder (q only)  : " << patched << " ns/cycle" << std::endl;
+    std::cout << "  speedup: " << fresh / patched << "x" << std::endl;
+    return 0;
+}
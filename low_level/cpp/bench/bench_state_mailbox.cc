@@ -0,0 +1,140 @@
+// Microbenchmark: handing LowerState_ from a 2 kHz producer thread to a consumer thread.
+// Compares the wait-free StateMailbox against a std::mutex-protected copy, with the
+// consumer either polling at 2 kHz (control loop) or spinning (worst-case contention).
+//
+// Usage: ./bench_state_mailbox [seconds_per_case]
+#include "lower_state.hpp"
+#include "common/latency_histogram.hpp"
+#include "common/periodic_executor.hpp"
+#include "common/state_mailbox.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace dobotmh4::msg::dds_;
+using quad_sdk::LatencyHistogram;
+using quad_sdk::PeriodicExecutor;
+using quad_sdk::PeriodicExecutorConfig;
+using quad_sdk::StateMailbox;
+
+// Baseline: what a straightforward locked hand-off looks like.
+class MutexMailbox
+{
+public:
+    MutexMailbox()
+        : seq_(0)
+    {
+    }
+
+    void write(const LowerState_& state)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        value_ = state;
+        seq_++;
+    }
+
+    bool read(LowerState_& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (seq_ == 0)
+            return false;
+        out = value_;
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    LowerState_ value_;
+    uint64_t seq_;
+};
+
+static int64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Every motor q is set to the same value, so a torn read shows up as a mismatch.
+static bool consistent(const LowerState_& state)
+{
+    for (int i = 1; i < 16; ++i) {
+        if (state.motor_state()[i].q() != state.motor_state()[0].q())
+            return false;
+    }
+    return true;
+}
+
+template <typename WriteFn, typename ReadFn>
+static void run_case(const std::string& name, int seconds, bool spin_reader, WriteFn write, ReadFn read)
+{
+    LatencyHistogram write_cost;
+    LatencyHistogram read_cost;
+    std::atomic<bool> done {false};
+    uint64_t torn = 0;
+
+    PeriodicExecutorConfig writer_config;
+    writer_config.period_ns = 500000; // 2 kHz, like a fast rt/lower/state stream
+    const uint64_t writer_cycles = static_cast<uint64_t>(seconds) * 2000;
+
+    std::thread writer([&] {
+        LowerState_ state;
+        PeriodicExecutor executor(writer_config);
+        executor.run([&](uint64_t cycle) {
+            for (int i = 0; i < 16; ++i)
+                state.motor_state()[i].q(static_cast<float>(cycle));
+            auto start = std::chrono::steady_clock::now();
+            write(state);
+            write_cost.record_signed(elapsed_ns(start));
+            return cycle + 1 < writer_cycles;
+        });
+        done = true;
+    });
+
+    std::thread reader([&] {
+        PeriodicExecutor executor(writer_config);
+        auto poll = [&]() {
+            auto start = std::chrono::steady_clock::now();
+            const LowerState_* state = read();
+            read_cost.record_signed(elapsed_ns(start));
+            if (state && !consistent(*state))
+                torn++;
+        };
+        if (spin_reader) {
+            while (!done)
+                poll();
+        } else {
+            executor.run([&](uint64_t) {
+                poll();
+                return !done;
+            });
+        }
+    });
+
+    writer.join();
+    reader.join();
+
+    std::cout << name << (spin_reader ? " (spinning reader)" : " (2 kHz reader)") << std::endl;
+    write_cost.print(std::cout, "  write");
+    read_cost.print(std::cout, "  read ");
+    std::cout << "  torn reads: " << torn << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int seconds = (argc > 1) ? std::atoi(argv[1]) : 3;
+
+    for (int spin = 0; spin < 2; ++spin) {
+        StateMailbox<LowerState_> mailbox;
+        run_case("StateMailbox", seconds, spin != 0, [&](const LowerState_& s) { mailbox.write(s); },
+            [&]() { return mailbox.read(); });
+
+        MutexMailbox locked;
+        LowerState_ copy;
+        run_case("std::mutex + copy", seconds, spin != 0, [&](const LowerState_& s) { locked.write(s); },
+            [&]() -> const LowerState_* { return locked.read(copy) ? &copy : nullptr; });
+    }
+    return 0;
+}
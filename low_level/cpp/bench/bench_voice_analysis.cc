@@ -0,0 +1,203 @@
+// Benchmark: VoiceAnalyzer (common/voice_analysis.hpp) with the scalar kernels vs the
+// SIMD ones this CPU supports (AVX2/FMA or NEON).
+//
+// The input is a synthetic rt/voice/state stream: 24 kHz chunks of background noise
+// with speech-like bursts (a harmonic voice with moving formants and a 4 Hz syllable
+// envelope) of known start and end, and a speaker angle that jitters around a fixed
+// direction. Reported per kernel set: analysis time per chunk and as a share of one
+// core at the real-time stream rate, kernel throughput, and how the detected speech
+// segments line up with the true ones (onset/offset delay, misses, false starts).
+// The two kernel sets must produce the same events.
+//
+// Usage: ./bench_voice_analysis [chunk_ms=100] [duration_s=600] [noise_dbfs=-55]
+#include "common/voice_analysis.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using quad_sdk::VoiceAnalysisConfig;
+using quad_sdk::VoiceAnalyzer;
+using quad_sdk::VoiceEvent;
+
+const int kSampleRate = 24000;
+volatile uint64_t g_sink;
+
+struct Segment
+{
+    int64_t start_ns;
+    int64_t end_ns;
+};
+
+static std::vector<int16_t> synthesize(double duration_s, double noise_dbfs, std::vector<Segment>& speech)
+{
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0.0, std::pow(10.0, noise_dbfs / 20.0) * 32768.0);
+    std::uniform_real_distribution<double> pause_s(0.8, 2.5), talk_s(0.6, 3.0), level_db(-32.0, -18.0);
+    const size_t total = static_cast<size_t>(duration_s * kSampleRate);
+    std::vector<int16_t> pcm(total);
+    double t_next = pause_s(rng);
+    double seg_end = -1.0, amp = 0.0, phase = 0.0;
+    for (size_t i = 0; i < total; ++i) {
+        double t = static_cast<double>(i) / kSampleRate;
+        if (t >= t_next && seg_end < 0.0) {
+            seg_end = t + talk_s(rng);
+            amp = std::pow(10.0, level_db(rng) / 20.0) * 32768.0;
+            speech.push_back({static_cast<int64_t>(t * 1e9), static_cast<int64_t>(seg_end * 1e9)});
+        }
+        double v = noise(rng);
+        if (seg_end >= 0.0) {
+            // 110-190 Hz pitch, harmonics shaped by two slowly moving formants.
+            double f0 = 150.0 + 40.0 * std::sin(2 * M_PI * 0.9 * t);
+            phase += 2 * M_PI * f0 / kSampleRate;
+            double f1 = 600.0 + 250.0 * std::sin(2 * M_PI * 2.3 * t);
+            double f2 = 1700.0 + 500.0 * std::sin(2 * M_PI * 1.7 * t);
+            double voice = 0.0;
+            for (int h = 1; h * f0 < 4000.0; ++h) {
+                double f = h * f0;
+                double gain = 1.0 / (1.0 + std::pow((f - f1) / 150.0, 2)) + 0.5 / (1.0 + std::pow((f - f2) / 250.0, 2));
+                voice += gain * std::sin(h * phase);
+            }
+            double syllable = 0.55 + 0.45 * std::sin(2 * M_PI * 4.0 * t);
+            v += amp * 0.5 * syllable * voice;
+            if (t >= seg_end) {
+                seg_end = -1.0;
+                t_next = t + pause_s(rng);
+            }
+        }
+        pcm[i] = static_cast<int16_t>(std::max(-32768.0, std::min(32767.0, v)));
+    }
+    return pcm;
+}
+
+struct Result
+{
+    std::vector<VoiceEvent> events;
+    double ns_per_chunk;
+    double level_msps; // million samples per second through each kernel
+    double filter_msps;
+};
+
+static Result run(const std::vector<int16_t>& pcm, size_t chunk, bool simd)
+{
+    typedef std::chrono::steady_clock Clock;
+    VoiceAnalysisConfig config;
+    config.use_simd = simd;
+    VoiceAnalyzer analyzer(config);
+    std::mt19937 rng(3);
+    std::normal_distribution<float> angle(75.0f, 8.0f);
+
+    Result result;
+    std::vector<VoiceEvent> events;
+    events.reserve(64);
+    size_t chunks = pcm.size() / chunk;
+    Clock::time_point start = Clock::now();
+    for (size_t c = 0; c < chunks; ++c) {
+        int64_t t_ns = static_cast<int64_t>((c + 1) * chunk) * 1000000000LL / kSampleRate;
+        events.clear();
+        analyzer.process(&pcm[c * chunk], chunk, angle(rng), t_ns, events);
+        result.events.insert(result.events.end(), events.begin(), events.end());
+    }
+    result.ns_per_chunk = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / chunks;
+
+    // The two kernels alone, over the whole signal.
+    quad_sdk::VoiceKernels kernels = quad_sdk::voice_kernels(simd);
+    quad_sdk::VoiceFilterBank bank = {};
+    uint64_t sumsq = 0;
+    uint32_t peak = 0;
+    start = Clock::now();
+    kernels.level(pcm.data(), pcm.size(), &sumsq, &peak);
+    result.level_msps = pcm.size() / std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    start = Clock::now();
+    kernels.filter(pcm.data(), pcm.size(), bank);
+    result.filter_msps = pcm.size() / std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    g_sink = sumsq + peak + static_cast<uint64_t>(bank.energy[0]); // keep the kernels from being optimized out
+    return result;
+}
+
+// Matches each true segment with the first detected start within 0.5 s of it.
+static void score(const std::vector<VoiceEvent>& events, const std::vector<Segment>& truth, double* onset_ms,
+                  double* offset_ms, int* missed, int* false_starts)
+{
+    std::vector<Segment> detected;
+    for (const VoiceEvent& e : events) {
+        if (e.type == VoiceEvent::kSpeechStart)
+            detected.push_back({e.t_ns, -1});
+        else if (e.type == VoiceEvent::kSpeechStop && !detected.empty())
+            detected.back().end_ns = e.t_ns;
+    }
+    std::vector<bool> used(detected.size(), false);
+    double onset_sum = 0.0, offset_sum = 0.0;
+    int matched = 0, offsets = 0;
+    *missed = 0;
+    for (const Segment& s : truth) {
+        bool found = false;
+        for (size_t d = 0; d < detected.size(); ++d) {
+            if (!used[d] && std::llabs(detected[d].start_ns - s.start_ns) < 500000000LL) {
+                used[d] = found = true;
+                onset_sum += (detected[d].start_ns - s.start_ns) / 1e6;
+                if (detected[d].end_ns > 0) {
+                    offset_sum += (detected[d].end_ns - s.end_ns) / 1e6;
+                    offsets++;
+                }
+                matched++;
+                break;
+            }
+        }
+        if (!found)
+            (*missed)++;
+    }
+    *false_starts = static_cast<int>(detected.size()) - matched;
+    *onset_ms = matched ? onset_sum / matched : 0.0;
+    *offset_ms = offsets ? offset_sum / offsets : 0.0;
+}
+
+int main(int argc, char** argv)
+{
+    int chunk_ms = (argc > 1) ? std::atoi(argv[1]) : 100;
+    double duration_s = (argc > 2) ? std::atof(argv[2]) : 600.0;
+    double noise_dbfs = (argc > 3) ? std::atof(argv[3]) : -55.0;
+    if (chunk_ms < 1 || chunk_ms > 1000 || duration_s <= 0.0) {
+        std::cerr << "Usage: " << argv[0] << " [chunk_ms=100] [duration_s=600] [noise_dbfs=-55]" << std::endl;
+        return 1;
+    }
+    std::vector<Segment> truth;
+    std::vector<int16_t> pcm = synthesize(duration_s, noise_dbfs, truth);
+    size_t chunk = static_cast<size_t>(kSampleRate) * chunk_ms / 1000;
+
+    std::cout << duration_s << " s of audio in " << chunk_ms << " ms chunks, noise " << noise_dbfs << " dBFS, "
+              << truth.size() << " speech segments\n"
+              << std::endl;
+    std::cout << std::left << std::setw(10) << "kernels" << std::right << std::setw(14) << "us/chunk"
+              << std::setw(12) << "% core" << std::setw(14) << "level Msps" << std::setw(14) << "filter Msps"
+              << std::setw(12) << "onset ms" << std::setw(12) << "offset ms" << std::setw(8) << "missed"
+              << std::setw(8) << "false" << std::endl;
+    Result results[2];
+    for (int simd = 0; simd < 2; ++simd) {
+        Result& r = results[simd];
+        r = run(pcm, chunk, simd != 0);
+        double onset_ms, offset_ms;
+        int missed, false_starts;
+        score(r.events, truth, &onset_ms, &offset_ms, &missed, &false_starts);
+        std::cout << std::left << std::setw(10) << quad_sdk::voice_kernels(simd != 0).name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(14) << r.ns_per_chunk / 1e3 << std::setprecision(4)
+                  << std::setw(12) << 100.0 * r.ns_per_chunk / (chunk_ms * 1e6) << std::setprecision(0)
+                  << std::setw(14) << r.level_msps << std::setw(14) << r.filter_msps << std::setw(12) << onset_ms
+                  << std::setw(12) << offset_ms << std::setw(8) << missed << std::setw(8) << false_starts << std::endl;
+    }
+
+    bool same = results[0].events.size() == results[1].events.size();
+    for (size_t i = 0; same && i < results[0].events.size(); ++i) {
+        const VoiceEvent& a = results[0].events[i];
+        const VoiceEvent& b = results[1].events[i];
+        same = a.type == b.type && a.t_ns == b.t_ns && std::fabs(a.rms_dbfs - b.rms_dbfs) < 0.01f;
+    }
+    std::cout << "\n" << results[1].events.size() << " events, scalar and SIMD "
+              << (same ? "identical" : "DIFFER") << ", speedup " << std::setprecision(1)
+              << results[0].ns_per_chunk / results[1].ns_per_chunk << "x" << std::endl;
+    return same ? 0 : 1;
+}
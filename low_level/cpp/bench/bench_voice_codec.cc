@@ -0,0 +1,257 @@
+// Benchmark: rt/voice/cmd streaming as raw 24 kHz S16_LE PCM ("streaming") vs Opus
+// ("opus", common/opus_voice.hpp), between two processes with e7_voice_pub's QoS
+// (RELIABLE, KEEP_LAST(5)).
+//
+// The child publishes a synthetic voice signal paced in real time, one message per
+// chunk_ms, as if each chunk had just been captured; the parent decodes every message
+// like the robot's playback service would. Reported: payload bandwidth and message
+// rate, CPU time of each side as a share of one core (encode and decode included), and
+// end-to-end latency from the first sample of a chunk being captured to that sample
+// being decoded and ready to play. That latency includes the chunk itself and, for
+// Opus, the encoder lookahead.
+//
+// Loopback never congests, so compare the codecs on a constrained link by shaping it,
+// e.g.  sudo tc qdisc add dev lo root netem rate 400kbit delay 20ms loss 1%
+// (remove with: sudo tc qdisc del dev lo root) and CYCLONEDDS_URI=cyclonedds_local.xml.
+//
+// Usage: ./bench_voice_codec [raw|opus] [bitrate_kbps=24] [chunk_ms] [duration_s=10]
+//   chunk_ms defaults to 100 for raw (as e7_voice_pub streaming) and 20 for opus
+#include "dds_middleware.hpp"
+#include "voice_cmd.hpp"
+#include "common/latency_histogram.hpp"
+#include "common/opus_voice.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace dds_middleware;
+using namespace dobotmh4::msg::dds_;
+using quad_sdk::LatencyHistogram;
+
+const char* const kTopic = "rt/bench/voice";
+const size_t kMaxChunks = 1 << 16;
+
+static int64_t monotonic_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+static double cpu_seconds(int who)
+{
+    rusage usage;
+    getrusage(who, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+struct BenchConfig
+{
+    bool opus;
+    int bitrate_kbps;
+    int chunk_ms;
+    double duration_s;
+};
+
+// Written by the publisher, read by the subscriber. The path field of every message
+// carries its chunk index; capture_ns[index] is stored before the message is published,
+// and the socket round trip through the kernel orders the two.
+struct SharedTimeline
+{
+    uint64_t sent;
+    int lookahead_samples;
+    int64_t capture_ns[kMaxChunks];
+};
+
+static QoSProfile voice_qos()
+{
+    QoSProfile qos;
+    qos.reliability = ReliabilityPolicy::RELIABLE;
+    qos.history = HistoryPolicy::KEEP_LAST;
+    qos.history_depth = 5;
+    qos.durability = DurabilityPolicy::VOLATILE;
+    return qos;
+}
+
+// Harmonics of a gliding 110-180 Hz pitch under a 4 Hz syllable envelope, plus a little
+// noise: enough structure that Opus works as hard as on speech.
+static std::vector<int16_t> synthetic_voice(size_t samples)
+{
+    std::vector<int16_t> pcm(samples);
+    const double rate = quad_sdk::kVoiceSampleRate;
+    double phase = 0.0;
+    unsigned seed = 1;
+    for (size_t i = 0; i < samples; ++i) {
+        double t = i / rate;
+        double f0 = 145.0 + 35.0 * std::sin(2.0 * M_PI * 0.7 * t);
+        phase += 2.0 * M_PI * f0 / rate;
+        double voiced = 0.0;
+        for (int k = 1; k <= 20; ++k)
+            voiced += std::sin(k * phase) / k;
+        double envelope = std::max(0.0, std::sin(2.0 * M_PI * 4.0 * t));
+        seed = seed * 1103515245u + 12345u;
+        double noise = ((seed >> 16) & 0x7fff) / 32768.0 - 0.5;
+        pcm[i] = static_cast<int16_t>(6000.0 * envelope * voiced + 300.0 * noise);
+    }
+    return pcm;
+}
+
+static int run_publisher(const BenchConfig& config, SharedTimeline* timeline)
+{
+    auto middleware = std::make_shared<DDSMiddleware>(0);
+    auto publisher = middleware->create_publisher<VoiceCmd_>(kTopic, voice_qos());
+    quad_sdk::OpusVoiceEncoder encoder(config.bitrate_kbps * 1000, 20);
+    if (config.opus && !encoder.ok())
+        return 1;
+    timeline->lookahead_samples = config.opus ? encoder.lookahead_samples() : 0;
+
+    const size_t chunk_samples = quad_sdk::kVoiceSampleRate * config.chunk_ms / 1000;
+    size_t chunks = static_cast<size_t>(config.duration_s * 1000 / config.chunk_ms);
+    chunks = std::min(chunks, kMaxChunks);
+    const std::vector<int16_t> pcm = synthetic_voice(chunks * chunk_samples);
+
+    // Discovery, as in e7_voice_pub.
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    VoiceCmd_ msg;
+    msg.type(config.opus ? quad_sdk::kVoiceTypeOpus : "streaming");
+    double cpu_start = cpu_seconds(RUSAGE_SELF);
+    const int64_t period = static_cast<int64_t>(config.chunk_ms) * 1000000LL;
+    const int64_t start = monotonic_ns() + period;
+    for (size_t i = 0; i < chunks; ++i) {
+        // Chunk i is complete once its last sample has been "captured".
+        int64_t deadline = start + static_cast<int64_t>(i + 1) * period;
+        timespec ts;
+        ts.tv_sec = deadline / 1000000000LL;
+        ts.tv_nsec = deadline % 1000000000LL;
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+
+        const int16_t* chunk = pcm.data() + i * chunk_samples;
+        msg.data().clear();
+        if (config.opus) {
+            if (encoder.encode(chunk, chunk_samples, msg.data()) < 0)
+                return 1;
+        } else {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(chunk);
+            msg.data().assign(bytes, bytes + chunk_samples * sizeof(int16_t));
+        }
+        msg.path(std::to_string(i));
+        timeline->capture_ns[i] = deadline - period;
+        publisher->publish(msg);
+        timeline->sent = i + 1;
+    }
+    double wall_s = chunks * config.chunk_ms / 1000.0;
+    double cpu_s = cpu_seconds(RUSAGE_SELF) - cpu_start;
+    std::cout << "publisher: sent=" << timeline->sent << " cpu=" << 100.0 * cpu_s / wall_s << "%" << std::endl;
+
+    // Give reliable delivery time to drain before the writer goes away.
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    return 0;
+}
+
+static int run_subscriber(const BenchConfig& config, const SharedTimeline* timeline, pid_t child)
+{
+    quad_sdk::OpusVoiceDecoder decoder;
+    if (!decoder.ok())
+        return 1;
+    std::vector<int16_t> pcm;
+    LatencyHistogram latency;
+    uint64_t received = 0, bytes = 0, samples = 0, errors = 0;
+    int64_t first_ns = 0, last_ns = 0;
+
+    auto on_voice = [&](const VoiceCmd_& msg) {
+        pcm.clear();
+        if (config.opus) {
+            if (!decoder.decode(msg.data().data(), msg.data().size(), pcm))
+                errors++;
+        } else {
+            pcm.resize(msg.data().size() / sizeof(int16_t));
+            std::memcpy(pcm.data(), msg.data().data(), pcm.size() * sizeof(int16_t));
+        }
+        int64_t now = monotonic_ns();
+        size_t index = std::strtoul(msg.path().c_str(), nullptr, 10);
+        if (index < kMaxChunks) {
+            // Decoded audio lags the input by the lookahead, so the chunk's first sample
+            // is only out once that much more has been decoded.
+            int64_t lookahead_ns = timeline->lookahead_samples * 1000000000LL / quad_sdk::kVoiceSampleRate;
+            latency.record_signed(now - timeline->capture_ns[index] + lookahead_ns);
+        }
+        bytes += msg.data().size();
+        samples += pcm.size();
+        if (received == 0)
+            first_ns = now;
+        last_ns = now;
+        received++;
+    };
+
+    auto middleware = std::make_shared<DDSMiddleware>(0);
+    double cpu_start = cpu_seconds(RUSAGE_SELF);
+    auto subscription = middleware->create_subscription<VoiceCmd_>(kTopic, on_voice, voice_qos());
+    int status = 0;
+    waitpid(child, &status, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    subscription.reset();
+    double cpu_s = cpu_seconds(RUSAGE_SELF) - cpu_start;
+
+    double span_s = received > 1 ? (last_ns - first_ns) / 1e9 + config.chunk_ms / 1000.0 : 0.0;
+    std::cout << (config.opus ? "opus " + std::to_string(config.bitrate_kbps) + " kbit/s" : std::string("raw pcm"))
+              << ", " << config.chunk_ms << " ms chunks: received=" << received
+              << " lost=" << timeline->sent - received << " decode_errors=" << errors
+              << " audio=" << samples / static_cast<double>(quad_sdk::kVoiceSampleRate) << " s";
+    if (span_s > 0.0)
+        std::cout << " rate=" << received / span_s << " msg/s payload=" << bytes / span_s / 1000.0 << " kB/s";
+    std::cout << " subscriber cpu=" << (span_s > 0.0 ? 100.0 * cpu_s / span_s : 0.0) << "%" << std::endl;
+    latency.print(std::cout, "capture -> decoded");
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig config;
+    config.opus = !(argc > 1 && std::string(argv[1]) == "raw");
+    config.bitrate_kbps = (argc > 2) ? std::atoi(argv[2]) : 24;
+    config.chunk_ms = (argc > 3) ? std::atoi(argv[3]) : (config.opus ? 20 : 100);
+    config.duration_s = (argc > 4) ? std::atof(argv[4]) : 10.0;
+    if (config.bitrate_kbps < 6 || config.duration_s <= 0.0 || config.chunk_ms < 10
+        || (config.opus && config.chunk_ms % 20 != 0)) {
+        std::cerr << "Usage: " << argv[0] << " [raw|opus] [bitrate_kbps=24] [chunk_ms] [duration_s=10]\n"
+                  << "  opus chunk_ms must be a multiple of the 20 ms frame" << std::endl;
+        return 1;
+    }
+
+    void* shared = mmap(nullptr, sizeof(SharedTimeline), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+        std::cerr << "mmap failed: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    SharedTimeline* timeline = static_cast<SharedTimeline*>(shared);
+
+    // Fork before either side touches DDS: a forked child must not inherit a live domain.
+    pid_t child = fork();
+    if (child < 0) {
+        std::cerr << "fork failed: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    try {
+        if (child == 0)
+            _exit(run_publisher(config, timeline));
+        return run_subscriber(config, timeline, child);
+    } catch (const std::exception& e) {
+        std::cerr << "DDS error: " << e.what() << std::endl;
+        if (child == 0)
+            _exit(1);
+        return 1;
+    }
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+// In-process 24 kHz S16_LE mono audio capture into an AudioRing (common/audio_ring.hpp).
+//
+//   AlsaCapture  an ALSA capture device ("default", "hw:1,0", ...). Needs libasound and
+//                QUAD_SDK_WITH_ALSA.
+//   FileCapture  an audio file (WAV, or FLAC/MP3/... with libsndfile) decoded and
+//                resampled on the fly (common/audio_file.hpp), paced in real time like
+//                a device: local files stream without an offline conversion step, and
+//                the examples run on a headless machine.
+//
+// Either one runs its own thread that reads one period at a time straight into the
+// ring. open_audio_capture() picks the backend from the source name.
+
+#include "common/audio_file.hpp"
+#include "common/audio_ring.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+#ifdef QUAD_SDK_WITH_ALSA
+#include <alsa/asoundlib.h>
+#endif
+
+namespace quad_sdk {
+
+const unsigned kCaptureSampleRate = 24000;
+
+class AudioCapture
+{
+public:
+    explicit AudioCapture(size_t period_samples)
+        : period_samples_(period_samples)
+        , running_(false)
+        , finished_(false)
+        , scratch_(period_samples)
+    {
+    }
+
+    // Derived classes call stop() in their destructor, before their source goes away.
+    virtual ~AudioCapture() {}
+
+    AudioCapture(const AudioCapture&) = delete;
+    AudioCapture& operator=(const AudioCapture&) = delete;
+
+    size_t period_samples() const { return period_samples_; }
+
+    // Starts the capture thread. ring.period_samples() must equal period_samples().
+    bool start(AudioRing& ring)
+    {
+        if (running_ || ring.period_samples() != period_samples_)
+            return false;
+        running_ = true;
+        finished_ = false;
+        thread_ = std::thread(&AudioCapture::run, this, std::ref(ring));
+        return true;
+    }
+
+    void stop()
+    {
+        running_ = false;
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    // True once the source has ended (a WAV file without looping) or failed.
+    bool finished() const { return finished_; }
+
+protected:
+    // Blocks until the next period has been captured into dst. Returns false at the end
+    // of the source or on an unrecoverable error.
+    virtual bool read_period(int16_t* dst) = 0;
+
+    static int64_t monotonic_ns()
+    {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+    }
+
+    size_t period_samples_;
+
+private:
+    void run(AudioRing& ring)
+    {
+        while (running_) {
+            // A full ring still has to be drained from the device, into scratch.
+            int16_t* slot = ring.begin_write();
+            if (!read_period(slot ? slot : scratch_.data()))
+                break;
+            if (slot)
+                ring.commit(monotonic_ns());
+        }
+        finished_ = true;
+    }
+
+    std::atomic<bool> running_;
+    std::atomic<bool> finished_;
+    std::vector<int16_t> scratch_;
+    std::thread thread_;
+};
+
+#ifdef QUAD_SDK_WITH_ALSA
+class AlsaCapture : public AudioCapture
+{
+public:
+    explicit AlsaCapture(size_t period_samples)
+        : AudioCapture(period_samples)
+        , pcm_(nullptr)
+        , xruns_(0)
+    {
+    }
+
+    ~AlsaCapture()
+    {
+        stop();
+        if (pcm_)
+            snd_pcm_close(pcm_);
+    }
+
+    // Opens `device` for blocking S16_LE mono capture at 24 kHz with the given period
+    // and a four-period device buffer.
+    bool open(const std::string& device)
+    {
+        int err = snd_pcm_open(&pcm_, device.c_str(), SND_PCM_STREAM_CAPTURE, 0);
+        if (err < 0) {
+            std::cerr << "Cannot open ALSA device " << device << ": " << snd_strerror(err) << std::endl;
+            pcm_ = nullptr;
+            return false;
+        }
+        snd_pcm_hw_params_t* params;
+        snd_pcm_hw_params_alloca(&params);
+        unsigned rate = kCaptureSampleRate;
+        snd_pcm_uframes_t period = period_samples_;
+        snd_pcm_uframes_t buffer = period_samples_ * 4;
+        if ((err = snd_pcm_hw_params_any(pcm_, params)) < 0
+            || (err = snd_pcm_hw_params_set_access(pcm_, params, SND_PCM_ACCESS_RW_INTERLEAVED)) < 0
+            || (err = snd_pcm_hw_params_set_format(pcm_, params, SND_PCM_FORMAT_S16_LE)) < 0
+            || (err = snd_pcm_hw_params_set_channels(pcm_, params, 1)) < 0
+            || (err = snd_pcm_hw_params_set_rate(pcm_, params, rate, 0)) < 0
+            || (err = snd_pcm_hw_params_set_period_size_near(pcm_, params, &period, nullptr)) < 0
+            || (err = snd_pcm_hw_params_set_buffer_size_near(pcm_, params, &buffer)) < 0
+            || (err = snd_pcm_hw_params(pcm_, params)) < 0) {
+            std::cerr << "Cannot configure " << device << " for 24 kHz S16_LE mono: " << snd_strerror(err)
+                      << std::endl;
+            return false;
+        }
+        if (period != period_samples_)
+            std::cout << "ALSA period is " << period << " frames (asked for " << period_samples_ << ")" << std::endl;
+        return true;
+    }
+
+    // Device overruns: the capture thread did not read in time and samples were lost.
+    uint64_t xruns() const { return xruns_; }
+
+protected:
+    bool read_period(int16_t* dst) override
+    {
+        snd_pcm_uframes_t done = 0;
+        while (done < period_samples_) {
+            snd_pcm_sframes_t n = snd_pcm_readi(pcm_, dst + done, period_samples_ - done);
+            if (n == -EPIPE)
+                xruns_++;
+            if (n < 0) {
+                if (snd_pcm_recover(pcm_, static_cast<int>(n), 1) < 0) {
+                    std::cerr << "ALSA capture failed: " << snd_strerror(static_cast<int>(n)) << std::endl;
+                    return false;
+                }
+                continue;
+            }
+            done += n;
+        }
+        return true;
+    }
+
+private:
+    snd_pcm_t* pcm_;
+    std::atomic<uint64_t> xruns_;
+};
+#endif
+
+class FileCapture : public AudioCapture
+{
+public:
+    explicit FileCapture(size_t period_samples)
+        : AudioCapture(period_samples)
+        , loop_(false)
+        , next_ns_(0)
+    {
+    }
+
+    ~FileCapture() { stop(); }
+
+    // With `loop` the file repeats forever, otherwise the capture finishes after its
+    // last (zero-padded) period.
+    bool open(const std::string& path, bool loop)
+    {
+        if (!reader_.open(path))
+            return false;
+        loop_ = loop;
+        const AudioFileDecoder& decoder = reader_.decoder();
+        std::cout << path << ": " << decoder.format_name() << ", " << decoder.sample_rate() << " Hz, "
+                  << decoder.channels() << " channel(s) -> 24000 Hz mono" << std::endl;
+        return true;
+    }
+
+protected:
+    bool read_period(int16_t* dst) override
+    {
+        size_t got = reader_.read(dst, period_samples_);
+        if (got < period_samples_ && loop_ && reader_.rewind())
+            got += reader_.read(dst + got, period_samples_ - got);
+        if (got == 0)
+            return false;
+        std::fill(dst + got, dst + period_samples_, 0);
+
+        // Hand the period over when a device would have: after it has been "recorded".
+        int64_t period_ns = static_cast<int64_t>(period_samples_) * 1000000000LL / kCaptureSampleRate;
+        next_ns_ = (next_ns_ == 0 ? monotonic_ns() : next_ns_) + period_ns;
+        timespec ts;
+        ts.tv_sec = next_ns_ / 1000000000LL;
+        ts.tv_nsec = next_ns_ % 1000000000LL;
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+        return true;
+    }
+
+private:
+    AudioFileReader reader_;
+    bool loop_;
+    int64_t next_ns_;
+};
+
+// An existing regular file opens a FileCapture (played once unless `loop_file`),
+// anything else an ALSA device. Returns nullptr (after printing why) when the source
+// cannot be opened.
+inline std::unique_ptr<AudioCapture> open_audio_capture(const std::string& source, size_t period_samples,
+                                                        bool loop_file = false)
+{
+    struct stat st;
+    if (stat(source.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+        std::unique_ptr<FileCapture> file(new FileCapture(period_samples));
+        if (!file->open(source, loop_file))
+            return nullptr;
+        return std::unique_ptr<AudioCapture>(file.release());
+    }
+#ifdef QUAD_SDK_WITH_ALSA
+    std::unique_ptr<AlsaCapture> alsa(new AlsaCapture(period_samples));
+    if (!alsa->open(source))
+        return nullptr;
+    return std::unique_ptr<AudioCapture>(alsa.release());
+#else
+    std::cerr << "Built without ALSA: capture device " << source << " unavailable, use an audio file" << std::endl;
+    return nullptr;
+#endif
+}
+
+} // namespace quad_sdk
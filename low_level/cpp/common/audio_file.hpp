@@ -0,0 +1,501 @@
+#pragma once
+
+// Streaming audio file decoding into the 24 kHz S16_LE mono format of the voice topics.
+//
+//   WavDecoder      RIFF/WAVE with 8/16/24/32-bit integer or 32/64-bit float samples,
+//                   any rate and channel count. No dependencies.
+//   SndfileDecoder  FLAC, MP3, Ogg/Vorbis and everything else libsndfile reads. Needs
+//                   libsndfile and QUAD_SDK_WITH_SNDFILE.
+//
+// AudioFileReader downmixes and resamples (Resampler below) a decoder's output and
+// hands it out in blocks of any size. Files are decoded a few thousand frames at a
+// time, so memory does not grow with the file. The format is detected from the file
+// contents, not its extension.
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef QUAD_SDK_WITH_SNDFILE
+#include <sndfile.h>
+#endif
+
+namespace quad_sdk {
+
+const unsigned kVoiceFileSampleRate = 24000;
+
+class AudioFileDecoder
+{
+public:
+    virtual ~AudioFileDecoder() {}
+
+    virtual unsigned sample_rate() const = 0;
+    virtual unsigned channels() const = 0;
+    virtual const char* format_name() const = 0;
+
+    // Decodes up to `frames` interleaved frames as floats in [-1, 1]. Returns the
+    // number decoded; 0 at the end of the file or on an error.
+    virtual size_t read(float* out, size_t frames) = 0;
+
+    // Back to the first frame. Returns false if the file cannot seek.
+    virtual bool rewind() = 0;
+};
+
+class WavDecoder : public AudioFileDecoder
+{
+public:
+    WavDecoder()
+        : file_(nullptr)
+        , rate_(0)
+        , channels_(0)
+        , bits_(0)
+        , float_(false)
+        , data_offset_(0)
+        , data_size_(0)
+        , remaining_(0)
+    {
+    }
+
+    ~WavDecoder()
+    {
+        if (file_)
+            fclose(file_);
+    }
+
+    bool open(const std::string& path)
+    {
+        file_ = fopen(path.c_str(), "rb");
+        if (!file_) {
+            std::cerr << "Failed to open " << path << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        char riff[12];
+        if (fread(riff, 1, sizeof(riff), file_) != sizeof(riff) || std::memcmp(riff, "RIFF", 4) != 0
+            || std::memcmp(riff + 8, "WAVE", 4) != 0) {
+            std::cerr << path << " is not a WAV file" << std::endl;
+            return false;
+        }
+        bool have_fmt = false;
+        char id[4];
+        uint32_t size = 0;
+        while (fread(id, 1, 4, file_) == 4 && fread(&size, sizeof(size), 1, file_) == 1) {
+            if (std::memcmp(id, "fmt ", 4) == 0) {
+                uint8_t fmt[40] = {};
+                size_t n = std::min<size_t>(size, sizeof(fmt));
+                if (size < 16 || fread(fmt, 1, n, file_) != n)
+                    break;
+                uint16_t format, channels, bits;
+                std::memcpy(&format, fmt, 2);
+                std::memcpy(&channels, fmt + 2, 2);
+                std::memcpy(&rate_, fmt + 4, 4);
+                std::memcpy(&bits, fmt + 14, 2);
+                if (format == 0xfffe && size >= 26)
+                    std::memcpy(&format, fmt + 24, 2); // WAVE_FORMAT_EXTENSIBLE: first two bytes of the GUID
+                channels_ = channels;
+                bits_ = bits;
+                float_ = format == 3;
+                have_fmt = (format == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32))
+                    || (format == 3 && (bits == 32 || bits == 64));
+                fseek(file_, static_cast<long>(size - n + (size & 1)), SEEK_CUR);
+            } else if (std::memcmp(id, "data", 4) == 0) {
+                data_offset_ = ftell(file_);
+                data_size_ = size;
+                break;
+            } else {
+                fseek(file_, static_cast<long>(size + (size & 1)), SEEK_CUR); // chunks are word aligned
+            }
+        }
+        if (!have_fmt || channels_ == 0 || rate_ == 0 || data_offset_ == 0) {
+            std::cerr << path << ": unsupported WAV encoding (need integer PCM or float samples)" << std::endl;
+            return false;
+        }
+        remaining_ = data_size_ - data_size_ % frame_bytes();
+        return true;
+    }
+
+    unsigned sample_rate() const override { return rate_; }
+    unsigned channels() const override { return channels_; }
+    const char* format_name() const override { return "WAV"; }
+
+    size_t read(float* out, size_t frames) override
+    {
+        frames = std::min(frames, remaining_ / frame_bytes());
+        size_t bytes = frames * frame_bytes();
+        if (raw_.size() < bytes)
+            raw_.resize(bytes);
+        size_t got = fread(raw_.data(), 1, bytes, file_);
+        frames = got / frame_bytes();
+        remaining_ = got < bytes ? 0 : remaining_ - bytes;
+        convert(raw_.data(), out, frames * channels_);
+        return frames;
+    }
+
+    bool rewind() override
+    {
+        if (fseek(file_, data_offset_, SEEK_SET) != 0)
+            return false;
+        remaining_ = data_size_ - data_size_ % frame_bytes();
+        return true;
+    }
+
+private:
+    size_t frame_bytes() const { return static_cast<size_t>(channels_) * bits_ / 8; }
+
+    void convert(const uint8_t* in, float* out, size_t samples) const
+    {
+        switch (bits_) {
+            case 8: // unsigned
+                for (size_t i = 0; i < samples; ++i)
+                    out[i] = (in[i] - 128) * (1.0f / 128);
+                break;
+            case 16:
+                for (size_t i = 0; i < samples; ++i) {
+                    int16_t v;
+                    std::memcpy(&v, in + 2 * i, 2);
+                    out[i] = v * (1.0f / 32768);
+                }
+                break;
+            case 24:
+                for (size_t i = 0; i < samples; ++i) {
+                    const uint8_t* p = in + 3 * i;
+                    int32_t v = static_cast<int32_t>(static_cast<uint32_t>(p[0]) << 8
+                                                     | static_cast<uint32_t>(p[1]) << 16
+                                                     | static_cast<uint32_t>(p[2]) << 24);
+                    out[i] = v * (1.0f / 2147483648.0f);
+                }
+                break;
+            case 32:
+                for (size_t i = 0; i < samples; ++i) {
+                    if (float_) {
+                        std::memcpy(&out[i], in + 4 * i, 4);
+                    } else {
+                        int32_t v;
+                        std::memcpy(&v, in + 4 * i, 4);
+                        out[i] = v * (1.0f / 2147483648.0f);
+                    }
+                }
+                break;
+            case 64:
+                for (size_t i = 0; i < samples; ++i) {
+                    double v;
+                    std::memcpy(&v, in + 8 * i, 8);
+                    out[i] = static_cast<float>(v);
+                }
+                break;
+        }
+    }
+
+    FILE* file_;
+    uint32_t rate_;
+    unsigned channels_;
+    unsigned bits_;
+    bool float_;
+    long data_offset_;
+    size_t data_size_;
+    size_t remaining_; // bytes of whole frames left in the data chunk
+    std::vector<uint8_t> raw_;
+};
+
+#ifdef QUAD_SDK_WITH_SNDFILE
+class SndfileDecoder : public AudioFileDecoder
+{
+public:
+    SndfileDecoder()
+        : file_(nullptr)
+    {
+        std::memset(&info_, 0, sizeof(info_));
+    }
+
+    ~SndfileDecoder()
+    {
+        if (file_)
+            sf_close(file_);
+    }
+
+    bool open(const std::string& path)
+    {
+        file_ = sf_open(path.c_str(), SFM_READ, &info_);
+        if (!file_) {
+            std::cerr << "Cannot decode " << path << ": " << sf_strerror(nullptr) << std::endl;
+            return false;
+        }
+        // Float reads of integer formats come back normalized to [-1, 1].
+        sf_command(file_, SFC_SET_NORM_FLOAT, nullptr, SF_TRUE);
+        return info_.samplerate > 0 && info_.channels > 0;
+    }
+
+    unsigned sample_rate() const override { return static_cast<unsigned>(info_.samplerate); }
+    unsigned channels() const override { return static_cast<unsigned>(info_.channels); }
+
+    const char* format_name() const override
+    {
+        switch (info_.format & SF_FORMAT_TYPEMASK) {
+            case SF_FORMAT_FLAC:
+                return "FLAC";
+            case SF_FORMAT_MPEG:
+                return "MP3";
+            case SF_FORMAT_OGG:
+                return "Ogg";
+            case SF_FORMAT_WAV:
+                return "WAV";
+            default:
+                return "libsndfile";
+        }
+    }
+
+    size_t read(float* out, size_t frames) override
+    {
+        sf_count_t n = sf_readf_float(file_, out, static_cast<sf_count_t>(frames));
+        return n > 0 ? static_cast<size_t>(n) : 0;
+    }
+
+    bool rewind() override { return sf_seek(file_, 0, SEEK_SET) == 0; }
+
+private:
+    SNDFILE* file_;
+    SF_INFO info_;
+};
+#endif
+
+// Streaming polyphase windowed-sinc resampler for mono float audio.
+//
+// The rate ratio is reduced to out/in = L/M, and output sample n sits at input
+// position n*M/L, tracked exactly in integers so long files do not drift. Filter
+// coefficients for each of the L fractional positions are computed once in the
+// constructor (positions are quantized to kMaxPhases when L is larger). The cutoff
+// sits just below the lower of the two Nyquist frequencies, and the filter is
+// stretched accordingly when downsampling. Input can arrive in blocks of any size;
+// the last taps' worth of samples is carried over between calls.
+class Resampler
+{
+public:
+    Resampler(unsigned in_rate, unsigned out_rate)
+        : up_(1)
+        , down_(1)
+        , half_(0)
+        , stride_(0)
+        , phases_(1)
+        , pos_(0)
+        , frac_(0)
+    {
+        unsigned a = in_rate, b = out_rate;
+        while (b != 0) {
+            unsigned t = a % b;
+            a = b;
+            b = t;
+        }
+        up_ = out_rate / a;
+        down_ = in_rate / a;
+        if (up_ == down_)
+            return; // pass-through
+        double cutoff = 0.95 * std::min(1.0, static_cast<double>(up_) / down_); // of the input Nyquist
+        half_ = static_cast<size_t>(std::ceil(kZeroCrossings / cutoff));
+        stride_ = (2 * half_ + kLanes - 1) / kLanes * kLanes; // zero-padded to whole lanes
+        phases_ = static_cast<size_t>(up_ < kMaxPhases ? up_ : kMaxPhases);
+        taps_.assign(phases_ * stride_, 0.0f);
+        for (size_t p = 0; p < phases_; ++p) {
+            float* h = &taps_[p * stride_];
+            double frac = static_cast<double>(p) / phases_;
+            double sum = 0.0;
+            for (size_t k = 0; k < 2 * half_; ++k) {
+                // Tap k multiplies input sample pos - half + 1 + k.
+                double d = static_cast<double>(half_) - 1.0 - k + frac;
+                double x = d / half_;
+                double window
+                    = std::fabs(x) >= 1.0 ? 0.0 : 0.42 + 0.5 * std::cos(M_PI * x) + 0.08 * std::cos(2 * M_PI * x);
+                double arg = M_PI * cutoff * d;
+                double sinc = arg == 0.0 ? 1.0 : std::sin(arg) / arg;
+                h[k] = static_cast<float>(cutoff * sinc * window);
+                sum += h[k];
+            }
+            for (size_t k = 0; k < 2 * half_; ++k)
+                h[k] = static_cast<float>(h[k] / sum); // unity gain at DC for every phase
+        }
+        reset();
+    }
+
+    bool passthrough() const { return up_ == down_; }
+
+    // Forgets the carried-over input, e.g. when the source rewinds.
+    void reset()
+    {
+        history_.assign(half_, 0.0f); // zeros before the first sample
+        pos_ = half_;
+        frac_ = 0;
+    }
+
+    // Resamples `frames` input samples, appending the output to `out`.
+    void process(const float* in, size_t frames, std::vector<float>& out)
+    {
+        if (passthrough()) {
+            out.insert(out.end(), in, in + frames);
+            return;
+        }
+        history_.insert(history_.end(), in, in + frames);
+        while (pos_ + 1 - half_ + stride_ <= history_.size()) {
+            size_t phase = static_cast<size_t>(frac_ * phases_ / up_);
+            const float* h = &taps_[phase * stride_];
+            const float* x = &history_[pos_ + 1 - half_];
+            // kLanes independent sums: without -ffast-math the compiler may not reorder
+            // one float sum, but it does turn this into SIMD multiply-adds.
+            float acc[kLanes] = {};
+            for (size_t k = 0; k < stride_; k += kLanes)
+                for (size_t j = 0; j < kLanes; ++j)
+                    acc[j] += h[k + j] * x[k + j];
+            float sum = 0.0f;
+            for (size_t j = 0; j < kLanes; ++j)
+                sum += acc[j];
+            out.push_back(sum);
+            frac_ += down_;
+            pos_ += frac_ / up_;
+            frac_ %= up_;
+        }
+        // Keep only what the next output still needs.
+        size_t keep_from = std::min(pos_ + 1 - half_, history_.size());
+        history_.erase(history_.begin(), history_.begin() + keep_from);
+        pos_ -= keep_from;
+    }
+
+    // Pushes the tail of the input through the filter at the end of the stream.
+    void flush(std::vector<float>& out)
+    {
+        if (passthrough())
+            return;
+        std::vector<float> zeros(stride_ - half_, 0.0f);
+        process(zeros.data(), zeros.size(), out);
+    }
+
+private:
+    static constexpr double kZeroCrossings = 16.0; // per side at the input rate (upsampling)
+    static const uint64_t kMaxPhases = 1024;
+    static const size_t kLanes = 8;
+
+    uint64_t up_;   // L
+    uint64_t down_; // M
+    size_t half_;   // taps per side
+    size_t stride_; // 2 * half_ rounded up to kLanes
+    size_t phases_;
+    std::vector<float> taps_;
+    std::vector<float> history_;
+    size_t pos_;   // input index (into history_) of the next output
+    uint64_t frac_; // its fractional part, in 1/L
+};
+
+// Decodes, downmixes and resamples an audio file to 24 kHz S16 mono, block by block.
+class AudioFileReader
+{
+public:
+    AudioFileReader()
+        : pending_pos_(0)
+        , eof_(false)
+    {
+    }
+
+    // Detects the format from the first bytes: RIFF/WAVE is decoded directly,
+    // anything else through libsndfile when it is available.
+    bool open(const std::string& path)
+    {
+        FILE* probe = fopen(path.c_str(), "rb");
+        if (!probe) {
+            std::cerr << "Failed to open " << path << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        char magic[12] = {};
+        size_t n = fread(magic, 1, sizeof(magic), probe);
+        fclose(probe);
+        if (n == sizeof(magic) && std::memcmp(magic, "RIFF", 4) == 0 && std::memcmp(magic + 8, "WAVE", 4) == 0) {
+            std::unique_ptr<WavDecoder> wav(new WavDecoder());
+            if (!wav->open(path))
+                return false;
+            decoder_.reset(wav.release());
+        } else {
+#ifdef QUAD_SDK_WITH_SNDFILE
+            std::unique_ptr<SndfileDecoder> sndfile(new SndfileDecoder());
+            if (!sndfile->open(path))
+                return false;
+            decoder_.reset(sndfile.release());
+#else
+            std::cerr << path << ": built without libsndfile, only WAV files can be decoded "
+                      << "(convert with: python3 utils/audio_file_convert.py " << path << " out.wav)" << std::endl;
+            return false;
+#endif
+        }
+        resampler_.reset(new Resampler(decoder_->sample_rate(), kVoiceFileSampleRate));
+        decoded_.resize(kBlockFrames * decoder_->channels());
+        mono_.resize(kBlockFrames);
+        return true;
+    }
+
+    const AudioFileDecoder& decoder() const { return *decoder_; }
+
+    // Fills up to `samples` of 24 kHz mono output. Returns fewer only at the end of
+    // the file (0 once everything has been read).
+    size_t read(int16_t* out, size_t samples)
+    {
+        while (pending_.size() - pending_pos_ < samples && !eof_)
+            decode_block();
+        size_t n = std::min(samples, pending_.size() - pending_pos_);
+        for (size_t i = 0; i < n; ++i) {
+            float v = pending_[pending_pos_ + i] * 32768.0f;
+            out[i] = static_cast<int16_t>(std::lrint(std::min(std::max(v, -32768.0f), 32767.0f)));
+        }
+        pending_pos_ += n;
+        return n;
+    }
+
+    bool rewind()
+    {
+        if (!decoder_->rewind())
+            return false;
+        resampler_->reset();
+        pending_.clear();
+        pending_pos_ = 0;
+        eof_ = false;
+        return true;
+    }
+
+private:
+    static const size_t kBlockFrames = 4096;
+
+    void decode_block()
+    {
+        // Drop what has been handed out before appending, so pending_ stays small.
+        pending_.erase(pending_.begin(), pending_.begin() + pending_pos_);
+        pending_pos_ = 0;
+        size_t frames = decoder_->read(decoded_.data(), kBlockFrames);
+        if (frames == 0) {
+            resampler_->flush(pending_);
+            eof_ = true;
+            return;
+        }
+        unsigned channels = decoder_->channels();
+        if (channels == 1) {
+            resampler_->process(decoded_.data(), frames, pending_);
+            return;
+        }
+        float scale = 1.0f / channels;
+        for (size_t i = 0; i < frames; ++i) {
+            float sum = 0.0f;
+            for (unsigned c = 0; c < channels; ++c)
+                sum += decoded_[i * channels + c];
+            mono_[i] = sum * scale;
+        }
+        resampler_->process(mono_.data(), frames, pending_);
+    }
+
+    std::unique_ptr<AudioFileDecoder> decoder_;
+    std::unique_ptr<Resampler> resampler_;
+    std::vector<float> decoded_; // one block of interleaved frames
+    std::vector<float> mono_;
+    std::vector<float> pending_; // resampled, not yet read
+    size_t pending_pos_;
+    bool eof_;
+};
+
+} // namespace quad_sdk
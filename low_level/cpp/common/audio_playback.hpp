@@ -0,0 +1,241 @@
+#pragma once
+
+// Plays a JitterBuffer (common/jitter_buffer.hpp) out to a sink in fixed-size periods.
+//
+//   AlsaPlayback  an ALSA playback device ("default", "hw:0,0", ...). Needs libasound
+//                 and QUAD_SDK_WITH_ALSA.
+//   FileSink      a raw S16_LE file, or "|command" to pipe into a program such as aplay.
+//                 Writes are paced in real time, as a sound card would consume them.
+//
+// open_audio_sink() picks the sink from the target name.
+
+#include "common/jitter_buffer.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef QUAD_SDK_WITH_ALSA
+#include <alsa/asoundlib.h>
+#endif
+
+namespace quad_sdk {
+
+const unsigned kPlaybackSampleRate = 24000;
+
+class AudioSink
+{
+public:
+    virtual ~AudioSink() {}
+
+    // Blocks until the sink can take the next period. Returns false on a write error.
+    virtual bool write(const int16_t* pcm, size_t samples) = 0;
+
+    // Time from handing a sample to write() until it is heard.
+    virtual int64_t latency_ns() { return 0; }
+};
+
+#ifdef QUAD_SDK_WITH_ALSA
+class AlsaPlayback : public AudioSink
+{
+public:
+    AlsaPlayback()
+        : pcm_(nullptr)
+        , xruns_(0)
+    {
+    }
+
+    ~AlsaPlayback()
+    {
+        if (pcm_)
+            snd_pcm_close(pcm_);
+    }
+
+    // Opens `device` for S16_LE mono playback at 24 kHz with a three-period buffer;
+    // the jitter buffer, not the device, absorbs network jitter.
+    bool open(const std::string& device, size_t period_samples)
+    {
+        int err = snd_pcm_open(&pcm_, device.c_str(), SND_PCM_STREAM_PLAYBACK, 0);
+        if (err < 0) {
+            std::cerr << "Cannot open ALSA device " << device << ": " << snd_strerror(err) << std::endl;
+            pcm_ = nullptr;
+            return false;
+        }
+        unsigned latency_us = static_cast<unsigned>(period_samples * 3 * 1000000ULL / kPlaybackSampleRate);
+        err = snd_pcm_set_params(pcm_, SND_PCM_FORMAT_S16_LE, SND_PCM_ACCESS_RW_INTERLEAVED, 1, kPlaybackSampleRate,
+                                 1, latency_us);
+        if (err < 0) {
+            std::cerr << "Cannot configure " << device << " for 24 kHz S16_LE mono: " << snd_strerror(err)
+                      << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool write(const int16_t* pcm, size_t samples) override
+    {
+        while (samples > 0) {
+            snd_pcm_sframes_t n = snd_pcm_writei(pcm_, pcm, samples);
+            if (n == -EPIPE)
+                xruns_++;
+            if (n < 0) {
+                if (snd_pcm_recover(pcm_, static_cast<int>(n), 1) < 0) {
+                    std::cerr << "ALSA playback failed: " << snd_strerror(static_cast<int>(n)) << std::endl;
+                    return false;
+                }
+                continue;
+            }
+            pcm += n;
+            samples -= n;
+        }
+        return true;
+    }
+
+    int64_t latency_ns() override
+    {
+        snd_pcm_sframes_t delay = 0;
+        if (snd_pcm_delay(pcm_, &delay) < 0 || delay < 0)
+            return 0;
+        return static_cast<int64_t>(delay) * 1000000000LL / kPlaybackSampleRate;
+    }
+
+    // Device underruns: a period was not written in time.
+    uint64_t xruns() const { return xruns_; }
+
+private:
+    snd_pcm_t* pcm_;
+    std::atomic<uint64_t> xruns_;
+};
+#endif
+
+class FileSink : public AudioSink
+{
+public:
+    FileSink()
+        : file_(nullptr)
+        , pipe_(false)
+        , next_ns_(0)
+    {
+    }
+
+    ~FileSink()
+    {
+        if (file_)
+            pipe_ ? pclose(file_) : fclose(file_);
+    }
+
+    // `target` is a file path, or "|command" to write into the command's stdin.
+    bool open(const std::string& target)
+    {
+        pipe_ = !target.empty() && target[0] == '|';
+        file_ = pipe_ ? popen(target.c_str() + 1, "w") : fopen(target.c_str(), "wb");
+        if (!file_) {
+            std::cerr << "Failed to open " << target << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool write(const int16_t* pcm, size_t samples) override
+    {
+        if (fwrite(pcm, sizeof(int16_t), samples, file_) != samples)
+            return false;
+        fflush(file_);
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        int64_t now = static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+        int64_t period_ns = static_cast<int64_t>(samples) * 1000000000LL / kPlaybackSampleRate;
+        next_ns_ = (next_ns_ == 0 || now - next_ns_ > period_ns ? now : next_ns_) + period_ns;
+        ts.tv_sec = next_ns_ / 1000000000LL;
+        ts.tv_nsec = next_ns_ % 1000000000LL;
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+        return true;
+    }
+
+private:
+    FILE* file_;
+    bool pipe_;
+    int64_t next_ns_;
+};
+
+// "|command" and "*.pcm" / "*.raw" open a FileSink, anything else an ALSA device.
+// Returns nullptr (after printing why) when the sink cannot be opened.
+inline std::unique_ptr<AudioSink> open_audio_sink(const std::string& target, size_t period_samples)
+{
+    auto ends_with = [&target](const char* suffix) {
+        size_t n = std::strlen(suffix);
+        return target.size() > n && target.compare(target.size() - n, n, suffix) == 0;
+    };
+    if ((!target.empty() && target[0] == '|') || ends_with(".pcm") || ends_with(".raw")) {
+        std::unique_ptr<FileSink> file(new FileSink());
+        if (!file->open(target))
+            return nullptr;
+        return std::unique_ptr<AudioSink>(file.release());
+    }
+#ifdef QUAD_SDK_WITH_ALSA
+    std::unique_ptr<AlsaPlayback> alsa(new AlsaPlayback());
+    if (!alsa->open(target, period_samples))
+        return nullptr;
+    return std::unique_ptr<AudioSink>(alsa.release());
+#else
+    (void)period_samples;
+    std::cerr << "Built without ALSA: playback device " << target << " unavailable, use a .pcm file or \"|aplay ...\""
+              << std::endl;
+    return nullptr;
+#endif
+}
+
+// Pulls one period at a time from the jitter buffer into the sink on its own thread.
+class PlaybackEngine
+{
+public:
+    PlaybackEngine(JitterBuffer& buffer, AudioSink& sink, size_t period_samples)
+        : buffer_(buffer)
+        , sink_(sink)
+        , period_(period_samples)
+        , running_(false)
+    {
+    }
+
+    ~PlaybackEngine() { stop(); }
+
+    void start()
+    {
+        running_ = true;
+        thread_ = std::thread([this] {
+            while (running_) {
+                timespec ts;
+                clock_gettime(CLOCK_MONOTONIC, &ts);
+                int64_t now = static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+                buffer_.read(period_.data(), period_.size(), now + sink_.latency_ns());
+                if (!sink_.write(period_.data(), period_.size()))
+                    break;
+            }
+            running_ = false;
+        });
+    }
+
+    void stop()
+    {
+        running_ = false;
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    bool running() const { return running_; }
+
+private:
+    JitterBuffer& buffer_;
+    AudioSink& sink_;
+    std::vector<int16_t> period_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+};
+
+} // namespace quad_sdk
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <semaphore.h>
+#include <vector>
+
+namespace quad_sdk {
+
+// Single-producer / single-consumer ring of fixed-size audio periods.
+//
+// All period buffers are allocated in the constructor. The capture thread fills the
+// next free period in place (begin_write / commit), so the device reads straight into
+// the ring; the consumer blocks in wait_read() until a period is ready and hands it
+// back with release(). Nothing allocates or takes a lock after construction, and a
+// ready period wakes the consumer at once instead of on its next poll. When the
+// consumer falls behind and the ring is full, begin_write() returns nullptr and the
+// producer drops that period (counted in overruns()), so capture itself never stalls.
+class AudioRing
+{
+public:
+    AudioRing(size_t period_samples, size_t periods)
+        : period_samples_(period_samples)
+        , mask_(0)
+        , head_(0)
+        , tail_(0)
+        , overruns_(0)
+    {
+        size_t n = 1;
+        while (n < periods)
+            n <<= 1;
+        mask_ = n - 1;
+        samples_.resize(n * period_samples);
+        stamps_.resize(n);
+        sem_init(&ready_, 0, 0);
+    }
+
+    ~AudioRing() { sem_destroy(&ready_); }
+
+    AudioRing(const AudioRing&) = delete;
+    AudioRing& operator=(const AudioRing&) = delete;
+
+    size_t period_samples() const { return period_samples_; }
+    size_t capacity() const { return mask_ + 1; }
+
+    // Producer side. Returns the next free period, or nullptr (and counts an overrun)
+    // when the consumer has not released enough periods.
+    int16_t* begin_write()
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_) {
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &samples_[(tail & mask_) * period_samples_];
+    }
+
+    // Publishes the period returned by begin_write(). t_ns is the time its last sample
+    // was captured (CLOCK_MONOTONIC), handed to the consumer with the period.
+    void commit(int64_t t_ns)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        stamps_[tail & mask_] = t_ns;
+        tail_.store(tail + 1, std::memory_order_release);
+        sem_post(&ready_);
+    }
+
+    // Consumer side. Blocks until a period is ready or timeout_ms passes (then returns
+    // nullptr). The period stays valid until release().
+    const int16_t* wait_read(int timeout_ms, int64_t* t_ns = nullptr)
+    {
+        // The timeout runs on CLOCK_MONOTONIC, so a wall clock stepped back by NTP cannot
+        // stretch it (e7 checks Ctrl+C and end of file between waits).
+        timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 30))
+        while (sem_clockwait(&ready_, CLOCK_MONOTONIC, &deadline) != 0) {
+            if (errno != EINTR)
+                return nullptr;
+        }
+#else
+        // No sem_clockwait: poll against the monotonic deadline in 1 ms steps.
+        while (sem_trywait(&ready_) != 0) {
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if (now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec))
+                return nullptr;
+            timespec step = {0, 1000000L};
+            nanosleep(&step, nullptr);
+        }
+#endif
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (t_ns)
+            *t_ns = stamps_[head & mask_];
+        return &samples_[(head & mask_) * period_samples_];
+    }
+
+    void release() { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+    uint64_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+
+private:
+    size_t period_samples_;
+    size_t mask_;
+    std::vector<int16_t> samples_;
+    std::vector<int64_t> stamps_;
+    sem_t ready_; // counts committed, not yet read periods
+    alignas(64) std::atomic<size_t> head_; // next period to read, written by the consumer
+    alignas(64) std::atomic<size_t> tail_; // next period to write, written by the producer
+    std::atomic<uint64_t> overruns_;
+};
+
+} // namespace quad_sdk
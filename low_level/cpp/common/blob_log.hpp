@@ -0,0 +1,151 @@
+#pragma once
+
+// Append-only log of timestamped variable-size payloads (voice chunks and the like).
+//
+// File layout: 8-byte magic, then records of
+//   int64_t t_ns | uint32_t size | float aux | size bytes of payload
+// `aux` carries one scalar that travels with the payload (e.g. VoiceState_ angle).
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace quad_sdk {
+
+const char kBlobLogMagic[8] = {'Q', 'B', 'L', 'O', 'B', 'L', 'G', '1'};
+
+#pragma pack(push, 1)
+struct BlobRecordHeader
+{
+    int64_t t_ns;
+    uint32_t size;
+    float aux;
+};
+#pragma pack(pop)
+
+class BlobLogWriter
+{
+public:
+    BlobLogWriter()
+        : file_(nullptr)
+    {
+    }
+
+    ~BlobLogWriter() { close(); }
+
+    bool open(const std::string& path)
+    {
+        file_ = fopen(path.c_str(), "wb");
+        if (!file_) {
+            std::cerr << "Failed to create " << path << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        return fwrite(kBlobLogMagic, 1, sizeof(kBlobLogMagic), file_) == sizeof(kBlobLogMagic);
+    }
+
+    bool append(int64_t t_ns, const uint8_t* data, uint32_t size, float aux = 0.0f)
+    {
+        if (!file_)
+            return false;
+        BlobRecordHeader header;
+        header.t_ns = t_ns;
+        header.size = size;
+        header.aux = aux;
+        return fwrite(&header, sizeof(header), 1, file_) == 1 && fwrite(data, 1, size, file_) == size;
+    }
+
+    void close()
+    {
+        if (file_)
+            fclose(file_);
+        file_ = nullptr;
+    }
+
+private:
+    FILE* file_;
+};
+
+// Maps a blob log and indexes its records once on open.
+class BlobLogReader
+{
+public:
+    struct Record
+    {
+        int64_t t_ns;
+        float aux;
+        const uint8_t* data;
+        uint32_t size;
+    };
+
+    BlobLogReader()
+        : map_(nullptr)
+        , map_bytes_(0)
+    {
+    }
+
+    ~BlobLogReader()
+    {
+        if (map_)
+            munmap(const_cast<uint8_t*>(map_), map_bytes_);
+    }
+
+    bool open(const std::string& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(kBlobLogMagic)) {
+            std::cerr << "Failed to open blob log " << path << std::endl;
+            if (fd >= 0)
+                ::close(fd);
+            return false;
+        }
+        map_bytes_ = static_cast<size_t>(st.st_size);
+        void* p = mmap(nullptr, map_bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            std::cerr << "Failed to map blob log: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        map_ = static_cast<const uint8_t*>(p);
+        if (std::memcmp(map_, kBlobLogMagic, sizeof(kBlobLogMagic)) != 0) {
+            std::cerr << path << " is not a blob log" << std::endl;
+            return false;
+        }
+
+        // A record cut short by an unclean shutdown ends the index.
+        size_t offset = sizeof(kBlobLogMagic);
+        while (offset + sizeof(BlobRecordHeader) <= map_bytes_) {
+            BlobRecordHeader header;
+            std::memcpy(&header, map_ + offset, sizeof(header));
+            size_t payload = offset + sizeof(header);
+            if (payload + header.size > map_bytes_)
+                break;
+            Record record;
+            record.t_ns = header.t_ns;
+            record.aux = header.aux;
+            record.data = map_ + payload;
+            record.size = header.size;
+            records_.push_back(record);
+            offset = payload + header.size;
+        }
+        return true;
+    }
+
+    size_t size() const { return records_.size(); }
+    const Record& operator[](size_t i) const { return records_[i]; }
+
+private:
+    const uint8_t* map_;
+    size_t map_bytes_;
+    std::vector<Record> records_;
+};
+
+} // namespace quad_sdk
@@ -0,0 +1,55 @@
+#pragma once
+
+// Loaned-sample publish / in-place take helpers on top of the CycloneDDS C++ API.
+//
+// With shared memory enabled (cyclonedds_shm.xml + a running iox-roudi), a writer
+// whose type can be loaned hands out a sample that already lives in an iceoryx
+// chunk: the producer fills it in place and write() only passes ownership, so no
+// serialization and no copy happen on the same host. Types with variable-length
+// members (strings, sequences; e.g. Image_::data_ and CompressedImage_::data_) cannot
+// be loaned. For those publish_loaned() fills a reused sample and writes it
+// normally; Cyclone then serializes once straight into shared memory instead of
+// fragmenting the frame into 64 KB UDP datagrams over loopback.
+//
+// take_in_place() is the matching read side: the callback sees each sample in the
+// reader's loan (the shared-memory chunk when available) and must not keep a
+// reference after it returns.
+
+#include <dds/dds.hpp>
+
+namespace quad_sdk {
+
+// Publish one sample built by fill(T&). Returns true when a loan was used.
+// `scratch` is reused across calls when loans are unavailable, so steady-state
+// publishing does not reallocate the payload buffers.
+template <typename T, typename Fill>
+bool publish_loaned(dds::pub::DataWriter<T>& writer, T& scratch, Fill fill)
+{
+    if (writer.delegate()->is_loan_supported()) {
+        T& loaned = writer.delegate()->loan_sample();
+        fill(loaned);
+        writer.write(loaned);
+        return true;
+    }
+    fill(scratch);
+    writer.write(scratch);
+    return false;
+}
+
+// Take every available sample and hand valid ones to fn(const T&). Returns the
+// number of valid samples.
+template <typename T, typename Fn>
+size_t take_in_place(dds::sub::DataReader<T>& reader, Fn fn)
+{
+    size_t n = 0;
+    auto samples = reader.take();
+    for (auto it = samples.begin(); it != samples.end(); ++it) {
+        if (!it->info().valid())
+            continue;
+        fn(it->data());
+        n++;
+    }
+    return n;
+}
+
+} // namespace quad_sdk
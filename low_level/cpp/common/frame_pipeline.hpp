@@ -0,0 +1,102 @@
+#pragma once
+
+#include "frame_queue.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace quad_sdk {
+
+// Writes size bytes to path, adding the number written to *bytes_written.
+inline bool write_frame_file(const std::string& path, const uint8_t* data, size_t size, uint64_t* bytes_written)
+{
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    size_t written = fwrite(data, 1, size, f);
+    *bytes_written += written;
+    return fclose(f) == 0 && written == size;
+}
+
+// Camera callback -> worker threads hand-off shared by the image examples.
+//
+// The DDS callback acquires a frame, copies the sample into it and submits it;
+// each worker thread pops frames and runs its own copy of `worker`, so per-thread
+// scratch buffers (cv::Mat and the like) live in the Worker object and are reused.
+// Worker must be copyable and provide
+//   bool operator()(const Frame& frame, uint64_t* bytes_written);
+// returning false on a failed decode or write.
+template <typename Frame, typename Worker>
+class FramePipeline
+{
+public:
+    FramePipeline(const Worker& worker, int num_workers, size_t queue_depth)
+        : queue_(queue_depth)
+        , received_(0)
+        , processed_(0)
+        , rejected_(0)
+        , errors_(0)
+        , bytes_written_(0)
+    {
+        for (int i = 0; i < num_workers; ++i)
+            workers_.push_back(std::thread(&FramePipeline::run, this, worker));
+    }
+
+    ~FramePipeline()
+    {
+        queue_.close();
+        for (auto& t : workers_)
+            t.join();
+    }
+
+    // Callback side: a free frame to fill and submit(), or nullptr if none is free
+    // (counted as dropped by the queue).
+    Frame* acquire()
+    {
+        received_++;
+        return queue_.acquire();
+    }
+
+    void submit(Frame* frame) { queue_.submit(frame); }
+
+    // Callback side: a sample that failed validation and was not queued.
+    void reject()
+    {
+        received_++;
+        rejected_++;
+    }
+
+    void printStats(std::ostream& os, const char* name) const
+    {
+        os << name << " frames received=" << received_ << " processed=" << processed_ << " dropped=" << queue_.dropped()
+           << " rejected=" << rejected_ << " errors=" << errors_ << " written=" << bytes_written_ / 1024
+           << " KiB queued=" << queue_.queued() << std::endl;
+    }
+
+private:
+    void run(Worker worker)
+    {
+        while (Frame* frame = queue_.pop()) {
+            uint64_t bytes = 0;
+            if (!worker(*frame, &bytes))
+                errors_++;
+            bytes_written_ += bytes;
+            processed_++;
+            queue_.release(frame);
+        }
+    }
+
+    FrameQueue<Frame> queue_;
+    std::vector<std::thread> workers_;
+    std::atomic<uint64_t> received_;
+    std::atomic<uint64_t> processed_;
+    std::atomic<uint64_t> rejected_;
+    std::atomic<uint64_t> errors_;
+    std::atomic<uint64_t> bytes_written_;
+};
+
+} // namespace quad_sdk
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace quad_sdk {
+
+// Bounded hand-off queue over a fixed pool of preallocated frames.
+//
+// The DDS callback acquires a free frame, fills it (reusing whatever buffers the
+// frame already owns) and submits it; worker threads pop frames, process them and
+// release them back to the pool. No frame is ever allocated after construction.
+// When every frame is queued and none is free, acquire() recycles the oldest queued
+// frame and counts it as dropped, so a slow consumer costs freshness, not latency,
+// and never blocks the producer.
+template <typename Frame>
+class FrameQueue
+{
+public:
+    explicit FrameQueue(size_t capacity)
+        : frames_(capacity)
+        , ready_(capacity)
+        , ready_head_(0)
+        , ready_count_(0)
+        , closed_(false)
+        , dropped_(0)
+    {
+        free_.reserve(capacity);
+        for (size_t i = 0; i < capacity; ++i)
+            free_.push_back(&frames_[i]);
+    }
+
+    // Producer side. Never blocks; returns nullptr only if every frame is currently
+    // held by a worker.
+    Frame* acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            Frame* frame = free_.back();
+            free_.pop_back();
+            return frame;
+        }
+        dropped_++;
+        return ready_count_ ? pop_ready() : nullptr;
+    }
+
+    void submit(Frame* frame)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_[(ready_head_ + ready_count_) % ready_.size()] = frame;
+            ready_count_++;
+        }
+        cond_.notify_one();
+    }
+
+    // Return a frame that was acquired but not submitted (e.g. failed validation).
+    void release(Frame* frame)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(frame);
+    }
+
+    // Consumer side. Blocks until a frame is ready; returns nullptr once closed and drained.
+    Frame* pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return closed_ || ready_count_ > 0; });
+        return ready_count_ ? pop_ready() : nullptr;
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        cond_.notify_all();
+    }
+
+    // Frames recycled (or refused) because the consumers fell behind.
+    uint64_t dropped() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+    }
+
+    size_t queued() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ready_count_;
+    }
+
+private:
+    Frame* pop_ready()
+    {
+        Frame* frame = ready_[ready_head_];
+        ready_head_ = (ready_head_ + 1) % ready_.size();
+        ready_count_--;
+        return frame;
+    }
+
+    std::vector<Frame> frames_;
+    std::vector<Frame*> free_;
+    std::vector<Frame*> ready_; // ring of submitted frames, oldest at ready_head_
+    size_t ready_head_;
+    size_t ready_count_;
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    bool closed_;
+    uint64_t dropped_;
+};
+
+} // namespace quad_sdk
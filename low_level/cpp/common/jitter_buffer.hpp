@@ -0,0 +1,373 @@
+#pragma once
+
+#include "common/latency_histogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace quad_sdk {
+
+struct JitterBufferConfig
+{
+    int sample_rate = 24000;
+    size_t max_packet_samples = 9600; // 400 ms at 24 kHz; longer packets are truncated
+    size_t capacity = 32;             // packets held at once (rounded up to a power of two)
+    int initial_delay_ms = 120;       // target delay before any jitter has been measured
+    int min_delay_ms = 20;
+    int max_delay_ms = 500;
+    bool adaptive = true; // false keeps the target at initial_delay_ms
+};
+
+struct JitterBufferStats
+{
+    double depth_ms = 0.0;  // audio buffered right now
+    double target_ms = 0.0; // playout delay on top of the fastest transit
+    double jitter_ms = 0.0; // RFC 3550 inter-arrival jitter estimate
+    uint64_t received = 0;  // packets accepted
+    uint64_t late = 0;      // packets that arrived after their playout time (dropped)
+    uint64_t lost = 0;      // packets never received in time, concealed
+    uint64_t underruns = 0; // times the buffer ran dry and had to rebuffer
+    uint64_t overflows = 0; // packets discarded because the buffer was full
+    double concealed_ms = 0.0;
+    double dropped_ms = 0.0; // audio skipped to get back on schedule
+    LatencyHistogram delay;  // per packet: arrival (or capture, when known) -> playout
+};
+
+// Receive-side jitter buffer for chunked 16-bit mono PCM.
+//
+// Packets are pushed with a sequence number from the network thread and played out
+// from the audio thread in fixed-size blocks (read()). Out-of-order packets are put
+// back in order; a packet still missing when its turn comes is concealed (the last
+// 10 ms repeated while fading out) and counted lost, and if it shows up afterwards it
+// is counted late and dropped.
+//
+// Each packet has a playout time: its position in the stream plus the fastest transit
+// seen over the last few seconds plus the target delay. When the buffer runs dry,
+// read() conceals, then plays silence until the oldest buffered packet's playout time.
+// When playback has fallen behind schedule instead (a burst after a stall, or a target
+// that has since come down), the lag is skipped at the next packet boundary.
+//
+// The target delay adapts to the network. Every arrival updates the RFC 3550 jitter
+// estimate and a peak-hold of how late packets arrive relative to the fastest one; the
+// target is the larger of 3x jitter and that peak, clamped to [min, max]. The peak
+// decays slowly, so one Wi-Fi stall raises the target at once and it only creeps back
+// down over the following seconds.
+//
+// Packets of one stream are expected to have the same length.
+//
+// All storage is allocated in the constructor; push() and read() only take a short
+// lock and never allocate.
+class JitterBuffer
+{
+public:
+    explicit JitterBuffer(const JitterBufferConfig& config = JitterBufferConfig())
+        : config_(config)
+        , mask_(0)
+        , history_(kConcealSamples)
+    {
+        size_t n = 1;
+        while (n < config_.capacity)
+            n <<= 1;
+        mask_ = n - 1;
+        slots_.resize(n);
+        for (auto& slot : slots_)
+            slot.samples.resize(config_.max_packet_samples);
+        reset();
+    }
+
+    // Forget all packets and measurements, e.g. when the source restarts.
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& slot : slots_)
+            slot.valid = false;
+        started_ = false;
+        rebuffering_ = true;
+        next_seq_ = 0;
+        offset_ = 0;
+        buffered_samples_ = 0;
+        packet_samples_ = 0;
+        conceal_remaining_ = 0;
+        conceal_pos_ = 0;
+        history_fill_ = 0;
+        have_transit_ = false;
+        transit_ns_ = 0.0;
+        min_transit_ns_ = 0.0;
+        window_min_ns_ = 0.0;
+        window_start_ns_ = 0;
+        jitter_ns_ = 0.0;
+        peak_late_ns_ = 0.0;
+        target_ns_ = config_.initial_delay_ms * 1e6;
+        stats_ = JitterBufferStats();
+    }
+
+    // Network side. `seq` increases by one per packet of the stream. capture_ns is the
+    // sender's capture time on this host's CLOCK_MONOTONIC if known (0 otherwise); it
+    // makes the reported delay end to end instead of arrival -> playout.
+    void push(uint64_t seq, const int16_t* pcm, size_t samples, int64_t arrival_ns, int64_t capture_ns = 0)
+    {
+        samples = std::min(samples, config_.max_packet_samples);
+        if (samples == 0)
+            return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!started_) {
+            started_ = true;
+            next_seq_ = seq;
+        }
+        int64_t ahead = static_cast<int64_t>(seq - next_seq_);
+        if (ahead < 0 || (ahead == 0 && offset_ > 0)) {
+            stats_.late++;
+            return;
+        }
+        while (static_cast<uint64_t>(ahead) > mask_) { // too far ahead: give up the oldest
+            drop_slot(next_seq_);
+            next_seq_++;
+            offset_ = 0;
+            ahead--;
+            stats_.overflows++;
+        }
+        Slot& slot = slots_[seq & mask_];
+        if (slot.valid && slot.seq == seq)
+            return; // duplicate
+        update_jitter(seq, samples, arrival_ns);
+        std::memcpy(slot.samples.data(), pcm, samples * sizeof(int16_t));
+        slot.seq = seq;
+        slot.size = samples;
+        slot.arrival_ns = arrival_ns;
+        slot.capture_ns = capture_ns;
+        slot.valid = true;
+        buffered_samples_ += samples;
+        packet_samples_ = samples;
+        stats_.received++;
+    }
+
+    // Audio side. Fills `samples` of output for a block that starts playing at
+    // play_ns (now plus the sink's own latency). Returns false while (re)buffering,
+    // when the block is silence.
+    bool read(int16_t* out, size_t samples, int64_t play_ns)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (rebuffering_) {
+            // Playback (re)starts at the oldest packet's playout time.
+            while (buffered_samples_ > 0 && !slot_ready(next_seq_)) {
+                stats_.lost++;
+                next_seq_++;
+            }
+            if (buffered_samples_ == 0 || play_ns < playout_ns(next_seq_)) {
+                conceal(out, samples);
+                return false;
+            }
+            rebuffering_ = false;
+            conceal_remaining_ = 0;
+        }
+        size_t produced = 0;
+        while (produced < samples) {
+            if (conceal_remaining_ > 0) {
+                size_t n = std::min(samples - produced, conceal_remaining_);
+                conceal(out + produced, n);
+                conceal_remaining_ -= n;
+                produced += n;
+                continue;
+            }
+            if (slot_ready(next_seq_)) {
+                Slot& slot = slots_[next_seq_ & mask_];
+                if (offset_ == 0) {
+                    catch_up(play_ns + to_ns(produced));
+                    if (!slot_ready(next_seq_))
+                        continue;
+                    int64_t from = slot.capture_ns ? slot.capture_ns : slot.arrival_ns;
+                    stats_.delay.record_signed(play_ns + to_ns(produced) - from);
+                }
+                size_t n = std::min(samples - produced, slot.size - offset_);
+                std::memcpy(out + produced, slot.samples.data() + offset_, n * sizeof(int16_t));
+                remember(out + produced, n);
+                offset_ += n;
+                produced += n;
+                buffered_samples_ -= n;
+                conceal_pos_ = 0;
+                if (offset_ == slot.size) {
+                    slot.valid = false;
+                    next_seq_++;
+                    offset_ = 0;
+                }
+            } else if (buffered_samples_ > 0) {
+                // Later packets are here but this one is not: it is lost (or too late).
+                stats_.lost++;
+                stats_.concealed_ms += to_ns(packet_samples_) / 1e6;
+                conceal_remaining_ = packet_samples_;
+                next_seq_++;
+            } else {
+                stats_.underruns++;
+                stats_.concealed_ms += to_ns(samples - produced) / 1e6;
+                conceal(out + produced, samples - produced);
+                rebuffering_ = true;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    JitterBufferStats stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        JitterBufferStats stats = stats_;
+        stats.depth_ms = to_ns(buffered_samples_) / 1e6;
+        stats.target_ms = target_ns_ / 1e6;
+        stats.jitter_ms = jitter_ns_ / 1e6;
+        return stats;
+    }
+
+    // Clears the delay histogram, e.g. after printing it.
+    void reset_delay()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.delay.reset();
+    }
+
+private:
+    static const size_t kConcealSamples = 240; // 10 ms at 24 kHz, repeated while fading out
+    static const size_t kFadeSamples = 480;    // concealment fades to silence over 20 ms
+
+    struct Slot
+    {
+        std::vector<int16_t> samples;
+        uint64_t seq = 0;
+        size_t size = 0;
+        int64_t arrival_ns = 0;
+        int64_t capture_ns = 0;
+        bool valid = false;
+    };
+
+    int64_t to_ns(size_t samples) const { return static_cast<int64_t>(samples) * 1000000000LL / config_.sample_rate; }
+    size_t to_samples(double ns) const { return static_cast<size_t>(ns * config_.sample_rate / 1e9); }
+
+    bool slot_ready(uint64_t seq) const
+    {
+        const Slot& slot = slots_[seq & mask_];
+        return slot.valid && slot.seq == seq;
+    }
+
+    void drop_slot(uint64_t seq)
+    {
+        Slot& slot = slots_[seq & mask_];
+        if (slot.valid && slot.seq == seq) {
+            buffered_samples_ -= slot.size - (seq == next_seq_ ? offset_ : 0);
+            slot.valid = false;
+        }
+    }
+
+    // RFC 3550 jitter over the packet's transit time (arrival minus its position in the
+    // stream), plus a peak-hold of lateness relative to the fastest packet. The fastest
+    // transit is the minimum over the current and the previous window, so a route change
+    // or a miscounted sequence number is forgotten after at most two windows.
+    void update_jitter(uint64_t seq, size_t samples, int64_t arrival_ns)
+    {
+        double transit = arrival_ns - static_cast<double>(seq) * to_ns(samples);
+        if (!have_transit_) {
+            transit_ns_ = min_transit_ns_ = window_min_ns_ = transit;
+            window_start_ns_ = arrival_ns;
+            have_transit_ = true;
+        }
+        jitter_ns_ += (std::fabs(transit - transit_ns_) - jitter_ns_) / 16.0;
+        transit_ns_ = transit;
+        if (arrival_ns - window_start_ns_ >= kTransitWindowNs) {
+            min_transit_ns_ = std::min(window_min_ns_, transit);
+            window_min_ns_ = transit;
+            window_start_ns_ = arrival_ns;
+        } else {
+            window_min_ns_ = std::min(window_min_ns_, transit);
+            min_transit_ns_ = std::min(min_transit_ns_, transit);
+        }
+        peak_late_ns_ = std::max(peak_late_ns_ * std::exp(-to_ns(samples) / kPeakDecayNs), transit - min_transit_ns_);
+        if (config_.adaptive) {
+            double target = std::max(3.0 * jitter_ns_, peak_late_ns_);
+            target_ns_ = std::min(std::max(target, config_.min_delay_ms * 1e6), config_.max_delay_ms * 1e6);
+        }
+    }
+
+    double playout_ns(uint64_t seq) const
+    {
+        return static_cast<double>(seq) * to_ns(packet_samples_) + min_transit_ns_ + target_ns_;
+    }
+
+    // Called when packet next_seq_ is about to start at start_ns. If that is more than
+    // kCatchUpNs behind its playout time, skips whole buffered packets and then the
+    // start of the current one to get back on schedule.
+    void catch_up(int64_t start_ns)
+    {
+        double behind = start_ns - playout_ns(next_seq_);
+        if (behind < kCatchUpNs)
+            return;
+        while (behind >= to_ns(slots_[next_seq_ & mask_].size) && slot_ready(next_seq_ + 1)) {
+            Slot& slot = slots_[next_seq_ & mask_];
+            behind -= to_ns(slot.size);
+            buffered_samples_ -= slot.size;
+            stats_.dropped_ms += to_ns(slot.size) / 1e6;
+            slot.valid = false;
+            next_seq_++;
+        }
+        const Slot& slot = slots_[next_seq_ & mask_];
+        size_t n = std::min(to_samples(behind), slot.size - 1);
+        offset_ = n;
+        buffered_samples_ -= n;
+        stats_.dropped_ms += to_ns(n) / 1e6;
+    }
+
+    void remember(const int16_t* pcm, size_t samples)
+    {
+        for (size_t i = 0; i < samples; ++i)
+            history_[(history_fill_ + i) % kConcealSamples] = pcm[i];
+        history_fill_ = (history_fill_ + samples) % kConcealSamples;
+    }
+
+    // Repeats the last 10 ms played, fading to silence over kFadeSamples.
+    void conceal(int16_t* out, size_t samples)
+    {
+        for (size_t i = 0; i < samples; ++i, ++conceal_pos_) {
+            if (conceal_pos_ >= kFadeSamples) {
+                out[i] = 0;
+                continue;
+            }
+            float gain = 1.0f - static_cast<float>(conceal_pos_) / kFadeSamples;
+            out[i] = static_cast<int16_t>(history_[(history_fill_ + conceal_pos_) % kConcealSamples] * gain);
+        }
+    }
+
+    static constexpr double kTransitWindowNs = 5e9; // fastest-transit window
+    static constexpr double kPeakDecayNs = 10e9;    // lateness peak time constant
+    static constexpr double kCatchUpNs = 30e6;      // lag tolerated before skipping audio
+
+    JitterBufferConfig config_;
+    size_t mask_;
+    std::vector<Slot> slots_;
+    std::vector<int16_t> history_;
+    mutable std::mutex mutex_;
+
+    bool started_;
+    bool rebuffering_;
+    uint64_t next_seq_;
+    size_t offset_; // samples of slot next_seq_ already played
+    size_t buffered_samples_;
+    size_t packet_samples_; // size of the latest packet, used for concealment
+    size_t conceal_remaining_;
+    size_t conceal_pos_;
+    size_t history_fill_;
+
+    bool have_transit_;
+    double transit_ns_;
+    double min_transit_ns_;
+    double window_min_ns_;
+    int64_t window_start_ns_;
+    double jitter_ns_;
+    double peak_late_ns_;
+    double target_ns_;
+
+    JitterBufferStats stats_;
+};
+
+} // namespace quad_sdk
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <string>
+
+namespace quad_sdk {
+
+// Fixed-size log-linear histogram for nanosecond latencies.
+// Every power-of-two range is split into 16 linear sub-buckets, so the reported
+// percentiles are within ~6% of the true value. record() never allocates and is
+// safe to call from a real-time loop; the histogram itself is not thread-safe.
+class LatencyHistogram
+{
+public:
+    static const int kSubBucketBits = 4;
+    static const int kSubBuckets = 1 << kSubBucketBits;
+    static const int kNumBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    LatencyHistogram() { reset(); }
+
+    void reset()
+    {
+        buckets_.fill(0);
+        count_ = 0;
+        sum_ = 0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+    }
+
+    void record(uint64_t value_ns)
+    {
+        buckets_[bucket_index(value_ns)]++;
+        count_++;
+        sum_ += value_ns;
+        min_ = std::min(min_, value_ns);
+        max_ = std::max(max_, value_ns);
+    }
+
+    // Record a signed sample, clamping negative values to zero.
+    void record_signed(int64_t value_ns) { record(value_ns > 0 ? static_cast<uint64_t>(value_ns) : 0); }
+
+    void merge(const LatencyHistogram& other)
+    {
+        for (int i = 0; i < kNumBuckets; ++i)
+            buckets_[i] += other.buckets_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    // Upper bound of the bucket holding the given percentile (0-100).
+    uint64_t percentile(double p) const
+    {
+        if (count_ == 0)
+            return 0;
+        uint64_t target = static_cast<uint64_t>(p / 100.0 * count_ + 0.5);
+        target = std::max<uint64_t>(1, std::min(target, count_));
+        uint64_t seen = 0;
+        for (int i = 0; i < kNumBuckets; ++i) {
+            seen += buckets_[i];
+            if (seen >= target)
+                return std::min(bucket_upper(i), max_);
+        }
+        return max_;
+    }
+
+    // One-line summary in microseconds: n, mean, p50, p99, p99.9, max.
+    void print(std::ostream& os, const std::string& label) const
+    {
+        std::ios::fmtflags flags = os.flags();
+        std::streamsize precision = os.precision();
+        os << std::fixed << std::setprecision(1) << label << ": n=" << count_ << " mean=" << mean() / 1e3
+           << "us p50=" << percentile(50.0) / 1e3 << "us p99=" << percentile(99.0) / 1e3
+           << "us p99.9=" << percentile(99.9) / 1e3 << "us max=" << max() / 1e3 << "us" << std::endl;
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+private:
+    static int bucket_index(uint64_t v)
+    {
+        if (v < static_cast<uint64_t>(kSubBuckets))
+            return static_cast<int>(v);
+        int msb = 63 - __builtin_clzll(v);
+        int shift = msb - kSubBucketBits;
+        return (shift + 1) * kSubBuckets + static_cast<int>((v >> shift) & (kSubBuckets - 1));
+    }
+
+    static uint64_t bucket_upper(int index)
+    {
+        if (index < kSubBuckets)
+            return static_cast<uint64_t>(index);
+        int shift = index / kSubBuckets - 1;
+        uint64_t sub = static_cast<uint64_t>(index % kSubBuckets);
+        uint64_t lower = (static_cast<uint64_t>(kSubBuckets) + sub) << shift;
+        return lower + ((1ULL << shift) - 1);
+    }
+
+    std::array<uint64_t, kNumBuckets> buckets_;
+    uint64_t count_;
+    uint64_t sum_;
+    uint64_t min_;
+    uint64_t max_;
+};
+
+} // namespace quad_sdk
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "lower_cmd.hpp"
+#include <array>
+#include <cstdint>
+
+namespace quad_sdk {
+
+const int kNumMotors = 16; // hardware motor slots in LowerCmd_/LowerState_
+const int kNumJoints = 12; // actuated leg joints, 3 per leg
+
+// Leg joint index (0-11) -> hardware motor slot. Each leg owns four slots and the
+// fourth one is unused, giving {0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14}.
+constexpr int abs2Hw(int joint)
+{
+    return (joint / 3) * 4 + joint % 3;
+}
+
+static_assert(abs2Hw(0) == 0 && abs2Hw(3) == 4 && abs2Hw(11) == 14, "unexpected joint map");
+
+// Owns one preallocated LowerCmd_ for a command stream and lets the control loop
+// patch only the fields that change between cycles. Everything that stays fixed
+// (mode, gains, offsets) is written once, so the hot path is a handful of float
+// stores into the existing message followed by publish(builder.cmd()).
+class LowerCmdBuilder
+{
+public:
+    // motor_offset is added to every position target, matching the robot's zero pose.
+    explicit LowerCmdBuilder(const std::array<double, kNumMotors>& motor_offset = std::array<double, kNumMotors>())
+        : offset_(motor_offset)
+    {
+    }
+
+    // Set mode/gains/feed-forward on every leg joint. Call once per stream, or when
+    // switching control modes, not every cycle.
+    LowerCmdBuilder& set_all(uint8_t mode, float kp, float kd, float dq = 0.0f, float tau = 0.0f)
+    {
+        for (int j = 0; j < kNumJoints; ++j) {
+            dobotmh4::msg::dds_::MotorCmd_& m = motor(j);
+            m.mode(mode);
+            m.dq(dq);
+            m.tau(tau);
+            m.kp(kp);
+            m.kd(kd);
+        }
+        return *this;
+    }
+
+    // Position target in joint space; the motor offset is applied here.
+    void set_q(int joint, double q) { motor(joint).q(static_cast<float>(q + offset_[abs2Hw(joint)])); }
+    void set_dq(int joint, float dq) { motor(joint).dq(dq); }
+    void set_tau(int joint, float tau) { motor(joint).tau(tau); }
+    void set_gains(int joint, float kp, float kd)
+    {
+        motor(joint).kp(kp);
+        motor(joint).kd(kd);
+    }
+
+    // Compile-time joint index: out-of-range joints fail to build.
+    template <int Joint>
+    void set_q(double q)
+    {
+        static_assert(Joint >= 0 && Joint < kNumJoints, "joint index out of range");
+        cmd_.motor_cmd()[abs2Hw(Joint)].q(static_cast<float>(q + offset_[abs2Hw(Joint)]));
+    }
+
+    dobotmh4::msg::dds_::MotorCmd_& motor(int joint) { return cmd_.motor_cmd()[abs2Hw(joint)]; }
+
+    const dobotmh4::msg::dds_::LowerCmd_& cmd() const { return cmd_; }
+
+private:
+    dobotmh4::msg::dds_::LowerCmd_ cmd_;
+    std::array<double, kNumMotors> offset_;
+};
+
+} // namespace quad_sdk
@@ -0,0 +1,210 @@
+#pragma once
+
+// Opus compression for rt/voice/cmd streaming audio.
+//
+// A VoiceCmd_ with type "opus" carries 24 kHz mono audio as a run of Opus packets,
+// each prefixed by its length:
+//   uint16_t size (little endian) | size bytes of Opus packet | uint16_t size | ...
+// One packet is one frame_ms frame, so a message holds chunk_ms / frame_ms packets.
+// Speech at 24 kbit/s is about 3 KB/s against 48 KB/s for "streaming" S16_LE PCM.
+//
+// Requires libopus (link with -lopus).
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <opus/opus.h>
+#include <string>
+#include <vector>
+
+namespace quad_sdk {
+
+const char kVoiceTypeOpus[] = "opus";
+const int kVoiceSampleRate = 24000;
+
+class OpusVoiceEncoder
+{
+public:
+    // frame_ms must be an Opus frame size: 10, 20, 40 or 60 (2.5 and 5 are not
+    // accepted here). Check ok() after construction.
+    explicit OpusVoiceEncoder(int bitrate_bps = 24000, int frame_ms = 20, int complexity = 5)
+        : encoder_(nullptr)
+        , frame_samples_(kVoiceSampleRate * frame_ms / 1000)
+        , pending_(0)
+        , packet_(kMaxPacket)
+    {
+        int error = OPUS_OK;
+        if (frame_ms != 10 && frame_ms != 20 && frame_ms != 40 && frame_ms != 60) {
+            std::cerr << "Opus frame_ms must be 10, 20, 40 or 60, got " << frame_ms << std::endl;
+            return;
+        }
+        encoder_ = opus_encoder_create(kVoiceSampleRate, 1, OPUS_APPLICATION_VOIP, &error);
+        if (error != OPUS_OK) {
+            std::cerr << "opus_encoder_create failed: " << opus_strerror(error) << std::endl;
+            encoder_ = nullptr;
+            return;
+        }
+        opus_encoder_ctl(encoder_, OPUS_SET_BITRATE(bitrate_bps));
+        opus_encoder_ctl(encoder_, OPUS_SET_COMPLEXITY(complexity));
+        opus_encoder_ctl(encoder_, OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE));
+        frame_.resize(frame_samples_);
+    }
+
+    ~OpusVoiceEncoder()
+    {
+        if (encoder_)
+            opus_encoder_destroy(encoder_);
+    }
+
+    OpusVoiceEncoder(const OpusVoiceEncoder&) = delete;
+    OpusVoiceEncoder& operator=(const OpusVoiceEncoder&) = delete;
+
+    bool ok() const { return encoder_ != nullptr; }
+    int frame_samples() const { return frame_samples_; }
+
+    // Samples the decoder output lags the input by (encoder lookahead).
+    int lookahead_samples() const
+    {
+        opus_int32 lookahead = 0;
+        if (encoder_)
+            opus_encoder_ctl(encoder_, OPUS_GET_LOOKAHEAD(&lookahead));
+        return lookahead;
+    }
+
+    // Encodes every complete frame of the buffered plus new samples and appends the
+    // packets to `out`. A trailing partial frame is kept for the next call, so capture
+    // chunks need not be a multiple of the frame size. Returns the number of packets
+    // appended, or -1 on an encoder error.
+    int encode(const int16_t* pcm, size_t samples, std::vector<uint8_t>& out)
+    {
+        if (!encoder_)
+            return -1;
+        int packets = 0;
+        while (samples > 0) {
+            size_t take = std::min(samples, static_cast<size_t>(frame_samples_ - pending_));
+            std::copy(pcm, pcm + take, frame_.begin() + pending_);
+            pending_ += static_cast<int>(take);
+            pcm += take;
+            samples -= take;
+            if (pending_ < frame_samples_)
+                break;
+            if (!encode_frame(out))
+                return -1;
+            packets++;
+        }
+        return packets;
+    }
+
+    // Pads a trailing partial frame with silence and encodes it (end of stream).
+    int flush(std::vector<uint8_t>& out)
+    {
+        if (!encoder_ || pending_ == 0)
+            return 0;
+        std::fill(frame_.begin() + pending_, frame_.end(), 0);
+        pending_ = frame_samples_;
+        return encode_frame(out) ? 1 : -1;
+    }
+
+private:
+    static const int kMaxPacket = 1275; // largest Opus packet for one frame
+
+    bool encode_frame(std::vector<uint8_t>& out)
+    {
+        pending_ = 0;
+        opus_int32 size = opus_encode(encoder_, frame_.data(), frame_samples_, packet_.data(), kMaxPacket);
+        if (size < 0) {
+            std::cerr << "opus_encode failed: " << opus_strerror(size) << std::endl;
+            return false;
+        }
+        out.push_back(static_cast<uint8_t>(size & 0xff));
+        out.push_back(static_cast<uint8_t>(size >> 8));
+        out.insert(out.end(), packet_.begin(), packet_.begin() + size);
+        return true;
+    }
+
+    OpusEncoder* encoder_;
+    int frame_samples_;
+    int pending_; // samples buffered in frame_
+    std::vector<opus_int16> frame_;
+    std::vector<uint8_t> packet_;
+};
+
+class OpusVoiceDecoder
+{
+public:
+    OpusVoiceDecoder()
+        : decoder_(nullptr)
+    {
+        int error = OPUS_OK;
+        decoder_ = opus_decoder_create(kVoiceSampleRate, 1, &error);
+        if (error != OPUS_OK) {
+            std::cerr << "opus_decoder_create failed: " << opus_strerror(error) << std::endl;
+            decoder_ = nullptr;
+        }
+        frame_.resize(kMaxFrameSamples);
+    }
+
+    ~OpusVoiceDecoder()
+    {
+        if (decoder_)
+            opus_decoder_destroy(decoder_);
+    }
+
+    OpusVoiceDecoder(const OpusVoiceDecoder&) = delete;
+    OpusVoiceDecoder& operator=(const OpusVoiceDecoder&) = delete;
+
+    bool ok() const { return decoder_ != nullptr; }
+
+    // Decodes every packet of one "opus" VoiceCmd_ payload and appends the 24 kHz
+    // samples to `pcm`. Stops at the first truncated or corrupt packet and returns false;
+    // the samples decoded before it are kept.
+    bool decode(const uint8_t* data, size_t size, std::vector<int16_t>& pcm)
+    {
+        if (!decoder_)
+            return false;
+        size_t pos = 0;
+        while (pos < size) {
+            if (size - pos < 2)
+                return false;
+            size_t packet = data[pos] | (static_cast<size_t>(data[pos + 1]) << 8);
+            pos += 2;
+            if (packet > size - pos)
+                return false;
+            int samples = opus_decode(decoder_, data + pos, static_cast<opus_int32>(packet), frame_.data(),
+                                      kMaxFrameSamples, 0);
+            if (samples < 0) {
+                std::cerr << "opus_decode failed: " << opus_strerror(samples) << std::endl;
+                return false;
+            }
+            pcm.insert(pcm.end(), frame_.begin(), frame_.begin() + samples);
+            pos += packet;
+        }
+        return true;
+    }
+
+    // Packet loss concealment: synthesizes `samples` of audio (a multiple of 2.5 ms) to
+    // cover a gap.
+    bool conceal(int samples, std::vector<int16_t>& pcm)
+    {
+        if (!decoder_)
+            return false;
+        while (samples > 0) {
+            int want = samples < kMaxFrameSamples ? samples : kMaxFrameSamples;
+            int n = opus_decode(decoder_, nullptr, 0, frame_.data(), want, 0);
+            if (n <= 0)
+                return false;
+            pcm.insert(pcm.end(), frame_.begin(), frame_.begin() + n);
+            samples -= n;
+        }
+        return true;
+    }
+
+private:
+    static const int kMaxFrameSamples = kVoiceSampleRate * 120 / 1000; // longest Opus packet
+
+    OpusDecoder* decoder_;
+    std::vector<opus_int16> frame_;
+};
+
+} // namespace quad_sdk
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "common/latency_histogram.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <ostream>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+
+namespace quad_sdk {
+
+struct PeriodicExecutorConfig
+{
+    int64_t period_ns = 2000000; // 500 Hz
+    int rt_priority = 0;         // SCHED_FIFO priority (1-99), 0 keeps the default scheduler
+    int cpu = -1;                // CPU to pin the loop thread to, -1 leaves affinity unchanged
+    bool lock_memory = false;    // mlockall() so page faults cannot stall the loop
+};
+
+// Runs a callback on an absolute-deadline schedule using clock_nanosleep(TIMER_ABSTIME).
+// Deadlines are derived from the start time, not from the end of the previous cycle,
+// so the time spent inside the callback does not accumulate into period drift.
+// If a cycle overruns one or more deadlines, the missed slots are counted and skipped
+// instead of being replayed back-to-back.
+class PeriodicExecutor
+{
+public:
+    // Return false from the callback to stop the loop. The argument is the cycle index.
+    typedef std::function<bool(uint64_t)> CycleFn;
+
+    explicit PeriodicExecutor(const PeriodicExecutorConfig& config)
+        : config_(config)
+        , cycles_(0)
+        , overruns_(0)
+        , missed_periods_(0)
+        , running_(false)
+    {
+    }
+
+    // Apply priority, affinity and memory locking to the calling thread.
+    // Failures (typically EPERM without CAP_SYS_NICE) are reported and the loop
+    // still runs with the default scheduler.
+    bool configure_current_thread()
+    {
+        bool ok = true;
+        if (config_.lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            std::cerr << "mlockall failed: " << std::strerror(errno) << std::endl;
+            ok = false;
+        }
+        if (config_.cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(config_.cpu, &set);
+            int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            if (err != 0) {
+                std::cerr << "Failed to pin thread to CPU " << config_.cpu << ": " << std::strerror(err) << std::endl;
+                ok = false;
+            }
+        }
+        if (config_.rt_priority > 0) {
+            sched_param param;
+            param.sched_priority = config_.rt_priority;
+            int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+            if (err != 0) {
+                std::cerr << "Failed to set SCHED_FIFO priority " << config_.rt_priority << ": " << std::strerror(err)
+                          << std::endl;
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    // Blocks the calling thread until the callback returns false or stop() is called.
+    void run(const CycleFn& fn)
+    {
+        running_ = true;
+        timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        int64_t deadline_ns = to_ns(deadline);
+
+        for (uint64_t cycle = 0; running_; ++cycle) {
+            int64_t wake_ns = now_ns();
+            wakeup_latency_.record_signed(wake_ns - deadline_ns);
+
+            bool keep_going = fn(cycle);
+            cycles_++;
+
+            int64_t done_ns = now_ns();
+            exec_time_.record_signed(done_ns - wake_ns);
+            if (!keep_going)
+                break;
+
+            deadline_ns += config_.period_ns;
+            if (done_ns > deadline_ns) {
+                // Overran at least one deadline: skip to the next slot still in the future.
+                int64_t missed = (done_ns - deadline_ns) / config_.period_ns + 1;
+                overruns_++;
+                missed_periods_ += static_cast<uint64_t>(missed);
+                deadline_ns += missed * config_.period_ns;
+            }
+
+            deadline = from_ns(deadline_ns);
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+            }
+        }
+        running_ = false;
+    }
+
+    void stop() { running_ = false; }
+
+    uint64_t cycles() const { return cycles_; }
+    uint64_t overruns() const { return overruns_; }
+    uint64_t missed_periods() const { return missed_periods_; }
+
+    // Time between the scheduled deadline and the moment the loop actually woke up.
+    const LatencyHistogram& wakeup_latency() const { return wakeup_latency_; }
+    // Time spent inside the callback per cycle.
+    const LatencyHistogram& exec_time() const { return exec_time_; }
+
+    void print_stats(std::ostream& os) const
+    {
+        os << "Cycles: " << cycles_ << ", period: " << config_.period_ns / 1000 << "us, overruns: " << overruns_
+           << ", missed periods: " << missed_periods_ << std::endl;
+        wakeup_latency_.print(os, "  Wakeup jitter");
+        exec_time_.print(os, "  Cycle exec time");
+    }
+
+private:
+    static int64_t to_ns(const timespec& ts) { return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec; }
+
+    static timespec from_ns(int64_t ns)
+    {
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(ns / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(ns % 1000000000LL);
+        return ts;
+    }
+
+    static int64_t now_ns()
+    {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return to_ns(ts);
+    }
+
+    PeriodicExecutorConfig config_;
+    LatencyHistogram wakeup_latency_;
+    LatencyHistogram exec_time_;
+    uint64_t cycles_;
+    uint64_t overruns_;
+    uint64_t missed_periods_;
+    std::atomic<bool> running_;
+};
+
+} // namespace quad_sdk
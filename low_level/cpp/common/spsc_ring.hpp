@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace quad_sdk {
+
+// Bounded lock-free single-producer / single-consumer ring of T.
+// Storage is allocated once in the constructor; push and pop never allocate, never
+// block and never take a lock. Capacity is rounded up to a power of two.
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity)
+        : head_(0)
+        , tail_(0)
+    {
+        size_t n = 1;
+        while (n < capacity)
+            n <<= 1;
+        slots_.resize(n);
+        mask_ = n - 1;
+    }
+
+    // Producer side. Returns false (and leaves the ring unchanged) when full.
+    bool try_push(const T& value)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_)
+            return false;
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when empty.
+    bool try_pop(T& value)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return false;
+        value = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_; // next slot to pop, written by the consumer
+    alignas(64) std::atomic<size_t> tail_; // next slot to push, written by the producer
+};
+
+} // namespace quad_sdk
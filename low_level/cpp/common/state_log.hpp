@@ -0,0 +1,382 @@
+#pragma once
+
+// Memory-mapped, block-columnar log of StateSample records.
+//
+// File layout (little endian, all offsets in bytes):
+//   [0, 4096)   StateLogHeader followed by one StateLogColumn per column
+//   then fixed-size blocks of kBlockRecords records each. Inside a block every
+//   column is stored contiguously: column c of record r lives at
+//     4096 + block(r) * block_bytes + column[c].block_offset + (r % kBlockRecords) * width(c)
+//
+// Because records are fixed size, any record or column can be addressed directly
+// from the mapped file. Column 0 is the receive timestamp and is non-decreasing
+// (append() clamps a stamp that goes backwards), which makes it the time index:
+// seek() binary-searches the first timestamp of each block, then the block's
+// contiguous timestamp column, touching O(log n) pages.
+
+#include "common/state_sample.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace quad_sdk {
+
+const char kStateLogMagic[8] = {'Q', 'S', 'T', 'A', 'T', 'E', 'L', 'G'};
+const uint32_t kStateLogVersion = 1;
+const size_t kStateLogHeaderBytes = 4096;
+const uint32_t kBlockRecords = 1024;
+
+struct StateLogColumn
+{
+    char name[24];
+    uint8_t type; // ColumnType
+    uint8_t reserved;
+    uint16_t count;
+    uint32_t block_offset;
+};
+
+struct StateLogHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_bytes;
+    uint32_t block_records;
+    uint32_t num_columns;
+    uint64_t block_bytes;
+    uint64_t record_count; // committed records; readers ignore anything past this
+    int64_t first_t_ns;
+    int64_t last_t_ns;
+};
+
+static_assert(sizeof(StateLogHeader) + 32 * sizeof(StateLogColumn) <= kStateLogHeaderBytes, "header too large");
+
+inline size_t column_width(const StateLogColumn& col)
+{
+    return column_type_size(static_cast<ColumnType>(col.type)) * col.count;
+}
+
+// Appends samples to a new log file. Not thread-safe: use it from one writer thread
+// and feed it through a ring buffer (see tools/state_recorder.cc).
+class StateLogWriter
+{
+public:
+    StateLogWriter()
+        : fd_(-1)
+        , map_(nullptr)
+        , map_bytes_(0)
+        , capacity_(0)
+        , count_(0)
+        , grow_blocks_(64)
+    {
+    }
+
+    ~StateLogWriter() { close(); }
+
+    bool open(const std::string& path, uint32_t grow_blocks = 64)
+    {
+        grow_blocks_ = grow_blocks ? grow_blocks : 1;
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            std::cerr << "Failed to create " << path << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        std::memset(&header_, 0, sizeof(header_));
+        std::memcpy(header_.magic, kStateLogMagic, sizeof(kStateLogMagic));
+        header_.version = kStateLogVersion;
+        header_.header_bytes = kStateLogHeaderBytes;
+        header_.block_records = kBlockRecords;
+        header_.num_columns = kNumStateColumns;
+
+        uint32_t offset = 0;
+        for (int c = 0; c < kNumStateColumns; ++c) {
+            StateLogColumn& col = columns_[c];
+            std::memset(&col, 0, sizeof(col));
+            std::strncpy(col.name, kStateColumns[c].name, sizeof(col.name) - 1);
+            col.type = kStateColumns[c].type;
+            col.count = kStateColumns[c].count;
+            col.block_offset = offset;
+            // Keep every column 8-byte aligned so mapped reads are naturally aligned.
+            offset += static_cast<uint32_t>((column_width(col) * kBlockRecords + 7) & ~size_t(7));
+        }
+        header_.block_bytes = offset;
+        return grow();
+    }
+
+    bool append(const StateSample& sample)
+    {
+        if (count_ == capacity_ && !grow())
+            return false;
+
+        uint8_t* block = map_ + kStateLogHeaderBytes + (count_ / kBlockRecords) * header_.block_bytes;
+        size_t index = count_ % kBlockRecords;
+        // A receive stamp that goes backwards (wall clock stepped by NTP) is clamped to
+        // the previous one so the time column stays sorted for seek().
+        int64_t t_ns = (count_ > 0 && sample.t_ns < header_.last_t_ns) ? header_.last_t_ns : sample.t_ns;
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(&sample);
+        for (int c = 0; c < kNumStateColumns; ++c) {
+            size_t width = column_width(columns_[c]);
+            const uint8_t* value = (c == 0) ? reinterpret_cast<const uint8_t*>(&t_ns) : src + kStateColumns[c].offset;
+            std::memcpy(block + columns_[c].block_offset + index * width, value, width);
+        }
+
+        if (count_ == 0)
+            header_.first_t_ns = t_ns;
+        header_.last_t_ns = t_ns;
+        count_++;
+        return true;
+    }
+
+    // Publish the record count to the mapped header so concurrent readers see new data.
+    void flush()
+    {
+        if (!map_)
+            return;
+        header_.record_count = count_;
+        std::memcpy(map_, &header_, sizeof(header_));
+        std::memcpy(map_ + sizeof(header_), columns_, sizeof(columns_));
+    }
+
+    // Also releases a writer whose grow() failed: the mapping may be gone, but fd_ is
+    // still open and the file still has its preallocated size.
+    void close()
+    {
+        if (fd_ < 0)
+            return;
+        if (map_) {
+            flush();
+            msync(map_, map_bytes_, MS_SYNC);
+            munmap(map_, map_bytes_);
+        }
+        // Trim the preallocated tail down to the last used block.
+        size_t blocks = (count_ + kBlockRecords - 1) / kBlockRecords;
+        if (ftruncate(fd_, static_cast<off_t>(kStateLogHeaderBytes + blocks * header_.block_bytes)) != 0)
+            std::cerr << "Failed to trim state log: " << std::strerror(errno) << std::endl;
+        ::close(fd_);
+        map_ = nullptr;
+        fd_ = -1;
+    }
+
+    uint64_t count() const { return count_; }
+
+private:
+    bool grow()
+    {
+        size_t blocks = capacity_ / kBlockRecords + grow_blocks_;
+        size_t bytes = kStateLogHeaderBytes + blocks * header_.block_bytes;
+        if (ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            std::cerr << "Failed to grow state log: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        if (map_) {
+            flush();
+            munmap(map_, map_bytes_);
+        }
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            std::cerr << "Failed to map state log: " << std::strerror(errno) << std::endl;
+            map_ = nullptr;
+            return false;
+        }
+        map_ = static_cast<uint8_t*>(p);
+        map_bytes_ = bytes;
+        capacity_ = blocks * kBlockRecords;
+        flush();
+        return true;
+    }
+
+    int fd_;
+    uint8_t* map_;
+    size_t map_bytes_;
+    uint64_t capacity_;
+    uint64_t count_;
+    uint32_t grow_blocks_;
+    StateLogHeader header_;
+    StateLogColumn columns_[kNumStateColumns];
+};
+
+// Read-only view of a state log. Columns are looked up by name, so files written
+// by a build with a different column set remain readable.
+class StateLogReader
+{
+public:
+    StateLogReader()
+        : fd_(-1)
+        , map_(nullptr)
+        , map_bytes_(0)
+        , header_(nullptr)
+        , columns_(nullptr)
+    {
+    }
+
+    ~StateLogReader()
+    {
+        if (map_)
+            munmap(const_cast<uint8_t*>(map_), map_bytes_);
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+
+    bool open(const std::string& path)
+    {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd_ < 0 || fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) < kStateLogHeaderBytes) {
+            std::cerr << "Failed to open state log " << path << std::endl;
+            return false;
+        }
+        map_bytes_ = static_cast<size_t>(st.st_size);
+        void* p = mmap(nullptr, map_bytes_, PROT_READ, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            std::cerr << "Failed to map state log: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        map_ = static_cast<const uint8_t*>(p);
+        header_ = reinterpret_cast<const StateLogHeader*>(map_);
+        columns_ = reinterpret_cast<const StateLogColumn*>(map_ + sizeof(StateLogHeader));
+        if (std::memcmp(header_->magic, kStateLogMagic, sizeof(kStateLogMagic)) != 0
+            || header_->version != kStateLogVersion || header_->block_bytes == 0 || header_->block_records == 0
+            || header_->num_columns == 0 || header_->num_columns > 32) {
+            std::cerr << path << " is not a version " << kStateLogVersion << " state log" << std::endl;
+            return false;
+        }
+        if (!layout_valid()) {
+            std::cerr << path << " has a corrupt state log header" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Records that are both committed and fully inside the mapped file.
+    uint64_t size() const
+    {
+        uint64_t blocks = (map_bytes_ - header_->header_bytes) / header_->block_bytes;
+        return std::min<uint64_t>(header_->record_count, blocks * header_->block_records);
+    }
+
+    const StateLogHeader& header() const { return *header_; }
+    int num_columns() const { return static_cast<int>(header_->num_columns); }
+    const StateLogColumn& column(int c) const { return columns_[c]; }
+
+    int find_column(const std::string& name) const
+    {
+        for (int c = 0; c < num_columns(); ++c) {
+            if (name == columns_[c].name)
+                return c;
+        }
+        return -1;
+    }
+
+    // Pointer to the first element of column c for record i.
+    const uint8_t* element(int c, uint64_t i) const
+    {
+        const uint8_t* block = map_ + header_->header_bytes + (i / header_->block_records) * header_->block_bytes;
+        return block + columns_[c].block_offset + (i % header_->block_records) * column_width(columns_[c]);
+    }
+
+    // Element k of column c for record i, converted to double.
+    double value(int c, uint64_t i, int k = 0) const
+    {
+        const uint8_t* p = element(c, i);
+        switch (columns_[c].type) {
+            case COL_I64: {
+                int64_t v;
+                std::memcpy(&v, p + 8 * k, sizeof(v));
+                return static_cast<double>(v);
+            }
+            case COL_F32: {
+                float v;
+                std::memcpy(&v, p + 4 * k, sizeof(v));
+                return v;
+            }
+            default:
+                return p[k];
+        }
+    }
+
+    int64_t time(uint64_t i) const
+    {
+        int64_t t;
+        std::memcpy(&t, element(0, i), sizeof(t));
+        return t;
+    }
+
+    // Index of the first record with time >= t_ns (size() if none).
+    uint64_t seek(int64_t t_ns) const
+    {
+        uint64_t n = size();
+        uint64_t per_block = header_->block_records;
+        uint64_t blocks = (n + per_block - 1) / per_block;
+        // Last block whose first timestamp is < t_ns.
+        uint64_t lo = 0, hi = blocks;
+        while (lo < hi) {
+            uint64_t mid = (lo + hi) / 2;
+            if (time(mid * per_block) < t_ns)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo == 0)
+            return 0;
+        // The answer is in block lo-1, or is the first record of block lo.
+        uint64_t first = (lo - 1) * per_block;
+        uint64_t last = std::min(n, lo * per_block);
+        while (first < last) {
+            uint64_t mid = (first + last) / 2;
+            if (time(mid) < t_ns)
+                first = mid + 1;
+            else
+                last = mid;
+        }
+        return first;
+    }
+
+    // Reassemble a full sample from the columns this build knows about.
+    void read_sample(uint64_t i, StateSample& out) const
+    {
+        std::memset(&out, 0, sizeof(out));
+        uint8_t* dst = reinterpret_cast<uint8_t*>(&out);
+        for (int k = 0; k < kNumStateColumns; ++k) {
+            int c = find_column(kStateColumns[k].name);
+            if (c < 0 || columns_[c].type != kStateColumns[k].type)
+                continue;
+            size_t width = column_type_size(kStateColumns[k].type) * std::min(columns_[c].count, kStateColumns[k].count);
+            std::memcpy(dst + kStateColumns[k].offset, element(c, i), width);
+        }
+    }
+
+private:
+    // Every address size(), element() and time() compute must stay inside the mapping.
+    bool layout_valid() const
+    {
+        if (header_->header_bytes < sizeof(StateLogHeader) + header_->num_columns * sizeof(StateLogColumn)
+            || header_->header_bytes > map_bytes_)
+            return false;
+        if (columns_[0].type != COL_I64 || columns_[0].count < 1) // the time index
+            return false;
+        for (uint32_t c = 0; c < header_->num_columns; ++c) {
+            const StateLogColumn& col = columns_[c];
+            if (col.type > COL_U8 || std::memchr(col.name, '\0', sizeof(col.name)) == nullptr)
+                return false;
+            if (col.block_offset + static_cast<uint64_t>(column_width(col)) * header_->block_records
+                > header_->block_bytes)
+                return false;
+        }
+        return true;
+    }
+
+    int fd_;
+    const uint8_t* map_;
+    size_t map_bytes_;
+    const StateLogHeader* header_;
+    const StateLogColumn* columns_;
+};
+
+} // namespace quad_sdk
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace quad_sdk {
+
+// Single-producer / single-consumer "latest value" mailbox built on a triple buffer.
+//
+// The producer (typically a DDS listener callback) always has a private back buffer
+// to write into, and publishes it by swapping it with the shared middle slot. The
+// consumer (the control loop) swaps the middle slot with its private front buffer
+// only when something new has been published. Both sides are wait-free, neither
+// ever blocks the other, and the consumer always sees a complete, untorn value.
+// Intermediate values are overwritten when the producer is faster than the consumer.
+//
+// T only has to be copy-assignable, so DDS message types holding sequences work too;
+// assignment into an already-sized buffer reuses its storage.
+template <typename T>
+class StateMailbox
+{
+public:
+    StateMailbox()
+        : middle_(1)
+        , back_(0)
+        , write_seq_(0)
+        , published_(0)
+        , front_(2)
+    {
+    }
+
+    // Producer side. Copies value into the back buffer and publishes it.
+    void write(const T& value)
+    {
+        slots_[back_].value = value;
+        commit();
+    }
+
+    // Producer side, in-place variant: fill the returned buffer, then call commit().
+    // The buffer holds whatever value was written there two or three publishes ago.
+    T& begin_write() { return slots_[back_].value; }
+
+    void commit()
+    {
+        slots_[back_].seq = ++write_seq_;
+        uint8_t prev = middle_.exchange(static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel);
+        back_ = prev & kIndexMask;
+        published_.store(write_seq_, std::memory_order_release);
+    }
+
+    // Consumer side. Returns the newest published value, or nullptr if nothing has
+    // been written yet. The pointer stays valid until the next call to read().
+    const T* read(uint64_t* seq = nullptr)
+    {
+        if (middle_.load(std::memory_order_relaxed) & kFresh) {
+            uint8_t prev = middle_.exchange(front_, std::memory_order_acq_rel);
+            front_ = prev & kIndexMask;
+        }
+        const Slot& slot = slots_[front_];
+        if (seq)
+            *seq = slot.seq;
+        return slot.seq ? &slot.value : nullptr;
+    }
+
+    // Number of values published so far. Safe to call from any thread.
+    uint64_t published() const { return published_.load(std::memory_order_acquire); }
+
+private:
+    static const uint8_t kIndexMask = 0x3;
+    static const uint8_t kFresh = 0x4;
+
+    struct alignas(64) Slot
+    {
+        Slot()
+            : seq(0)
+        {
+        }
+        T value;
+        uint64_t seq;
+    };
+
+    Slot slots_[3];
+    alignas(64) std::atomic<uint8_t> middle_;
+    alignas(64) uint8_t back_;   // owned by the producer
+    uint64_t write_seq_;         // owned by the producer
+    std::atomic<uint64_t> published_;
+    alignas(64) uint8_t front_;  // owned by the consumer
+};
+
+} // namespace quad_sdk
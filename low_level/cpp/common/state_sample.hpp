@@ -0,0 +1,136 @@
+#pragma once
+
+#include "lower_state.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace quad_sdk {
+
+// Flat, trivially copyable snapshot of one LowerState_ plus its receive time.
+// This is what the recorder pushes through its ring buffer and what the state
+// log stores column by column.
+struct StateSample
+{
+    int64_t t_ns; // receive time, CLOCK_REALTIME nanoseconds
+
+    uint8_t mode[16];
+    float q[16];
+    float dq[16];
+    float ddq[16];
+    float tau_est[16];
+    float q_raw[16];
+    float dq_raw[16];
+    float ddq_raw[16];
+    uint8_t motor_temp[16];
+
+    float quaternion[4];
+    float gyroscope[3];
+    float accelerometer[3];
+    float rpy[3];
+
+    uint8_t battery_level;
+    float battery_current;
+};
+
+enum ColumnType : uint8_t
+{
+    COL_I64 = 0,
+    COL_F32 = 1,
+    COL_U8 = 2,
+};
+
+struct ColumnDef
+{
+    const char* name;
+    ColumnType type;
+    uint16_t count; // elements per record
+    size_t offset;  // offset of the first element inside StateSample
+};
+
+inline size_t column_type_size(ColumnType type)
+{
+    return type == COL_I64 ? 8 : (type == COL_F32 ? 4 : 1);
+}
+
+#define QUAD_SDK_STATE_COLUMN(field, type, count) {#field, type, count, offsetof(StateSample, field)}
+
+// Column 0 must stay the timestamp: the log's time index relies on it.
+const ColumnDef kStateColumns[] = {
+    QUAD_SDK_STATE_COLUMN(t_ns, COL_I64, 1),
+    QUAD_SDK_STATE_COLUMN(mode, COL_U8, 16),
+    QUAD_SDK_STATE_COLUMN(q, COL_F32, 16),
+    QUAD_SDK_STATE_COLUMN(dq, COL_F32, 16),
+    QUAD_SDK_STATE_COLUMN(ddq, COL_F32, 16),
+    QUAD_SDK_STATE_COLUMN(tau_est, COL_F32, 16),
+    QUAD_SDK_STATE_COLUMN(q_raw, COL_F32, 16),
+    QUAD_SDK_STATE_COLUMN(dq_raw, COL_F32, 16),
+    QUAD_SDK_STATE_COLUMN(ddq_raw, COL_F32, 16),
+    QUAD_SDK_STATE_COLUMN(motor_temp, COL_U8, 16),
+    QUAD_SDK_STATE_COLUMN(quaternion, COL_F32, 4),
+    QUAD_SDK_STATE_COLUMN(gyroscope, COL_F32, 3),
+    QUAD_SDK_STATE_COLUMN(accelerometer, COL_F32, 3),
+    QUAD_SDK_STATE_COLUMN(rpy, COL_F32, 3),
+    QUAD_SDK_STATE_COLUMN(battery_level, COL_U8, 1),
+    QUAD_SDK_STATE_COLUMN(battery_current, COL_F32, 1),
+};
+
+#undef QUAD_SDK_STATE_COLUMN
+
+const int kNumStateColumns = sizeof(kStateColumns) / sizeof(kStateColumns[0]);
+
+inline void to_sample(const dobotmh4::msg::dds_::LowerState_& state, int64_t t_ns, StateSample& out)
+{
+    out.t_ns = t_ns;
+    for (int i = 0; i < 16; ++i) {
+        const dobotmh4::msg::dds_::MotorState_& m = state.motor_state()[i];
+        out.mode[i] = m.mode();
+        out.q[i] = m.q();
+        out.dq[i] = m.dq();
+        out.ddq[i] = m.ddq();
+        out.tau_est[i] = m.tau_est();
+        out.q_raw[i] = m.q_raw();
+        out.dq_raw[i] = m.dq_raw();
+        out.ddq_raw[i] = m.ddq_raw();
+        out.motor_temp[i] = m.motor_temp();
+    }
+    const dobotmh4::msg::dds_::IMUState_& imu = state.imu_state();
+    for (int i = 0; i < 4; ++i)
+        out.quaternion[i] = imu.quaternion()[i];
+    for (int i = 0; i < 3; ++i) {
+        out.gyroscope[i] = imu.gyroscope()[i];
+        out.accelerometer[i] = imu.accelerometer()[i];
+        out.rpy[i] = imu.rpy()[i];
+    }
+    out.battery_level = state.bms_state().battery_level();
+    out.battery_current = state.bms_state().battery_now_current();
+}
+
+// Inverse of to_sample for replay. Fields the log does not carry are left untouched,
+// so a reused message keeps whatever the caller initialised them to.
+inline void from_sample(const StateSample& in, dobotmh4::msg::dds_::LowerState_& state)
+{
+    for (int i = 0; i < 16; ++i) {
+        dobotmh4::msg::dds_::MotorState_& m = state.motor_state()[i];
+        m.mode(in.mode[i]);
+        m.q(in.q[i]);
+        m.dq(in.dq[i]);
+        m.ddq(in.ddq[i]);
+        m.tau_est(in.tau_est[i]);
+        m.q_raw(in.q_raw[i]);
+        m.dq_raw(in.dq_raw[i]);
+        m.ddq_raw(in.ddq_raw[i]);
+        m.motor_temp(in.motor_temp[i]);
+    }
+    dobotmh4::msg::dds_::IMUState_& imu = state.imu_state();
+    for (int i = 0; i < 4; ++i)
+        imu.quaternion()[i] = in.quaternion[i];
+    for (int i = 0; i < 3; ++i) {
+        imu.gyroscope()[i] = in.gyroscope[i];
+        imu.accelerometer()[i] = in.accelerometer[i];
+        imu.rpy()[i] = in.rpy[i];
+    }
+    state.bms_state().battery_level(in.battery_level);
+    state.bms_state().battery_now_current(in.battery_current);
+}
+
+} // namespace quad_sdk
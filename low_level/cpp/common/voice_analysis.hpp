@@ -0,0 +1,423 @@
+#pragma once
+
+// On-robot analysis of the rt/voice/state stream (24 kHz S16 mono plus angle_()).
+//
+// VoiceAnalyzer cuts each chunk into short frames and measures, per frame, the RMS and
+// peak level and the energy in eight band-pass filters from 150 Hz to 6 kHz. A voice
+// activity detector compares the level against a tracked noise floor and checks that
+// most of the energy sits in the speech band. Out come a few compact events:
+// speech start and stop, periodic loudness while speech lasts, and the sound-source
+// angle smoothed over the speech. Behaviours can react to these events, and the audio
+// never has to leave the robot.
+//
+// The per-sample work is two kernels: a level pass (sum of squares and peak over int16)
+// and the eight filters, run side by side as eight SIMD lanes. There are AVX2/FMA
+// versions, picked at run time on x86-64 CPUs that have them (no -march flag needed),
+// NEON versions on AArch64, and portable scalar versions. All of them give the same
+// results to float rounding.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define QUAD_SDK_VOICE_AVX2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define QUAD_SDK_VOICE_NEON 1
+#endif
+
+namespace quad_sdk {
+
+const int kVoiceBands = 8;
+
+// Band-pass biquads (RBJ, 0 dB peak), transposed direct form II with b1 = 0 and
+// b2 = -b0. One array entry per band so each array loads as one SIMD vector (unaligned:
+// C++11 new does not honour over-aligned types).
+struct VoiceFilterBank
+{
+    float b0[kVoiceBands];
+    float a1[kVoiceBands];
+    float a2[kVoiceBands];
+    float s1[kVoiceBands]; // filter state, carried across calls
+    float s2[kVoiceBands];
+    float energy[kVoiceBands]; // sum of squared outputs, cleared per frame
+};
+
+// Adds the sum of squares of x[0..n) to *sumsq and raises *peak to the largest |x|.
+inline void voice_level_scalar(const int16_t* x, size_t n, uint64_t* sumsq, uint32_t* peak)
+{
+    uint64_t sum = 0;
+    uint32_t max = *peak;
+    for (size_t i = 0; i < n; ++i) {
+        int32_t v = x[i];
+        sum += static_cast<uint64_t>(v * v);
+        max = std::max(max, static_cast<uint32_t>(v < 0 ? -v : v));
+    }
+    *sumsq += sum;
+    *peak = max;
+}
+
+// Runs x[0..n) through every band, adding each band's output energy.
+inline void voice_filter_scalar(const int16_t* x, size_t n, VoiceFilterBank& bank)
+{
+    for (size_t i = 0; i < n; ++i) {
+        float in = x[i] * (1.0f / 32768);
+        for (int b = 0; b < kVoiceBands; ++b) {
+            float y = bank.b0[b] * in + bank.s1[b];
+            bank.s1[b] = bank.s2[b] - bank.a1[b] * y;
+            bank.s2[b] = -bank.b0[b] * in - bank.a2[b] * y;
+            bank.energy[b] += y * y;
+        }
+    }
+}
+
+#ifdef QUAD_SDK_VOICE_AVX2
+__attribute__((target("avx2"))) inline void voice_level_avx2(const int16_t* x, size_t n, uint64_t* sumsq,
+                                                             uint32_t* peak)
+{
+    __m256i sum_lo = _mm256_setzero_si256();
+    __m256i sum_hi = _mm256_setzero_si256();
+    __m256i max = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        // Pairwise products summed into 32 bits: at most 2 * 32768^2 = 2^31, so the lanes
+        // are widened as unsigned before accumulating.
+        __m256i sq = _mm256_madd_epi16(v, v);
+        sum_lo = _mm256_add_epi64(sum_lo, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(sq)));
+        sum_hi = _mm256_add_epi64(sum_hi, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(sq, 1)));
+        // abs(-32768) stays 0x8000, which is right when compared unsigned.
+        max = _mm256_max_epu16(max, _mm256_abs_epi16(v));
+    }
+    alignas(32) uint64_t sums[4];
+    alignas(32) uint16_t maxes[16];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(sums), _mm256_add_epi64(sum_lo, sum_hi));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxes), max);
+    *sumsq += sums[0] + sums[1] + sums[2] + sums[3];
+    for (int k = 0; k < 16; ++k)
+        *peak = std::max<uint32_t>(*peak, maxes[k]);
+    voice_level_scalar(x + i, n - i, sumsq, peak);
+}
+
+__attribute__((target("avx2,fma"))) inline void voice_filter_avx2(const int16_t* x, size_t n, VoiceFilterBank& bank)
+{
+    const __m256 b0 = _mm256_loadu_ps(bank.b0);
+    const __m256 a1 = _mm256_loadu_ps(bank.a1);
+    const __m256 a2 = _mm256_loadu_ps(bank.a2);
+    __m256 s1 = _mm256_loadu_ps(bank.s1);
+    __m256 s2 = _mm256_loadu_ps(bank.s2);
+    __m256 energy = _mm256_loadu_ps(bank.energy);
+    for (size_t i = 0; i < n; ++i) {
+        __m256 in = _mm256_set1_ps(x[i] * (1.0f / 32768));
+        __m256 y = _mm256_fmadd_ps(b0, in, s1);
+        s1 = _mm256_fnmadd_ps(a1, y, s2);
+        s2 = _mm256_fnmadd_ps(a2, y, _mm256_mul_ps(_mm256_sub_ps(_mm256_setzero_ps(), b0), in));
+        energy = _mm256_fmadd_ps(y, y, energy);
+    }
+    _mm256_storeu_ps(bank.s1, s1);
+    _mm256_storeu_ps(bank.s2, s2);
+    _mm256_storeu_ps(bank.energy, energy);
+}
+#endif
+
+#ifdef QUAD_SDK_VOICE_NEON
+inline void voice_level_neon(const int16_t* x, size_t n, uint64_t* sumsq, uint32_t* peak)
+{
+    int64x2_t sum = vdupq_n_s64(0);
+    uint16x8_t max = vdupq_n_u16(0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t v = vld1q_s16(x + i);
+        // Products fit in 32 bits (at most 2^30); pairs are then summed into 64 bits.
+        sum = vpadalq_s32(sum, vmull_s16(vget_low_s16(v), vget_low_s16(v)));
+        sum = vpadalq_s32(sum, vmull_high_s16(v, v));
+        max = vmaxq_u16(max, vreinterpretq_u16_s16(vabsq_s16(v))); // abs(-32768) = 0x8000
+    }
+    *sumsq += static_cast<uint64_t>(vaddvq_s64(sum));
+    *peak = std::max<uint32_t>(*peak, vmaxvq_u16(max));
+    voice_level_scalar(x + i, n - i, sumsq, peak);
+}
+
+inline void voice_filter_neon(const int16_t* x, size_t n, VoiceFilterBank& bank)
+{
+    const float32x4_t b0[2] = {vld1q_f32(bank.b0), vld1q_f32(bank.b0 + 4)};
+    const float32x4_t a1[2] = {vld1q_f32(bank.a1), vld1q_f32(bank.a1 + 4)};
+    const float32x4_t a2[2] = {vld1q_f32(bank.a2), vld1q_f32(bank.a2 + 4)};
+    float32x4_t s1[2] = {vld1q_f32(bank.s1), vld1q_f32(bank.s1 + 4)};
+    float32x4_t s2[2] = {vld1q_f32(bank.s2), vld1q_f32(bank.s2 + 4)};
+    float32x4_t energy[2] = {vld1q_f32(bank.energy), vld1q_f32(bank.energy + 4)};
+    for (size_t i = 0; i < n; ++i) {
+        float32x4_t in = vdupq_n_f32(x[i] * (1.0f / 32768));
+        for (int h = 0; h < 2; ++h) {
+            float32x4_t y = vfmaq_f32(s1[h], b0[h], in);
+            s1[h] = vfmsq_f32(s2[h], a1[h], y);
+            s2[h] = vfmsq_f32(vnegq_f32(vmulq_f32(b0[h], in)), a2[h], y);
+            energy[h] = vfmaq_f32(energy[h], y, y);
+        }
+    }
+    for (int h = 0; h < 2; ++h) {
+        vst1q_f32(bank.s1 + 4 * h, s1[h]);
+        vst1q_f32(bank.s2 + 4 * h, s2[h]);
+        vst1q_f32(bank.energy + 4 * h, energy[h]);
+    }
+}
+#endif
+
+struct VoiceKernels
+{
+    const char* name;
+    void (*level)(const int16_t* x, size_t n, uint64_t* sumsq, uint32_t* peak);
+    void (*filter)(const int16_t* x, size_t n, VoiceFilterBank& bank);
+};
+
+// The fastest kernels this CPU runs, or the scalar ones.
+inline VoiceKernels voice_kernels(bool allow_simd = true)
+{
+#ifdef QUAD_SDK_VOICE_AVX2
+    if (allow_simd && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return VoiceKernels {"avx2", voice_level_avx2, voice_filter_avx2};
+#endif
+#ifdef QUAD_SDK_VOICE_NEON
+    if (allow_simd)
+        return VoiceKernels {"neon", voice_level_neon, voice_filter_neon};
+#endif
+    (void)allow_simd;
+    return VoiceKernels {"scalar", voice_level_scalar, voice_filter_scalar};
+}
+
+struct VoiceAnalysisConfig
+{
+    int sample_rate = 24000;
+    int frame_ms = 20;                  // analysis frame; chunks are cut at frame boundaries
+    float threshold_db = 9.0f;          // speech must be this far above the noise floor
+    float min_speech_dbfs = -50.0f;     // and at least this loud
+    float min_speech_ratio = 0.5f;      // and have this share of its energy in 430 Hz - 3.5 kHz
+    float floor_rise_db_per_s = 1.0f;   // noise floor creep; it drops at once to quieter frames
+    float min_floor_dbfs = -80.0f;      // digital silence does not drag the floor below this
+    int onset_ms = 40;                  // speech frames in a row before kSpeechStart
+    int hangover_ms = 300;              // non-speech frames in a row before kSpeechStop
+    int loudness_interval_ms = 250;     // kLoudness period while speech lasts
+    float angle_time_constant_ms = 500; // smoothing of angle_() during speech
+    bool use_simd = true;               // false forces the scalar kernels
+};
+
+struct VoiceEvent
+{
+    enum Type : uint8_t
+    {
+        kSpeechStart,
+        kSpeechStop,
+        kLoudness
+    };
+    Type type;
+    int64_t t_ns;       // end of the frame that triggered the event
+    float rms_dbfs;     // kLoudness: over the interval, otherwise over the last frame
+    float peak_dbfs;    // same span as rms_dbfs
+    float speech_ratio; // share of energy in the speech bands, same span
+    float angle_deg;    // smoothed source direction in [0, 360)
+};
+
+inline const char* voice_event_name(VoiceEvent::Type type)
+{
+    switch (type) {
+        case VoiceEvent::kSpeechStart:
+            return "speech_start";
+        case VoiceEvent::kSpeechStop:
+            return "speech_stop";
+        case VoiceEvent::kLoudness:
+            return "loudness";
+    }
+    return "?";
+}
+
+// Measurements of the last complete frame.
+struct VoiceFrame
+{
+    float rms_dbfs = -120.0f;
+    float peak_dbfs = -120.0f;
+    float speech_ratio = 0.0f;
+    float noise_floor_dbfs = -120.0f;
+    float band_dbfs[kVoiceBands] = {}; // per band mean power
+    bool speech = false;
+};
+
+class VoiceAnalyzer
+{
+public:
+    explicit VoiceAnalyzer(const VoiceAnalysisConfig& config = VoiceAnalysisConfig())
+        : config_(config)
+        , kernels_(voice_kernels(config.use_simd))
+        , frame_samples_(static_cast<size_t>(config.sample_rate) * config.frame_ms / 1000)
+    {
+        // Centres spaced evenly in log frequency from 150 Hz to 6 kHz, about 0.76 octave apart.
+        const double q = 1.87;
+        for (int b = 0; b < kVoiceBands; ++b) {
+            double fc = 150.0 * std::pow(6000.0 / 150.0, static_cast<double>(b) / (kVoiceBands - 1));
+            double w0 = 2.0 * M_PI * fc / config_.sample_rate;
+            double alpha = std::sin(w0) / (2.0 * q);
+            double a0 = 1.0 + alpha;
+            bank_.b0[b] = static_cast<float>(alpha / a0);
+            bank_.a1[b] = static_cast<float>(-2.0 * std::cos(w0) / a0);
+            bank_.a2[b] = static_cast<float>((1.0 - alpha) / a0);
+        }
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill(bank_.s1, bank_.s1 + kVoiceBands, 0.0f);
+        std::fill(bank_.s2, bank_.s2 + kVoiceBands, 0.0f);
+        std::fill(bank_.energy, bank_.energy + kVoiceBands, 0.0f);
+        sumsq_ = 0;
+        peak_ = 0;
+        filled_ = 0;
+        frame_ = VoiceFrame();
+        have_floor_ = false;
+        speaking_ = false;
+        run_frames_ = 0;
+        angle_x_ = angle_y_ = 0.0;
+        have_angle_ = false;
+        interval_frames_ = 0;
+        interval_energy_ = 0.0;
+        interval_ratio_ = 0.0;
+        interval_peak_ = 0;
+    }
+
+    const char* simd_name() const { return kernels_.name; }
+    const VoiceFrame& last_frame() const { return frame_; }
+    bool speaking() const { return speaking_; }
+
+    // Analyses one chunk. t_ns is the time of its last sample (arrival time will do);
+    // angle_deg is the chunk's angle_(). Events are appended to `events`.
+    void process(const int16_t* pcm, size_t samples, float angle_deg, int64_t t_ns, std::vector<VoiceEvent>& events)
+    {
+        size_t done = 0;
+        while (done < samples) {
+            size_t n = std::min(samples - done, frame_samples_ - filled_);
+            kernels_.level(pcm + done, n, &sumsq_, &peak_);
+            kernels_.filter(pcm + done, n, bank_);
+            filled_ += n;
+            done += n;
+            if (filled_ == frame_samples_) {
+                int64_t end_ns = t_ns - static_cast<int64_t>(samples - done) * 1000000000LL / config_.sample_rate;
+                finish_frame(angle_deg, end_ns, events);
+            }
+        }
+    }
+
+private:
+    static float to_db(double power) { return static_cast<float>(10.0 * std::log10(power + 1e-12)); }
+
+    // Bands 2-6 (430 Hz - 3.5 kHz) carry most of the energy of voiced speech.
+    static double speech_energy(const float* energy)
+    {
+        return energy[2] + energy[3] + energy[4] + energy[5] + energy[6];
+    }
+
+    void finish_frame(float angle_deg, int64_t end_ns, std::vector<VoiceEvent>& events)
+    {
+        const double full_scale = 32768.0 * 32768.0;
+        double power = sumsq_ / (full_scale * frame_samples_);
+        double band_total = 0.0;
+        for (int b = 0; b < kVoiceBands; ++b) {
+            frame_.band_dbfs[b] = to_db(bank_.energy[b] / frame_samples_);
+            band_total += bank_.energy[b];
+        }
+        double speech = speech_energy(bank_.energy);
+        frame_.rms_dbfs = to_db(power);
+        frame_.peak_dbfs = peak_ ? static_cast<float>(20.0 * std::log10(peak_ / 32768.0)) : -120.0f;
+        frame_.speech_ratio = band_total > 0.0 ? static_cast<float>(speech / band_total) : 0.0f;
+
+        // Noise floor: follows quieter frames down at once, creeps up otherwise.
+        float level = std::max(frame_.rms_dbfs, config_.min_floor_dbfs);
+        if (!have_floor_ || level < frame_.noise_floor_dbfs) {
+            frame_.noise_floor_dbfs = level;
+            have_floor_ = true;
+        } else {
+            frame_.noise_floor_dbfs += config_.floor_rise_db_per_s * config_.frame_ms / 1000.0f;
+        }
+        frame_.speech = frame_.rms_dbfs >= frame_.noise_floor_dbfs + config_.threshold_db
+            && frame_.rms_dbfs >= config_.min_speech_dbfs && frame_.speech_ratio >= config_.min_speech_ratio;
+
+        // The angle is only meaningful while someone is speaking.
+        if (frame_.speech) {
+            double rad = angle_deg * M_PI / 180.0;
+            double k = have_angle_ ? 1.0 - std::exp(-config_.frame_ms / config_.angle_time_constant_ms) : 1.0;
+            angle_x_ += (std::cos(rad) - angle_x_) * k;
+            angle_y_ += (std::sin(rad) - angle_y_) * k;
+            have_angle_ = true;
+        }
+
+        // Hysteresis: onset_ms of speech to start, hangover_ms of non-speech to stop.
+        int needed = (speaking_ ? config_.hangover_ms : config_.onset_ms) / config_.frame_ms;
+        run_frames_ = frame_.speech != speaking_ ? run_frames_ + 1 : 0;
+        if (run_frames_ >= std::max(needed, 1)) {
+            speaking_ = !speaking_;
+            run_frames_ = 0;
+            events.push_back(make_event(speaking_ ? VoiceEvent::kSpeechStart : VoiceEvent::kSpeechStop, end_ns,
+                                        frame_.rms_dbfs, frame_.peak_dbfs, frame_.speech_ratio));
+            interval_frames_ = 0;
+            interval_energy_ = interval_ratio_ = 0.0;
+            interval_peak_ = 0;
+        } else if (speaking_) {
+            interval_frames_++;
+            interval_energy_ += power;
+            interval_ratio_ += band_total > 0.0 ? speech / band_total : 0.0;
+            interval_peak_ = std::max(interval_peak_, peak_);
+            if (interval_frames_ * config_.frame_ms >= config_.loudness_interval_ms) {
+                float peak_db = interval_peak_ ? static_cast<float>(20.0 * std::log10(interval_peak_ / 32768.0))
+                                               : -120.0f;
+                events.push_back(make_event(VoiceEvent::kLoudness, end_ns, to_db(interval_energy_ / interval_frames_),
+                                            peak_db,
+                                            static_cast<float>(interval_ratio_ / interval_frames_)));
+                interval_frames_ = 0;
+                interval_energy_ = interval_ratio_ = 0.0;
+                interval_peak_ = 0;
+            }
+        }
+
+        sumsq_ = 0;
+        peak_ = 0;
+        filled_ = 0;
+        std::fill(bank_.energy, bank_.energy + kVoiceBands, 0.0f);
+    }
+
+    VoiceEvent make_event(VoiceEvent::Type type, int64_t t_ns, float rms, float peak, float ratio) const
+    {
+        VoiceEvent event;
+        event.type = type;
+        event.t_ns = t_ns;
+        event.rms_dbfs = rms;
+        event.peak_dbfs = peak;
+        event.speech_ratio = ratio;
+        double deg = std::atan2(angle_y_, angle_x_) * 180.0 / M_PI;
+        event.angle_deg = static_cast<float>(deg < 0.0 ? deg + 360.0 : deg);
+        return event;
+    }
+
+    VoiceAnalysisConfig config_;
+    VoiceKernels kernels_;
+    size_t frame_samples_;
+    VoiceFilterBank bank_;
+
+    uint64_t sumsq_;
+    uint32_t peak_;
+    size_t filled_; // samples of the current frame seen so far
+    VoiceFrame frame_;
+    bool have_floor_;
+
+    bool speaking_;
+    int run_frames_; // frames in a row that disagree with speaking_
+    double angle_x_;
+    double angle_y_;
+    bool have_angle_;
+    int interval_frames_;
+    double interval_energy_;
+    double interval_ratio_;
+    uint32_t interval_peak_;
+};
+
+} // namespace quad_sdk
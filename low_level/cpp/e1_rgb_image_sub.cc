@@ -1,48 +1,109 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
-#include <fstream>
 #include <cstdlib>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
 #include <opencv2/opencv.hpp>
 #include "dds_middleware.hpp"
 #include "sensor_msgs/msg/CompressedImage_.hpp"
+#include "common/frame_pipeline.hpp"
 
 using namespace dds_middleware;
 
-void image_callback(const sensor_msgs::msg::dds_::CompressedImage_& data)
+// Compressed frame copied out of the DDS sample into a reused buffer.
+struct CompressedFrame
 {
-    std::cout << "Received RGB CompressedImage:" << std::endl;
-    std::cout << "sec=" << data.header_().stamp_().sec_() << std::endl;
-    std::cout << "nanosec=" << data.header_().stamp_().nanosec_() << std::endl;
-    std::cout << "frame_id=" << data.header_().frame_id_() << std::endl;
-    std::cout << "format=" << data.format_() << std::endl;
-    std::cout << "data_size=" << data.data_().size() << " bytes" << std::endl << std::endl;
-
-    // Decode compressed data to raw image (cv::Mat)
-    cv::Mat raw_img = cv::imdecode(cv::Mat(data.data_()), cv::IMREAD_COLOR);
-    if (raw_img.empty()) {
-        std::cerr << "Failed to decode image!" << std::endl;
-        return;
+    int32_t sec = 0;
+    uint32_t nanosec = 0;
+    int64_t recv_ns = 0; // host receive time (system_clock), the timeline tools/replay follows
+    bool png = false;
+    std::vector<uint8_t> data;
+};
+
+// Worker step: write the compressed bytes to disk unchanged (record mode) or decode
+// them and save a lossless PNG (decode mode).
+class RgbWorker
+{
+public:
+    explicit RgbWorker(bool record)
+        : record_(record)
+    {
     }
 
-    // Save as lossless PNG format
-    std::string filename = "rgb_images/rgb_" + std::to_string(data.header_().stamp_().sec_()) + "_"
-                           + std::to_string(data.header_().stamp_().nanosec_()) + ".png";
-    cv::imwrite(filename, raw_img);
-    std::cout << "Saved raw image to " << filename << std::endl;
+    bool operator()(const CompressedFrame& frame, uint64_t* bytes_written)
+    {
+        std::string base = "rgb_images/rgb_" + std::to_string(frame.sec) + "_" + std::to_string(frame.nanosec);
+        if (record_) // store data_() as received, no decode / re-encode
+            return quad_sdk::write_frame_file(base + "_recv" + std::to_string(frame.recv_ns)
+                                                  + (frame.png ? ".png" : ".jpg"),
+                                              frame.data.data(), frame.data.size(), bytes_written);
+
+        // Decode compressed data to raw image (cv::Mat); raw_img_ is reused while the frame size is unchanged
+        cv::Mat encoded(1, static_cast<int>(frame.data.size()), CV_8UC1, const_cast<uint8_t*>(frame.data.data()));
+        cv::imdecode(encoded, cv::IMREAD_COLOR, &raw_img_);
+        if (raw_img_.empty()) {
+            std::cerr << "Failed to decode image!" << std::endl;
+            return false;
+        }
+        // Save as lossless PNG format
+        return cv::imwrite(base + ".png", raw_img_);
+    }
+
+private:
+    bool record_;
+    cv::Mat raw_img_;
+};
+
+typedef quad_sdk::FramePipeline<CompressedFrame, RgbWorker> RgbPipeline;
+static RgbPipeline* g_pipeline = nullptr;
+
+// Copies the CompressedImage_ into a preallocated frame and returns; the workers do the rest.
+void image_callback(const sensor_msgs::msg::dds_::CompressedImage_& data)
+{
+    int64_t recv_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    CompressedFrame* frame = g_pipeline->acquire();
+    if (!frame)
+        return;
+    frame->recv_ns = recv_ns;
+    frame->sec = data.header_().stamp_().sec_();
+    frame->nanosec = data.header_().stamp_().nanosec_();
+    frame->png = data.format_().find("png") != std::string::npos;
+    frame->data.assign(data.data_().begin(), data.data_().end());
+    g_pipeline->submit(frame);
 }
 
-int main()
+// Usage: ./e1_rgb_image_sub [decode|record] [workers] [queue_depth]
+int main(int argc, char** argv)
 {
-    system("mkdir -p rgb_images");
+    std::string mode = (argc > 1) ? argv[1] : "decode";
+    bool record = (mode == "record");
+    // Recording is I/O bound and keeps frames in order with a single writer.
+    int workers = (argc > 2) ? std::atoi(argv[2]) : (record ? 1 : 2);
+    int queue_depth = (argc > 3) ? std::atoi(argv[3]) : 8;
+    if (workers < 1 || queue_depth < 1) {
+        std::cerr << "workers and queue_depth must be >= 1" << std::endl;
+        return 1;
+    }
+
+    mkdir("rgb_images", 0755);
+    RgbPipeline pipeline(RgbWorker(record), workers, queue_depth);
+    g_pipeline = &pipeline;
+
     DDSMiddleware middleware("./config/dds_config.yaml");
 
     auto topic = middleware.createTopic<sensor_msgs::msg::dds_::CompressedImage_>("rt/camera/camera2/image_compressed");
 
     auto reader = middleware.createReader<sensor_msgs::msg::dds_::CompressedImage_>(topic, image_callback);
 
-    std::cout << "Subscribed to RGB image topic. Waiting for messages..." << std::endl;
-    std::this_thread::sleep_for(std::chrono::hours(1));
+    std::cout << "Subscribed to RGB image topic (" << (record ? "record" : "decode") << " mode, " << workers
+              << " workers, queue depth " << queue_depth << "). Waiting for messages..." << std::endl;
+    for (int i = 0; i < 3600; ++i) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        pipeline.printStats(std::cout, "RGB");
+    }
 
     return 0;
 }
@@ -2,50 +2,123 @@
 #include <thread>
 #include <chrono>
 #include <cstdlib>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
 #include <opencv2/opencv.hpp>
 #include "dds_middleware.hpp"
 #include "sensor_msgs/msg/Image_.hpp"
+#include "common/frame_pipeline.hpp"
 
 using namespace dds_middleware;
 
+// Depth frame copied out of the DDS sample. The data buffer keeps its capacity
+// across reuse, so steady-state frames cost one memcpy and no allocation.
+struct DepthFrame
+{
+    int32_t sec = 0;
+    uint32_t nanosec = 0;
+    int64_t recv_ns = 0; // host receive time (system_clock), the timeline tools/replay follows
+    uint32_t height = 0;
+    uint32_t width = 0;
+    uint32_t step = 0;
+    std::vector<uint8_t> data;
+};
+
+// Worker step: normalize + Jet colormap + PNG (visualization mode) or write the
+// 16-bit buffer to disk untouched (raw mode). The scratch images are per worker;
+// OpenCV reuses them while the frame size is unchanged.
+class DepthWorker
+{
+public:
+    explicit DepthWorker(bool raw)
+        : raw_(raw)
+        , png_params_ {cv::IMWRITE_PNG_COMPRESSION, 1}
+    {
+    }
+
+    bool operator()(const DepthFrame& frame, uint64_t* bytes_written)
+    {
+        std::string base = "depth_images/depth_" + std::to_string(frame.sec) + "_" + std::to_string(frame.nanosec);
+        if (raw_) {
+            // Raw 16UC1 rows exactly as received; width, height, step and receive time are in the file name.
+            std::string filename = base + "_" + std::to_string(frame.width) + "x" + std::to_string(frame.height)
+                                   + "_step" + std::to_string(frame.step) + "_recv" + std::to_string(frame.recv_ns)
+                                   + ".raw";
+            return quad_sdk::write_frame_file(filename, frame.data.data(), frame.data.size(), bytes_written);
+        }
+
+        cv::Mat depth_img(frame.height, frame.width, CV_16UC1, const_cast<uint8_t*>(frame.data.data()), frame.step);
+        // Normalize 16-bit depth values to 0-255 range (CV_8UC1)
+        cv::normalize(depth_img, depth_vis_, 0, 255, cv::NORM_MINMAX, CV_8UC1);
+        // Apply pseudo-color (Jet Colormap: Red/warm for near, Blue/cold for far)
+        cv::applyColorMap(depth_vis_, depth_color_, cv::COLORMAP_JET);
+        return cv::imwrite(base + ".png", depth_color_, png_params_);
+    }
+
+private:
+    bool raw_;
+    std::vector<int> png_params_;
+    cv::Mat depth_vis_;
+    cv::Mat depth_color_;
+};
+
+typedef quad_sdk::FramePipeline<DepthFrame, DepthWorker> DepthPipeline;
+static DepthPipeline* g_pipeline = nullptr;
+
+// Validates the frame and copies the buffer; the workers do the rest.
 void depth_callback(const sensor_msgs::msg::dds_::Image_& data)
 {
-    std::cout << "Received Depth Image:" << std::endl;
-    std::cout << "sec=" << data.header_().stamp_().sec_() << std::endl;
-    std::cout << "nanosec=" << data.header_().stamp_().nanosec_() << std::endl;
-    std::cout << "frame_id=" << data.header_().frame_id_() << std::endl;
-    std::cout << "height=" << data.height_() << std::endl;
-    std::cout << "width=" << data.width_() << std::endl;
-    std::cout << "encoding=" << data.encoding_() << std::endl;
-    std::cout << "data_size=" << data.data_().size() << " bytes" << std::endl << std::endl;
-
-    cv::Mat depth_img(data.height_(), data.width_(), CV_16UC1, const_cast<unsigned char*>(data.data_().data()));
-
-    cv::Mat depth_vis;
-    // Normalize 16-bit depth values to 0-255 range (CV_8UC1)
-    cv::normalize(depth_img, depth_vis, 0, 255, cv::NORM_MINMAX, CV_8UC1);
-    // Apply pseudo-color (Jet Colormap: Red/warm for near, Blue/cold for far)
-    cv::Mat depth_color;
-    cv::applyColorMap(depth_vis, depth_color, cv::COLORMAP_JET);
-
-    std::string filename = "depth_images/depth_" + std::to_string(data.header_().stamp_().sec_()) + "_"
-                           + std::to_string(data.header_().stamp_().nanosec_()) + ".png";
-
-    cv::imwrite(filename, depth_color);
-    std::cout << "Saved visibility depth map to " << filename << std::endl;
+    uint32_t step = data.step_() ? data.step_() : data.width_() * 2;
+    size_t bytes = static_cast<size_t>(step) * data.height_();
+    if (bytes == 0 || data.data_().size() < bytes || step < data.width_() * 2) {
+        g_pipeline->reject();
+        return;
+    }
+
+    int64_t recv_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    DepthFrame* frame = g_pipeline->acquire();
+    if (!frame)
+        return;
+    frame->recv_ns = recv_ns;
+    frame->sec = data.header_().stamp_().sec_();
+    frame->nanosec = data.header_().stamp_().nanosec_();
+    frame->height = data.height_();
+    frame->width = data.width_();
+    frame->step = step;
+    frame->data.assign(data.data_().begin(), data.data_().begin() + bytes);
+    g_pipeline->submit(frame);
 }
 
-int main()
+// Usage: ./e2_depth_image_sub [vis|raw] [workers] [queue_depth]
+int main(int argc, char** argv)
 {
-    system("mkdir -p depth_images");
+    std::string mode = (argc > 1) ? argv[1] : "vis";
+    int workers = (argc > 2) ? std::atoi(argv[2]) : 2;
+    int queue_depth = (argc > 3) ? std::atoi(argv[3]) : 4;
+    if (workers < 1 || queue_depth < 1) {
+        std::cerr << "workers and queue_depth must be >= 1" << std::endl;
+        return 1;
+    }
+
+    mkdir("depth_images", 0755);
+    DepthPipeline pipeline(DepthWorker(mode == "raw"), workers, queue_depth);
+    g_pipeline = &pipeline;
+
     DDSMiddleware middleware("./config/dds_config.yaml");
 
     auto topic = middleware.createTopic<sensor_msgs::msg::dds_::Image_>("rt/camera/camera2/image_depth");
 
     auto reader = middleware.createReader<sensor_msgs::msg::dds_::Image_>(topic, depth_callback);
 
-    std::cout << "Subscribed to depth image topic. Waiting for messages..." << std::endl;
-    std::this_thread::sleep_for(std::chrono::hours(1));
+    std::cout << "Subscribed to depth image topic (" << (mode == "raw" ? "raw 16-bit" : "visualization")
+              << " mode, " << workers << " workers, queue depth " << queue_depth << "). Waiting for messages..."
+              << std::endl;
+    for (int i = 0; i < 3600; ++i) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        pipeline.printStats(std::cout, "Depth");
+    }
 
     return 0;
 }
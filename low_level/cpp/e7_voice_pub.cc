@@ -1,125 +1,89 @@
 #include "dds_middleware.hpp"
 #include "voice_cmd.hpp"
+#include "common/audio_capture.hpp"
+#include "common/latency_histogram.hpp"
 #include <chrono>
-#include <cstdio>
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
-#include <queue>
-#include <mutex>
 #include <atomic>
+#ifdef QUAD_SDK_WITH_OPUS
+#include "common/opus_voice.hpp"
+#endif
 
 using namespace dds_middleware;
 using namespace dobotmh4::msg::dds_;
 
-// Thread-safe queue for audio buffers
-class AudioQueue
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
 {
-public:
-    AudioQueue(size_t max_size = 2)
-        : max_size_(max_size)
-    {
-    }
-
-    void push(std::vector<uint8_t> data)
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (queue_.size() >= max_size_) {
-            queue_.pop(); // Drop oldest if full
-        }
-        queue_.push(std::move(data));
-    }
-
-    bool try_pop(std::vector<uint8_t>& data)
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (queue_.empty()) {
-            return false;
-        }
-        data = std::move(queue_.front());
-        queue_.pop();
-        return true;
-    }
-
-private:
-    std::queue<std::vector<uint8_t>> queue_;
-    std::mutex mutex_;
-    size_t max_size_;
-};
+    g_interrupt.store(true);
+}
 
-// Background thread for continuous low-latency audio capture
-class AudioCaptureThread
+// Captures from `source` (ALSA device or audio file, see common/audio_capture.hpp) in
+// period_ms periods and publishes each one as soon as it is ready. A file source is
+// played once, or repeated until Ctrl+C with `loop_file`. `encode` turns a
+// period into the VoiceCmd_ payload and returns false when there is nothing to send
+// yet. The loop blocks on the ring, reuses one message, and prints capture -> publish
+// latency once a second.
+template <typename PublisherPtr, typename Encode>
+static int stream_capture(const PublisherPtr& publisher, const std::string& source, int period_ms,
+                          bool loop_file, const std::string& type, Encode encode)
 {
-public:
-    AudioCaptureThread(int chunk_duration_ms = 100)
-        : chunk_duration_ms_(chunk_duration_ms)
-        , running_(true)
-    {
-    }
-
-    void run()
-    {
-        int duration_sec_factor = chunk_duration_ms_; // e.g., 100 = 0.1 seconds
-
-        FILE* pipe = popen("arecord -q -t raw -f S16_LE -c1 -r24000", "r");
-        if (!pipe) {
-            std::cerr << "arecord not found or failed to start" << std::endl;
-            return;
-        }
-
-        // Calculate bytes per chunk (24kHz, 16bit, mono = 2 bytes per sample)
-        // For 100ms: 24000 * 0.1 * 2 = 4800 bytes
-        int bytes_per_chunk = (24000 * chunk_duration_ms_ / 1000) * 2;
-
-        std::vector<uint8_t> buffer(bytes_per_chunk);
-        size_t read_bytes = 0;
-
-        while (running_) {
-            read_bytes = fread(buffer.data(), 1, bytes_per_chunk, pipe);
-            if (read_bytes > 0) {
-                std::vector<uint8_t> chunk(buffer.begin(), buffer.begin() + read_bytes);
-                audio_queue_.push(std::move(chunk));
-            } else if (feof(pipe)) {
-                break;
+    size_t period_samples = quad_sdk::kCaptureSampleRate * period_ms / 1000;
+    std::unique_ptr<quad_sdk::AudioCapture> capture =
+        quad_sdk::open_audio_capture(source, period_samples, loop_file);
+    if (!capture)
+        return 1;
+    quad_sdk::AudioRing ring(period_samples, 1000 / period_ms + 1); // about 1 s of slack
+    capture->start(ring);
+    std::cout << "Capturing from " << source << " in " << period_ms << " ms periods... Press Ctrl+C to stop."
+              << std::endl;
+
+    VoiceCmd_ voice_cmd;
+    voice_cmd.type(type);
+    voice_cmd.path("");
+    quad_sdk::LatencyHistogram latency;
+    size_t messages = 0, bytes = 0;
+    auto report = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!g_interrupt && !(capture->finished() && ring.size() == 0)) {
+        int64_t captured_ns = 0;
+        const int16_t* period = ring.wait_read(100, &captured_ns);
+        if (period) {
+            voice_cmd.data().clear(); // keeps its capacity from the previous period
+            bool send = encode(period, period_samples, voice_cmd.data());
+            ring.release();
+            if (send) {
+                publisher->publish(voice_cmd);
+                timespec ts;
+                clock_gettime(CLOCK_MONOTONIC, &ts);
+                latency.record_signed(static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec - captured_ns);
+                messages++;
+                bytes += voice_cmd.data().size();
             }
         }
-
-        pclose(pipe);
-    }
-
-    bool get_audio(std::vector<uint8_t>& data) { return audio_queue_.try_pop(data); }
-
-    void stop() { running_ = false; }
-
-private:
-    AudioQueue audio_queue_;
-    int chunk_duration_ms_;
-    std::atomic<bool> running_;
-};
-
-// Capture audio chunk from microphone using arecord (24kHz, mono, 16bit PCM)
-static std::vector<uint8_t> capture_audio_chunk()
-{
-    std::vector<uint8_t> data;
-    FILE* pipe = popen("arecord -q -t raw -f S16_LE -c1 -r24000 -d0.1", "r");
-    if (!pipe) {
-        std::cerr << "arecord not found or failed to start, unable to perform streaming" << std::endl;
-        return data;
-    }
-
-    std::vector<uint8_t> buffer(4096);
-    size_t read_bytes = 0;
-    while ((read_bytes = fread(buffer.data(), 1, buffer.size(), pipe)) > 0) {
-        data.insert(data.end(), buffer.begin(), buffer.begin() + static_cast<long>(read_bytes));
+        if (std::chrono::steady_clock::now() >= report) {
+            std::cout << "Published " << messages << " VoiceCmd (" << type << "), " << bytes
+                      << " bytes, overruns=" << ring.overruns() << std::endl;
+            latency.print(std::cout, "  capture -> publish");
+            latency.reset();
+            messages = bytes = 0;
+            report += std::chrono::seconds(1);
+        }
     }
-    pclose(pipe);
-    return data;
+    capture->stop();
+    return 0;
 }
 
 int main(int argc, char** argv)
 {
-    std::string mode = (argc > 1) ? argv[1] : "file"; // "file" or "streaming"
+    std::string mode = (argc > 1) ? argv[1] : "file"; // "file", "streaming" or "opus"
+    std::signal(SIGINT, SignalHandler);
 
     std::shared_ptr<DDSMiddleware> middleware = std::make_shared<DDSMiddleware>(0);
 
@@ -139,6 +103,8 @@ int main(int argc, char** argv)
         std::string file_path = "/root/test2.flac";
         // std::string file_path = "/root/test3.mp3";
 
+        // The path is resolved on the robot. To play a file from this machine instead, use
+        // streaming mode with the file as source: it is decoded and resampled here.
         std::cout << "File mode: publish local file paths cyclically" << std::endl;
         VoiceCmd_ voice_cmd;
         voice_cmd.type("file");
@@ -153,40 +119,55 @@ int main(int argc, char** argv)
         std::cout << "---------------------------" << std::endl;
 
         std::this_thread::sleep_for(std::chrono::seconds(1));
+        return 0;
     }
 
     if (mode == "streaming") {
-        std::cout << "Streaming mode: capture and publish from microphone (low-latency)" << std::endl;
-
-        // Start background audio capture thread
-        AudioCaptureThread capture_thread(100); // 100ms chunks
-        std::thread audio_thread(&AudioCaptureThread::run, &capture_thread);
-
-        std::vector<uint8_t> audio;
-        while (true) {
-            // Get audio from capture queue (non-blocking)
-            if (capture_thread.get_audio(audio)) {
-                VoiceCmd_ voice_cmd;
-                voice_cmd.type("streaming");
-                voice_cmd.path("");
-                voice_cmd.data(audio);
-
-                publisher->publish(voice_cmd);
-
-                std::cout << "Published VoiceCmd (streaming)" << std::endl;
-                std::cout << "  Data size: " << voice_cmd.data().size() << " bytes" << std::endl;
-                std::cout << "---------------------------" << std::endl;
-                // No sleep - publish immediately when audio is available
-            } else {
-                // No audio available, brief sleep before retry
-                std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10ms instead of 200ms
-            }
+        std::string source = (argc > 2) ? argv[2] : "default";
+        int period_ms = (argc > 3) ? std::atoi(argv[3]) : 100;
+        bool loop_file = (argc > 4) && std::string(argv[4]) == "loop";
+        if (period_ms < 10 || period_ms > 1000) {
+            std::cerr << "Usage: " << argv[0] << " streaming [device|file] [period_ms=100 (10-1000)] [loop]"
+                      << std::endl;
+            return 1;
         }
+        std::cout << "Streaming mode: capture and publish raw PCM (low-latency)" << std::endl;
+        return stream_capture(publisher, source, period_ms, loop_file, "streaming",
+                              [](const int16_t* pcm, size_t samples, std::vector<uint8_t>& out) {
+                                  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(pcm);
+                                  out.assign(bytes, bytes + samples * sizeof(int16_t));
+                                  return true;
+                              });
+    }
 
-        capture_thread.stop();
-        audio_thread.join();
+#ifdef QUAD_SDK_WITH_OPUS
+    if (mode == "opus") {
+        // Same capture as streaming, but each period is Opus-encoded before publishing.
+        // Opus periods can be much shorter than 100 ms: at ~60 bytes per 20 ms frame the
+        // message rate, not the bandwidth, is what a short period costs.
+        std::string source = (argc > 2) ? argv[2] : "default";
+        int chunk_ms = (argc > 3) ? std::atoi(argv[3]) : 20;
+        int bitrate_kbps = (argc > 4) ? std::atoi(argv[4]) : 24;
+        bool loop_file = (argc > 5) && std::string(argv[5]) == "loop";
+        quad_sdk::OpusVoiceEncoder encoder(bitrate_kbps * 1000, 20);
+        if (!encoder.ok() || chunk_ms < 20 || chunk_ms > 1000 || bitrate_kbps < 6) {
+            std::cerr << "Usage: " << argv[0]
+                      << " opus [device|file] [chunk_ms=20 (20-1000)] [bitrate_kbps=24 (>= 6)] [loop]" << std::endl;
+            return 1;
+        }
+        std::cout << "Opus mode: capture, encode at " << bitrate_kbps << " kbit/s and publish" << std::endl;
+        return stream_capture(publisher, source, chunk_ms, loop_file, quad_sdk::kVoiceTypeOpus,
+                              [&encoder](const int16_t* pcm, size_t samples, std::vector<uint8_t>& out) {
+                                  return encoder.encode(pcm, samples, out) > 0;
+                              });
     }
+#else
+    if (mode == "opus") {
+        std::cerr << "Opus support was not compiled in (libopus-dev not found at build time)" << std::endl;
+        return 1;
+    }
+#endif
 
-    std::cout << "Unknown mode, use 'file' or 'streaming'" << std::endl;
-    return 0;
+    std::cerr << "Unknown mode, use 'file', 'streaming' or 'opus'" << std::endl;
+    return 1;
 }
\ No newline at end of file
@@ -11,34 +11,121 @@
  *       -lddscxx -lstdc++
  *
  * Usage:
- *   ./e9_voice_sub
+ *   ./e9_voice_sub [record.vlog|-] [sink] [min_delay_ms=20] [max_delay_ms=500]
+ *   With a file argument every received chunk is also appended to a blob log
+ *   (common/blob_log.hpp) that tools/replay can republish later; "-" records nothing.
+ *   With a sink the audio (24 kHz S16_LE mono) is played through a jitter buffer
+ *   (common/jitter_buffer.hpp): an ALSA device such as "default", a .pcm/.raw file, or
+ *   "|aplay -q -f S16_LE -r 24000 -c 1". The playout delay adapts between min and max;
+ *   min == max fixes it. Buffer statistics are printed once per second.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <string>
+#include <vector>
 #include "dds_middleware.hpp"
 #include "voice_state.hpp"
+#include "common/audio_playback.hpp"
+#include "common/blob_log.hpp"
+#include "common/jitter_buffer.hpp"
 
 using namespace dds_middleware;
 using namespace dobotmh4::msg::dds_;
 
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
+{
+    g_interrupt.store(true);
+}
+
+// Open only when a record path is given. Voice arrives at tens of Hz, so the
+// buffered fwrite in the callback is cheap enough.
+quad_sdk::BlobLogWriter g_recorder;
+bool g_recording = false;
+
+// Set only when a sink is given. VoiceState_ carries no sequence number or timestamp,
+// so chunks are numbered in arrival order: the jitter buffer absorbs arrival jitter,
+// while a chunk lost on the way just shortens the stream instead of being concealed.
+std::unique_ptr<quad_sdk::JitterBuffer> g_jitter;
+uint64_t g_next_seq = 0;
+std::vector<int16_t> g_pcm;
+
+int64_t monotonic_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 /**
  * VoiceState message callback function
  * Called when a VoiceState message is received
  */
 void voiceStateCallback(const VoiceState_& voice_state)
 {
-    std::cout << "Received VoiceState message:" << std::endl;
-    std::cout << "  Data size: " << voice_state.data_().size() << " bytes" << std::endl;
-    std::cout << "  Sound source direction: " << voice_state.angle_() << " degrees" << std::endl;
-    std::cout << "---" << std::endl;
+    if (g_jitter) {
+        size_t samples = voice_state.data_().size() / sizeof(int16_t);
+        if (g_pcm.size() < samples)
+            g_pcm.resize(samples);
+        std::memcpy(g_pcm.data(), voice_state.data_().data(), samples * sizeof(int16_t));
+        g_jitter->push(g_next_seq++, g_pcm.data(), samples, monotonic_ns());
+    } else {
+        std::cout << "Received VoiceState message:" << std::endl;
+        std::cout << "  Data size: " << voice_state.data_().size() << " bytes" << std::endl;
+        std::cout << "  Sound source direction: " << voice_state.angle_() << " degrees" << std::endl;
+        std::cout << "---" << std::endl;
+    }
+
+    if (g_recording) {
+        int64_t t_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        g_recorder.append(t_ns, voice_state.data_().data(), static_cast<uint32_t>(voice_state.data_().size()),
+                          voice_state.angle_());
+    }
 }
 
-int main()
+int main(int argc, char** argv)
 {
     try {
+        if (argc > 1 && std::string(argv[1]) != "-") {
+            if (!g_recorder.open(argv[1]))
+                return 1;
+            g_recording = true;
+            std::cout << "Recording voice chunks to " << argv[1] << std::endl;
+        }
+
+        // 10 ms playback periods: small enough that the sink adds little delay.
+        const size_t period_samples = quad_sdk::kPlaybackSampleRate / 100;
+        std::unique_ptr<quad_sdk::AudioSink> sink;
+        std::unique_ptr<quad_sdk::PlaybackEngine> playback;
+        if (argc > 2) {
+            quad_sdk::JitterBufferConfig config;
+            config.min_delay_ms = (argc > 3) ? std::atoi(argv[3]) : 20;
+            config.max_delay_ms = (argc > 4) ? std::atoi(argv[4]) : 500;
+            if (config.min_delay_ms < 0 || config.max_delay_ms < config.min_delay_ms) {
+                std::cerr << "Usage: " << argv[0] << " [record.vlog|-] [sink] [min_delay_ms=20] [max_delay_ms=500]"
+                          << std::endl;
+                return 1;
+            }
+            config.adaptive = config.min_delay_ms != config.max_delay_ms;
+            config.initial_delay_ms = std::min(std::max(120, config.min_delay_ms), config.max_delay_ms);
+            sink = quad_sdk::open_audio_sink(argv[2], period_samples);
+            if (!sink)
+                return 1;
+            g_jitter.reset(new quad_sdk::JitterBuffer(config));
+            playback.reset(new quad_sdk::PlaybackEngine(*g_jitter, *sink, period_samples));
+            std::cout << "Playing to " << argv[2] << " with " << config.min_delay_ms << "-" << config.max_delay_ms
+                      << " ms jitter buffer" << std::endl;
+        }
+
         // Create DDS middleware instance
         std::shared_ptr<DDSMiddleware> middleware = std::make_shared<DDSMiddleware>(0);
 
@@ -59,11 +146,31 @@ int main()
 
         std::cout << "VoiceState subscriber started, waiting for voice state messages..." << std::endl;
         std::cout << "Press Ctrl+C to exit" << std::endl;
+        if (playback)
+            playback->start();
 
         // Keep the program running to receive messages
-        while (true) {
+        std::signal(SIGINT, SignalHandler);
+        while (!g_interrupt) {
             std::this_thread::sleep_for(std::chrono::seconds(1));
+            if (!g_jitter)
+                continue;
+            if (!playback->running()) {
+                std::cerr << "Audio sink failed, stopping playback" << std::endl;
+                break;
+            }
+            quad_sdk::JitterBufferStats stats = g_jitter->stats();
+            g_jitter->reset_delay();
+            std::cout << std::fixed << std::setprecision(1) << "depth " << stats.depth_ms << " ms, target "
+                      << stats.target_ms << " ms, jitter " << stats.jitter_ms << " ms, delay mean "
+                      << stats.delay.mean() / 1e6 << " / p99 " << stats.delay.percentile(99.0) / 1e6
+                      << " ms | received " << stats.received << ", underruns " << stats.underruns << ", late "
+                      << stats.late << ", skipped " << stats.dropped_ms << " ms" << std::endl;
         }
+        voice_state_sub.reset();
+        if (playback)
+            playback->stop();
+        g_recorder.close();
 
         return 0;
 
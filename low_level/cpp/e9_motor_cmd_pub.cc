@@ -1,77 +1,93 @@
 #include "dds_middleware.hpp"
 #include "lower_cmd.hpp"
 #include "lower_state.hpp"
+#include "common/lower_cmd_builder.hpp"
+#include "common/periodic_executor.hpp"
+#include "common/state_mailbox.hpp"
 #include <array>
-#include <atomic>
+#include <cerrno>
 #include <cmath>
+#include <cstdlib>
 #include <iostream>
 #include <unistd.h>
 
 using namespace dds_middleware;
 using namespace dobotmh4::msg::dds_;
+using quad_sdk::LowerCmdBuilder;
+using quad_sdk::PeriodicExecutor;
+using quad_sdk::PeriodicExecutorConfig;
+using quad_sdk::StateMailbox;
+using quad_sdk::abs2Hw;
+using quad_sdk::kNumJoints;
+using quad_sdk::kNumMotors;
 
-const int NUM_MOTORS = 12;
-const std::array<int, 12> abs2Hw = {0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14};
-const std::array<double, 16> motor_offset
+const std::array<double, kNumMotors> motor_offset
     = {-0.05, -0.5, 1.17, 0.0, 0.05, -0.5, 1.17, 0.0, -0.05, 0.5, -1.17, 0.0, 0.05, 0.5, -1.17, 0.0};
 
-std::array<double, 16> q_init = {0.0};
-std::atomic<int> q_init_count {0};
+// Latest LowerState_ handed from the DDS listener thread to the control thread
+StateMailbox<LowerState_> state_mailbox;
+std::array<double, kNumMotors> q_init = {0.0};
 
 void lowerStateCallback(const LowerState_& state)
 {
-    if (q_init_count < 10) {
-        // Subtract motor_offset when reading to get real joint angle
-        for (int i = 0; i < NUM_MOTORS; ++i) {
-            int hw = abs2Hw[i];
-            q_init[hw] = state.motor_state()[hw].q() - motor_offset[hw];
-        }
-        q_init_count++;
-        if (q_init_count == 10) {
-            std::cout << "Initial position collection completed: ";
-            for (int i = 0; i < NUM_MOTORS; ++i)
-                std::cout << q_init[abs2Hw[i]] << " ";
-            std::cout << std::endl;
-        }
-    }
+    state_mailbox.write(state);
 }
 
-// Damping mode: protect robot
-LowerCmd_ createDampCmd()
+// Subtract motor_offset when reading to get real joint angle
+void collectInitialPosition(const LowerState_& state)
 {
-    LowerCmd_ cmd;
-    for (int i = 0; i < NUM_MOTORS; ++i) {
-        int hw = abs2Hw[i];
-        cmd.motor_cmd()[hw].mode(0);
-        cmd.motor_cmd()[hw].q(0.0 + motor_offset[hw]);
-        cmd.motor_cmd()[hw].dq(0.0f);
-        cmd.motor_cmd()[hw].tau(0.0f);
-        cmd.motor_cmd()[hw].kp(0.0f);
-        cmd.motor_cmd()[hw].kd(0.5f);
+    for (int i = 0; i < kNumJoints; ++i) {
+        int hw = abs2Hw(i);
+        q_init[hw] = state.motor_state()[hw].q() - motor_offset[hw];
     }
-    return cmd;
+    std::cout << "Initial position collection completed: ";
+    for (int i = 0; i < kNumJoints; ++i)
+        std::cout << q_init[abs2Hw(i)] << " ";
+    std::cout << std::endl;
 }
 
-// Swing mode
-LowerCmd_ createSwingCmd(double s)
+// One preallocated command per stream; only the fields that change are patched per cycle
+LowerCmdBuilder damp_cmd(motor_offset);
+LowerCmdBuilder swing_cmd(motor_offset);
+
+void initCommandStreams()
 {
-    LowerCmd_ cmd;
-    for (int i = 0; i < NUM_MOTORS; ++i) {
-        int hw = abs2Hw[i];
-        // Add motor_offset when sending
-        double qdes = q_init[hw] + std::sin(2 * M_PI * s) * 0.2 + motor_offset[hw];
-        cmd.motor_cmd()[hw].mode(0);
-        cmd.motor_cmd()[hw].q(qdes);
-        cmd.motor_cmd()[hw].dq(0.0f);
-        cmd.motor_cmd()[hw].tau(0.0f);
-        cmd.motor_cmd()[hw].kp(30.0f);
-        cmd.motor_cmd()[hw].kd(1.2f);
-    }
-    return cmd;
+    // Damping mode: protect robot
+    damp_cmd.set_all(0, 0.0f, 0.5f);
+    for (int i = 0; i < kNumJoints; ++i)
+        damp_cmd.set_q(i, 0.0);
+
+    // Swing mode: fixed gains, position target updated every cycle
+    swing_cmd.set_all(0, 30.0f, 1.2f);
+}
+
+const LowerCmd_& updateSwingCmd(double s)
+{
+    double swing = std::sin(2 * M_PI * s) * 0.2;
+    for (int i = 0; i < kNumJoints; ++i)
+        swing_cmd.set_q(i, q_init[abs2Hw(i)] + swing); // motor_offset is added by the builder
+    return swing_cmd.cmd();
 }
 
-int main()
+int main(int argc, char** argv)
 {
+    // Optional: e9_motor_cmd_pub [period_us] [rt_priority] [cpu]
+    PeriodicExecutorConfig loop_config;
+    long long period_us = 2200;
+    if (argc > 1) {
+        char* end = nullptr;
+        errno = 0;
+        period_us = std::strtoll(argv[1], &end, 10);
+        if (errno != 0 || end == argv[1] || *end != '\0' || period_us <= 0 || period_us > 1000000) {
+            std::cerr << "Usage: " << argv[0] << " [period_us=2200 (1-1000000)] [rt_priority=0] [cpu=-1]" << std::endl;
+            return 1;
+        }
+    }
+    loop_config.period_ns = period_us * 1000;
+    loop_config.rt_priority = (argc > 2) ? std::atoi(argv[2]) : 0;
+    loop_config.cpu = (argc > 3) ? std::atoi(argv[3]) : -1;
+    loop_config.lock_memory = loop_config.rt_priority > 0;
+
     auto middleware = std::make_shared<DDSMiddleware>(0);
 
     dds_middleware::QoSProfile custom_qos;
@@ -85,33 +101,38 @@ int main()
         "rt/lower/state", lowerStateCallback, dds_middleware::QoSProfile::SensorData());
 
     std::cout << "Waiting for initial position collection (10 times)..." << std::endl;
-    while (q_init_count < 10)
+    while (state_mailbox.published() < 10)
         usleep(1000);
+    collectInitialPosition(*state_mailbox.read());
 
+    initCommandStreams();
     std::cout << "Starting control loop" << std::endl;
 
-    for (int iter = 0; iter < 6000; ++iter) {
+    PeriodicExecutor executor(loop_config);
+    executor.configure_current_thread();
+    executor.run([&](uint64_t cycle) {
+        int iter = static_cast<int>(cycle);
         if (iter < 10) {
             // First 10 iterations: lock initial position (already completed in callback)
-            pub->publish(createDampCmd());
+            pub->publish(damp_cmd.cmd());
             if (iter == 0)
                 std::cout << "[" << iter << "] Initialization phase" << std::endl;
         } else if (iter < 5000) {
             // Swing phase: iter 10 to 4999
             double s = double(iter - 1000) / 500.0;
-            pub->publish(createSwingCmd(s));
+            pub->publish(updateSwingCmd(s));
             if (iter == 10)
                 std::cout << "[" << iter << "] Starting swing" << std::endl;
         } else {
             // Completion phase: switch to damping mode
-            pub->publish(createDampCmd());
-            if (iter == 5000)
-                std::cout << "[" << iter << "] Swing completed, entering damping mode" << std::endl;
-            exit(0);
+            pub->publish(damp_cmd.cmd());
+            std::cout << "[" << iter << "] Swing completed, entering damping mode" << std::endl;
+            return false;
         }
-        usleep(2200);
-    }
+        return true;
+    });
 
+    executor.print_stats(std::cout);
     std::cout << "Control sequence completed" << std::endl;
     return 0;
-}
\ No newline at end of file
+}
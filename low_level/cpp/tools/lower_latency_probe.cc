@@ -0,0 +1,267 @@
+/**
+ * rt/lower/cmd -> rt/lower/state latency probe
+ *
+ * Drives the same command stream as e9_motor_cmd_pub (hold q_init with kp=30, kd=1.2)
+ * and periodically applies a small position step on one joint. Commands carry nothing
+ * but the real targets; steps are recognised by their target value. It records:
+ *   - command -> response: time from publishing a step until the joint's measured
+ *     LowerState_.motor_state()[hw].q() has covered half of the step. This is the
+ *     round trip over the link to the robot, including the joint's own motion.
+ *   - state inter-arrival: receive interval of rt/lower/state frames.
+ *   - local DDS loopback: time until a subscriber in this process sees the step
+ *     command on rt/lower/cmd. It never leaves the host, so it only shows the local
+ *     DDS overhead for the chosen command QoS, not the link to the robot.
+ * Histograms (p50/p99/p99.9/max) are printed every dump interval.
+ *
+ * The robot's main control program MUST be stopped first (see kill_robot), exactly
+ * as for e9_motor_cmd_pub.
+ *
+ * Usage:
+ *   ./lower_latency_probe [state_qos] [cmd_qos] [joint] [step_rad] [duration_s] [dump_interval_s]
+ *     state_qos / cmd_qos: "sensor" (QoSProfile::SensorData) or "reliable" (RELIABLE KEEP_LAST(1))
+ *   defaults: sensor reliable 2 0.05 30 5
+ */
+
+#include "dds_middleware.hpp"
+#include "lower_cmd.hpp"
+#include "lower_state.hpp"
+#include "common/latency_histogram.hpp"
+#include "common/lower_cmd_builder.hpp"
+#include "common/periodic_executor.hpp"
+#include "common/state_mailbox.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace dds_middleware;
+using namespace dobotmh4::msg::dds_;
+using quad_sdk::LatencyHistogram;
+using quad_sdk::LowerCmdBuilder;
+using quad_sdk::PeriodicExecutor;
+using quad_sdk::PeriodicExecutorConfig;
+using quad_sdk::StateMailbox;
+using quad_sdk::abs2Hw;
+using quad_sdk::kNumJoints;
+using quad_sdk::kNumMotors;
+
+const std::array<double, kNumMotors> motor_offset
+    = {-0.05, -0.5, 1.17, 0.0, 0.05, -0.5, 1.17, 0.0, -0.05, 0.5, -1.17, 0.0, 0.05, 0.5, -1.17, 0.0};
+
+const int STEP_PERIOD_CYCLES = 250; // toggle the step every 0.5 s at 500 Hz
+
+static int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static QoSProfile parseQos(const std::string& name)
+{
+    if (name == "reliable") {
+        QoSProfile qos;
+        qos.reliability = ReliabilityPolicy::RELIABLE;
+        qos.durability = DurabilityPolicy::VOLATILE;
+        qos.history = HistoryPolicy::KEEP_LAST;
+        qos.history_depth = 1;
+        return qos;
+    }
+    return QoSProfile::SensorData();
+}
+
+class LatencyProbe
+{
+public:
+    explicit LatencyProbe(int joint)
+        : hw_(abs2Hw(joint))
+        , last_state_ns_(0)
+        , step_pending_(false)
+        , step_start_ns_(0)
+        , step_from_(0.0)
+        , step_to_(0.0)
+        , loopback_pending_(false)
+        , loopback_target_(0.0f)
+        , loopback_missed_(0)
+        , steps_missed_(0)
+    {
+    }
+
+    // Control thread: a step from `from` to `to` (measured joint space) whose raw target
+    // on the wire is `target` is about to be published.
+    void onStep(double from, double to, float target, int64_t t_ns)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (step_pending_)
+            steps_missed_++;
+        if (loopback_pending_)
+            loopback_missed_++;
+        step_pending_ = true;
+        loopback_pending_ = true;
+        step_start_ns_ = t_ns;
+        step_from_ = from;
+        step_to_ = to;
+        loopback_target_ = target;
+    }
+
+    // rt/lower/cmd loopback listener: the first command with the new target is the step.
+    void onCommand(const LowerCmd_& cmd)
+    {
+        int64_t t_ns = now_ns();
+        float target = cmd.motor_cmd()[hw_].q();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (loopback_pending_ && target == loopback_target_) {
+            loopback_.record_signed(t_ns - step_start_ns_);
+            loopback_pending_ = false;
+        }
+    }
+
+    // rt/lower/state listener.
+    void onState(const LowerState_& state)
+    {
+        int64_t t_ns = now_ns();
+        mailbox_.write(state);
+
+        double q = state.motor_state()[hw_].q() - motor_offset[hw_];
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (last_state_ns_ != 0)
+            state_interval_.record_signed(t_ns - last_state_ns_);
+        last_state_ns_ = t_ns;
+
+        if (step_pending_) {
+            double halfway = 0.5 * (step_from_ + step_to_);
+            bool reached = (step_to_ > step_from_) ? (q >= halfway) : (q <= halfway);
+            if (reached) {
+                response_.record_signed(t_ns - step_start_ns_);
+                step_pending_ = false;
+            }
+        }
+    }
+
+    void dump(std::ostream& os)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        os << "---- latency probe (joint hw " << hw_ << ") ----" << std::endl;
+        response_.print(os, "cmd->response (50%)  ");
+        state_interval_.print(os, "state inter-arrival  ");
+        loopback_.print(os, "local DDS loopback   ");
+        os << "steps without response: " << steps_missed_ << ", steps not seen on loopback: " << loopback_missed_
+           << std::endl;
+    }
+
+    StateMailbox<LowerState_>& mailbox() { return mailbox_; }
+
+private:
+    int hw_;
+    StateMailbox<LowerState_> mailbox_;
+
+    std::mutex mutex_;
+    LatencyHistogram response_;
+    LatencyHistogram state_interval_;
+    LatencyHistogram loopback_;
+    int64_t last_state_ns_;
+    bool step_pending_;
+    int64_t step_start_ns_;
+    double step_from_;
+    double step_to_;
+    bool loopback_pending_;
+    float loopback_target_;
+    uint64_t loopback_missed_;
+    uint64_t steps_missed_;
+};
+
+int main(int argc, char** argv)
+{
+    std::string state_qos = (argc > 1) ? argv[1] : "sensor";
+    std::string cmd_qos = (argc > 2) ? argv[2] : "reliable";
+    int joint = (argc > 3) ? std::atoi(argv[3]) : 2;
+    double step = (argc > 4) ? std::atof(argv[4]) : 0.05;
+    int duration_s = (argc > 5) ? std::atoi(argv[5]) : 30;
+    int dump_s = (argc > 6) ? std::atoi(argv[6]) : 5;
+    if (dump_s <= 0)
+        dump_s = 5;
+
+    if (joint < 0 || joint >= kNumJoints || std::fabs(step) > 0.2) {
+        std::cerr << "joint must be 0-" << kNumJoints - 1 << " and |step_rad| <= 0.2" << std::endl;
+        return 1;
+    }
+
+    auto middleware = std::make_shared<DDSMiddleware>(0);
+    LatencyProbe probe(joint);
+
+    auto pub = middleware->create_publisher<LowerCmd_>("rt/lower/cmd", parseQos(cmd_qos));
+    auto cmd_sub = middleware->create_subscription<LowerCmd_>(
+        "rt/lower/cmd", [&probe](const LowerCmd_& cmd) { probe.onCommand(cmd); }, parseQos(cmd_qos));
+    auto state_sub = middleware->create_subscription<LowerState_>(
+        "rt/lower/state", [&probe](const LowerState_& state) { probe.onState(state); }, parseQos(state_qos));
+
+    std::cout << "State QoS: " << state_qos << ", command QoS: " << cmd_qos << std::endl;
+    std::cout << "Waiting for initial position collection (10 times)..." << std::endl;
+    while (probe.mailbox().published() < 10)
+        usleep(1000);
+
+    std::array<double, kNumMotors> q_init = {0.0};
+    const LowerState_& first = *probe.mailbox().read();
+    for (int i = 0; i < kNumJoints; ++i)
+        q_init[abs2Hw(i)] = first.motor_state()[abs2Hw(i)].q() - motor_offset[abs2Hw(i)];
+
+    LowerCmdBuilder cmd(motor_offset);
+    cmd.set_all(0, 30.0f, 1.2f);
+    for (int i = 0; i < kNumJoints; ++i)
+        cmd.set_q(i, q_init[abs2Hw(i)]);
+
+    PeriodicExecutorConfig loop_config;
+    loop_config.period_ns = 2000000;
+    PeriodicExecutor executor(loop_config);
+
+    const uint64_t total_cycles = static_cast<uint64_t>(duration_s) * 500;
+    const int hw = abs2Hw(joint);
+    bool stepped = false;
+    std::atomic<bool> done {false};
+
+    std::cout << "Probing joint " << joint << " (hw " << hw << ") with " << step << " rad steps for " << duration_s
+              << " s" << std::endl;
+
+    std::thread control([&] {
+        executor.run([&](uint64_t cycle) {
+            if (cycle > 0 && cycle % STEP_PERIOD_CYCLES == 0) {
+                double from = q_init[hw] + (stepped ? step : 0.0);
+                stepped = !stepped;
+                double to = q_init[hw] + (stepped ? step : 0.0);
+                cmd.set_q(joint, to);
+                probe.onStep(from, to, cmd.motor(joint).q(), now_ns());
+            }
+            pub->publish(cmd.cmd());
+            return cycle + 1 < total_cycles;
+        });
+        done = true;
+    });
+
+    // Dump from the main thread so printing never delays the command stream.
+    auto next_dump = std::chrono::steady_clock::now() + std::chrono::seconds(dump_s);
+    while (!done) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (std::chrono::steady_clock::now() >= next_dump) {
+            probe.dump(std::cout);
+            next_dump += std::chrono::seconds(dump_s);
+        }
+    }
+    control.join();
+
+    // Finish in damping mode, as e9_motor_cmd_pub does.
+    LowerCmdBuilder damp(motor_offset);
+    damp.set_all(0, 0.0f, 0.5f);
+    for (int i = 0; i < kNumJoints; ++i)
+        damp.set_q(i, 0.0);
+    pub->publish(damp.cmd());
+
+    std::cout << "==== final ====" << std::endl;
+    probe.dump(std::cout);
+    executor.print_stats(std::cout);
+    return 0;
+}
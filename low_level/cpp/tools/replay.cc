@@ -0,0 +1,534 @@
+/**
+ * Recorded topic replay
+ *
+ * Republishes recorded streams through DDSMiddleware::create_publisher so the
+ * low-level subscribers can be exercised without a robot:
+ *   rt/lower/state                      <- state log from state_recorder
+ *   rt/camera/camera2/image_compressed  <- rgb_images/ from e1_rgb_image_sub record
+ *   rt/camera/camera2/image_depth       <- depth_images/ (*.raw) from e2_depth_image_sub raw
+ *   rt/voice/state                      <- voice log from e8_voice_sub <file>
+ *
+ * All inputs are merged into one timeline ordered by the host receive time every
+ * recorder stores (system_clock, so the robot's clock offset does not matter; camera
+ * frames carry it in their file name) and paced against absolute CLOCK_MONOTONIC
+ * deadlines, so the original inter-message timing is kept without accumulating sleep
+ * error. Camera header stamps are republished unchanged.
+ *
+ * The topic names are the live ones, so by default replay publishes only on the
+ * loopback interface (the settings of cyclonedds_local.xml), whatever CYCLONEDDS_URI
+ * says. Run the subscribers with CYCLONEDDS_URI=file://<repo>/cyclonedds_local.xml to
+ * receive it. --live keeps the DDS configuration from the environment instead and may
+ * publish to a robot on the network.
+ *
+ * Usage:
+ *   ./replay [--state file.qlog] [--rgb dir] [--depth dir] [--voice file.vlog]
+ *            [--rate 1|N|max] [--start s] [--loop] [--reliable] [--live]
+ *     --rate      1 = original timing (default), N = N times faster, max = no pacing
+ *     --start     skip the first s seconds of the recording
+ *     --loop      restart from the beginning until Ctrl+C
+ *     --reliable  RELIABLE KEEP_LAST(16) publishers, so "max" measures subscriber
+ *                 throughput instead of dropping samples
+ *     --live      use CYCLONEDDS_URI from the environment (not loopback-only)
+ */
+
+#include "dds_middleware.hpp"
+#include "lower_state.hpp"
+#include "voice_state.hpp"
+#include "sensor_msgs/msg/CompressedImage_.hpp"
+#include "sensor_msgs/msg/Image_.hpp"
+#include "common/blob_log.hpp"
+#include "common/state_log.hpp"
+#include "common/state_sample.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace dds_middleware;
+using namespace dobotmh4::msg::dds_;
+using quad_sdk::BlobLogReader;
+using quad_sdk::StateLogReader;
+using quad_sdk::StateSample;
+
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
+{
+    g_interrupt.store(true);
+}
+
+// Loopback-only CycloneDDS configuration, as cyclonedds_local.xml, passed inline.
+const char kLoopbackConfig[] = "<CycloneDDS><Domain Id=\"any\"><General><Interfaces>"
+                               "<NetworkInterface name=\"lo\" priority=\"default\" multicast=\"false\"/>"
+                               "</Interfaces><AllowMulticast>false</AllowMulticast>"
+                               "<MaxMessageSize>65500B</MaxMessageSize></General><Discovery>"
+                               "<ParticipantIndex>auto</ParticipantIndex>"
+                               "<MaxAutoParticipantIndex>32</MaxAutoParticipantIndex>"
+                               "<Peers><Peer address=\"127.0.0.1\"/></Peers></Discovery></Domain></CycloneDDS>";
+
+// One recorded frame on disk, located by its file name.
+struct ImageFile
+{
+    int64_t t_ns;      // host receive time, the replay timeline
+    int64_t header_ns; // camera header stamp, republished unchanged
+    std::string path;
+    uint32_t width;
+    uint32_t height;
+    uint32_t step;
+    bool png;
+};
+
+enum Stream
+{
+    STATE,
+    RGB,
+    DEPTH,
+    VOICE,
+    NUM_STREAMS,
+};
+
+const char* const kStreamNames[NUM_STREAMS] = {"state", "rgb", "depth", "voice"};
+
+static int64_t stamp_ns(int64_t sec, int64_t nanosec)
+{
+    return sec * 1000000000LL + nanosec;
+}
+
+static int64_t monotonic_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return stamp_ns(ts.tv_sec, ts.tv_nsec);
+}
+
+// rgb_<sec>_<nsec>_recv<ns>.jpg|.png, as written by e1_rgb_image_sub in record mode.
+static bool parse_rgb_name(const std::string& name, ImageFile& file)
+{
+    long long sec = 0, nsec = 0, recv = 0;
+    char ext[8] = {0};
+    if (std::sscanf(name.c_str(), "rgb_%lld_%lld_recv%lld.%7s", &sec, &nsec, &recv, ext) != 4)
+        return false;
+    std::string e(ext);
+    if (e != "jpg" && e != "png")
+        return false;
+    file.t_ns = recv;
+    file.header_ns = stamp_ns(sec, nsec);
+    file.png = (e == "png");
+    file.width = file.height = file.step = 0;
+    return true;
+}
+
+// depth_<sec>_<nsec>_<w>x<h>_step<step>_recv<ns>.raw, as written by e2_depth_image_sub in raw mode.
+static bool parse_depth_name(const std::string& name, ImageFile& file)
+{
+    long long sec = 0, nsec = 0, recv = 0;
+    unsigned w = 0, h = 0, step = 0;
+    char ext[8] = {0};
+    int fields = std::sscanf(name.c_str(), "depth_%lld_%lld_%ux%u_step%u_recv%lld.%7s", &sec, &nsec, &w, &h, &step,
+                             &recv, ext);
+    if (fields != 7 || std::string(ext) != "raw")
+        return false;
+    file.t_ns = recv;
+    file.header_ns = stamp_ns(sec, nsec);
+    file.width = w;
+    file.height = h;
+    file.step = step;
+    file.png = false;
+    return true;
+}
+
+static bool list_images(const std::string& dir, bool (*parse)(const std::string&, ImageFile&),
+                        std::vector<ImageFile>& files)
+{
+    DIR* d = opendir(dir.c_str());
+    if (!d) {
+        std::cerr << "Failed to open " << dir << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    while (dirent* entry = readdir(d)) {
+        ImageFile file;
+        if (parse(entry->d_name, file)) {
+            file.path = dir + "/" + entry->d_name;
+            files.push_back(file);
+        }
+    }
+    closedir(d);
+    if (files.empty())
+        std::cerr << "No recorded frames with a receive time (*_recv<ns>.*) in " << dir << std::endl;
+    std::stable_sort(files.begin(), files.end(),
+                     [](const ImageFile& a, const ImageFile& b) { return a.t_ns < b.t_ns; });
+    return true;
+}
+
+// Reads a whole file into a reused buffer; capacity is kept across frames.
+static bool load_file(const std::string& path, std::vector<uint8_t>& data)
+{
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    data.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    bool ok = size >= 0 && std::fread(data.data(), 1, data.size(), f) == data.size();
+    std::fclose(f);
+    return ok;
+}
+
+class Replayer
+{
+public:
+    Replayer()
+        : has_state_(false)
+        , has_voice_(false)
+    {
+        std::memset(published_, 0, sizeof(published_));
+        std::memset(errors_, 0, sizeof(errors_));
+        std::memset(cursor_, 0, sizeof(cursor_));
+    }
+
+    bool openState(const std::string& path) { return has_state_ = state_log_.open(path); }
+    bool openVoice(const std::string& path) { return has_voice_ = voice_log_.open(path); }
+    bool openRgb(const std::string& dir) { return list_images(dir, parse_rgb_name, rgb_files_); }
+    bool openDepth(const std::string& dir) { return list_images(dir, parse_depth_name, depth_files_); }
+
+    uint64_t size(int stream) const
+    {
+        switch (stream) {
+            case STATE:
+                return has_state_ ? state_log_.size() : 0;
+            case RGB:
+                return rgb_files_.size();
+            case DEPTH:
+                return depth_files_.size();
+            default:
+                return has_voice_ ? voice_log_.size() : 0;
+        }
+    }
+
+    int64_t time(int stream, uint64_t i) const
+    {
+        switch (stream) {
+            case STATE:
+                return state_log_.time(i);
+            case RGB:
+                return rgb_files_[i].t_ns;
+            case DEPTH:
+                return depth_files_[i].t_ns;
+            default:
+                return voice_log_[i].t_ns;
+        }
+    }
+
+    // First and last timestamp over all streams; false when nothing was loaded.
+    bool range(int64_t& first, int64_t& last) const
+    {
+        bool any = false;
+        for (int s = 0; s < NUM_STREAMS; ++s) {
+            uint64_t n = size(s);
+            if (n == 0)
+                continue;
+            first = any ? std::min(first, time(s, 0)) : time(s, 0);
+            last = any ? std::max(last, time(s, n - 1)) : time(s, n - 1);
+            any = true;
+        }
+        return any;
+    }
+
+    void createPublishers(DDSMiddleware& middleware, bool reliable)
+    {
+        QoSProfile sensor = QoSProfile::SensorData();
+        QoSProfile bulk;
+        bulk.reliability = ReliabilityPolicy::BEST_EFFORT;
+        bulk.history = HistoryPolicy::KEEP_LAST;
+        bulk.history_depth = 1;
+        bulk.durability = DurabilityPolicy::VOLATILE;
+        if (reliable) {
+            bulk.reliability = ReliabilityPolicy::RELIABLE;
+            bulk.history_depth = 16;
+            sensor = bulk;
+        }
+        if (size(STATE))
+            bind(middleware.create_publisher<LowerState_>("rt/lower/state", sensor), publish_state_);
+        if (size(RGB))
+            bind(middleware.create_publisher<sensor_msgs::msg::dds_::CompressedImage_>(
+                     "rt/camera/camera2/image_compressed", bulk),
+                 publish_rgb_);
+        if (size(DEPTH))
+            bind(middleware.create_publisher<sensor_msgs::msg::dds_::Image_>("rt/camera/camera2/image_depth", bulk),
+                 publish_depth_);
+        if (size(VOICE))
+            bind(middleware.create_publisher<VoiceState_>("rt/voice/state", bulk), publish_voice_);
+    }
+
+    // Position every stream at the first record with time >= t_ns.
+    void seek(int64_t t_ns)
+    {
+        for (int s = 0; s < NUM_STREAMS; ++s) {
+            if (s == STATE && has_state_) {
+                cursor_[s] = state_log_.seek(t_ns);
+                continue;
+            }
+            uint64_t i = 0;
+            while (i < size(s) && time(s, i) < t_ns)
+                ++i;
+            cursor_[s] = i;
+        }
+    }
+
+    // Stream holding the earliest pending record, or -1 at the end of the recording.
+    int next(int64_t& t_ns) const
+    {
+        int best = -1;
+        for (int s = 0; s < NUM_STREAMS; ++s) {
+            if (cursor_[s] >= size(s))
+                continue;
+            int64_t t = time(s, cursor_[s]);
+            if (best < 0 || t < t_ns) {
+                best = s;
+                t_ns = t;
+            }
+        }
+        return best;
+    }
+
+    void publish(int stream)
+    {
+        uint64_t i = cursor_[stream]++;
+        bool ok = true;
+        switch (stream) {
+            case STATE:
+                state_log_.read_sample(i, sample_);
+                quad_sdk::from_sample(sample_, state_msg_);
+                publish_state_(state_msg_);
+                break;
+            case RGB:
+                ok = publishRgb(rgb_files_[i]);
+                break;
+            case DEPTH:
+                ok = publishDepth(depth_files_[i]);
+                break;
+            default: {
+                const BlobLogReader::Record& record = voice_log_[i];
+                voice_msg_.data_().assign(record.data, record.data + record.size);
+                voice_msg_.angle_(record.aux);
+                publish_voice_(voice_msg_);
+                break;
+            }
+        }
+        if (ok)
+            published_[stream]++;
+        else
+            errors_[stream]++;
+    }
+
+    void printCounts(std::ostream& os) const
+    {
+        for (int s = 0; s < NUM_STREAMS; ++s) {
+            if (size(s) == 0)
+                continue;
+            os << kStreamNames[s] << "=" << published_[s];
+            if (errors_[s])
+                os << " (" << errors_[s] << " errors)";
+            os << " ";
+        }
+    }
+
+private:
+    // Keeps the publisher alive inside the std::function that forwards to it.
+    template <typename PublisherPtr, typename T>
+    static void bind(PublisherPtr publisher, std::function<void(const T&)>& publish)
+    {
+        publish = [publisher](const T& msg) { publisher->publish(msg); };
+    }
+
+    static void setStamp(std_msgs::msg::dds_::Header_& header, int64_t t_ns)
+    {
+        header.stamp_().sec_(static_cast<int32_t>(t_ns / 1000000000LL));
+        header.stamp_().nanosec_(static_cast<uint32_t>(t_ns % 1000000000LL));
+    }
+
+    bool publishRgb(const ImageFile& file)
+    {
+        if (!load_file(file.path, rgb_msg_.data_()))
+            return false;
+        setStamp(rgb_msg_.header_(), file.header_ns);
+        rgb_msg_.format_(file.png ? "png" : "jpeg");
+        publish_rgb_(rgb_msg_);
+        return true;
+    }
+
+    bool publishDepth(const ImageFile& file)
+    {
+        if (!load_file(file.path, depth_msg_.data_())
+            || depth_msg_.data_().size() < static_cast<size_t>(file.step) * file.height)
+            return false;
+        setStamp(depth_msg_.header_(), file.header_ns);
+        depth_msg_.height_(file.height);
+        depth_msg_.width_(file.width);
+        depth_msg_.step_(file.step);
+        depth_msg_.encoding_("16UC1");
+        depth_msg_.is_bigendian_(0);
+        publish_depth_(depth_msg_);
+        return true;
+    }
+
+    StateLogReader state_log_;
+    BlobLogReader voice_log_;
+    bool has_state_;
+    bool has_voice_;
+    std::vector<ImageFile> rgb_files_;
+    std::vector<ImageFile> depth_files_;
+
+    std::function<void(const LowerState_&)> publish_state_;
+    std::function<void(const sensor_msgs::msg::dds_::CompressedImage_&)> publish_rgb_;
+    std::function<void(const sensor_msgs::msg::dds_::Image_&)> publish_depth_;
+    std::function<void(const VoiceState_&)> publish_voice_;
+
+    // Messages are reused so steady-state replay does not allocate.
+    StateSample sample_;
+    LowerState_ state_msg_;
+    sensor_msgs::msg::dds_::CompressedImage_ rgb_msg_;
+    sensor_msgs::msg::dds_::Image_ depth_msg_;
+    VoiceState_ voice_msg_;
+
+    uint64_t cursor_[NUM_STREAMS];
+    uint64_t published_[NUM_STREAMS];
+    uint64_t errors_[NUM_STREAMS];
+};
+
+int main(int argc, char** argv)
+{
+    Replayer replayer;
+    double rate = 1.0; // 0 = as fast as possible
+    double start_s = 0.0;
+    bool loop = false;
+    bool reliable = false;
+    bool live = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        bool ok = true;
+        if (arg == "--loop")
+            loop = true;
+        else if (arg == "--reliable")
+            reliable = true;
+        else if (arg == "--live")
+            live = true;
+        else if (arg == "--state" && has_value)
+            ok = replayer.openState(argv[++i]);
+        else if (arg == "--rgb" && has_value)
+            ok = replayer.openRgb(argv[++i]);
+        else if (arg == "--depth" && has_value)
+            ok = replayer.openDepth(argv[++i]);
+        else if (arg == "--voice" && has_value)
+            ok = replayer.openVoice(argv[++i]);
+        else if (arg == "--rate" && has_value) {
+            std::string value = argv[++i];
+            rate = (value == "max") ? 0.0 : std::atof(value.c_str());
+            ok = (value == "max") || rate > 0.0;
+        } else if (arg == "--start" && has_value)
+            start_s = std::atof(argv[++i]);
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--state file.qlog] [--rgb dir] [--depth dir] [--voice file.vlog]"
+                         " [--rate 1|N|max] [--start s] [--loop] [--reliable] [--live]"
+                      << std::endl;
+            return 1;
+        }
+        if (!ok) {
+            std::cerr << "Invalid value for " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    int64_t first = 0, last = 0;
+    if (!replayer.range(first, last)) {
+        std::cerr << "Nothing to replay: give at least one non-empty --state, --rgb, --depth or --voice input"
+                  << std::endl;
+        return 1;
+    }
+    int64_t begin = first + static_cast<int64_t>(start_s * 1e9);
+    for (int s = 0; s < NUM_STREAMS; ++s) {
+        if (replayer.size(s))
+            std::cout << kStreamNames[s] << ": " << replayer.size(s) << " records" << std::endl;
+    }
+    std::cout << "Recording spans " << (last - first) / 1e9 << " s, replaying from " << start_s << " s at ";
+    if (rate > 0.0)
+        std::cout << rate << "x" << std::endl;
+    else
+        std::cout << "max speed" << std::endl;
+
+    if (live) {
+        std::cout << "--live: publishing with the environment's DDS configuration, robots on the network see it"
+                  << std::endl;
+    } else {
+        setenv("CYCLONEDDS_URI", kLoopbackConfig, 1);
+        std::cout << "Publishing on loopback only; run subscribers with "
+                     "CYCLONEDDS_URI=file://<repo>/cyclonedds_local.xml (--live to use the network)"
+                  << std::endl;
+    }
+
+    std::signal(SIGINT, SignalHandler);
+    auto middleware = std::make_shared<DDSMiddleware>(0);
+    replayer.createPublishers(*middleware, reliable);
+
+    int64_t late_ns_max = 0;
+    uint64_t late = 0;
+    do {
+        replayer.seek(begin);
+        int64_t wall_start = monotonic_ns();
+        int64_t next_report = wall_start + 1000000000LL;
+        int64_t t_ns = 0;
+        int stream;
+        while (!g_interrupt && (stream = replayer.next(t_ns)) >= 0) {
+            int64_t now = monotonic_ns();
+            if (rate > 0.0) {
+                // Absolute deadline relative to the start of the pass: no drift from sleep overshoot.
+                int64_t deadline = wall_start + static_cast<int64_t>((t_ns - begin) / rate);
+                if (deadline > now) {
+                    timespec ts;
+                    ts.tv_sec = deadline / 1000000000LL;
+                    ts.tv_nsec = deadline % 1000000000LL;
+                    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR && !g_interrupt) {
+                    }
+                    now = monotonic_ns();
+                } else if (now - deadline > 1000000) {
+                    late++;
+                    late_ns_max = std::max(late_ns_max, now - deadline);
+                }
+            }
+            replayer.publish(stream);
+
+            if (now >= next_report) {
+                next_report = now + 1000000000LL;
+                std::cout << "\r\033[K"
+                          << "t=" << (t_ns - first) / 1e9 << " s  ";
+                replayer.printCounts(std::cout);
+                std::cout << std::flush;
+            }
+        }
+        double wall_s = (monotonic_ns() - wall_start) / 1e9;
+        double span_s = (t_ns - begin) / 1e9;
+        std::cout << "\r\033[K"
+                  << "Replayed " << span_s << " s of recording in " << wall_s << " s ("
+                  << (wall_s > 0.0 ? span_s / wall_s : 0.0) << "x)  ";
+        replayer.printCounts(std::cout);
+        std::cout << std::endl;
+    } while (loop && !g_interrupt);
+
+    if (rate > 0.0)
+        std::cout << late << " records published more than 1 ms behind schedule (worst " << late_ns_max / 1e6
+                  << " ms)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,230 @@
+/**
+ * Simulated robot for running the low-level examples without hardware
+ *
+ * Publishes rt/lower/state at a fixed rate and follows rt/lower/cmd with a
+ * first-order joint model: each motor is a viscously damped joint with no inertia,
+ * driven by the usual PD law
+ *     tau = kp * (q_des - q) + kd * (dq_des - dq) + tau_ff
+ *     b * dq = tau
+ * which relaxes to its target with time constant (b + kd) / kp. The step is
+ * integrated exactly, so it is stable at any rate and gain. Joint positions are
+ * reported like the robot's (with motor_offset included), so e9_motor_cmd_pub and
+ * lower_latency_probe work unmodified. IMU reads a level, stationary body with
+ * sensor noise; the battery drains slowly and draws current with motor effort.
+ *
+ * If no command arrives for cmd_timeout_ms the joints go passive, like the
+ * robot's own safety timeout.
+ *
+ * Usage:
+ *   ./robot_sim [rate_hz=500] [cmd_timeout_ms=100] [rt_priority=0] [cpu=-1]   (Ctrl+C to stop)
+ * Run it with CYCLONEDDS_URI pointing at cyclonedds_local.xml so it stays on loopback.
+ */
+
+#include "dds_middleware.hpp"
+#include "lower_cmd.hpp"
+#include "lower_state.hpp"
+#include "common/periodic_executor.hpp"
+#include "common/state_mailbox.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace dds_middleware;
+using namespace dobotmh4::msg::dds_;
+using quad_sdk::PeriodicExecutor;
+using quad_sdk::PeriodicExecutorConfig;
+using quad_sdk::StateMailbox;
+
+const std::array<double, 16> motor_offset
+    = {-0.05, -0.5, 1.17, 0.0, 0.05, -0.5, 1.17, 0.0, -0.05, 0.5, -1.17, 0.0, 0.05, 0.5, -1.17, 0.0};
+
+const double JOINT_DAMPING = 0.5; // b, N*m*s/rad
+const double TAU_LIMIT = 40.0;    // reported torque saturation, N*m
+const double GRAVITY = 9.81;
+
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
+{
+    g_interrupt.store(true);
+}
+
+StateMailbox<LowerCmd_> cmd_mailbox;
+
+void lowerCmdCallback(const LowerCmd_& cmd)
+{
+    cmd_mailbox.write(cmd);
+}
+
+struct JointState
+{
+    double q = 0.0;
+    double dq = 0.0;
+    double ddq = 0.0;
+    double tau = 0.0;
+    double temp = 30.0;
+};
+
+class RobotSim
+{
+public:
+    explicit RobotSim(double dt)
+        : dt_(dt)
+        , battery_(100.0)
+        , current_(0.0)
+        , time_(0.0)
+        , rng_(42)
+        , gyro_noise_(0.0, 0.002)
+        , accel_noise_(0.0, 0.02)
+    {
+        for (int i = 0; i < 16; ++i)
+            joints_[i].q = motor_offset[i]; // every joint starts at its zero angle
+    }
+
+    // Advance one step. cmd == nullptr means no (or a stale) command: passive joints.
+    void step(const LowerCmd_* cmd)
+    {
+        double effort = 0.0;
+        for (int i = 0; i < 16; ++i) {
+            JointState& j = joints_[i];
+            double kp = 0.0, kd = 0.0, q_des = 0.0, dq_des = 0.0, tau_ff = 0.0;
+            if (cmd) {
+                const MotorCmd_& m = cmd->motor_cmd()[i];
+                kp = std::max(0.0f, m.kp());
+                kd = std::max(0.0f, m.kd());
+                q_des = m.q();
+                dq_des = m.dq();
+                tau_ff = m.tau();
+            }
+            // (b + kd) dq = kp (q_des - q) + kd dq_des + tau_ff   =>   dq = c - a q
+            double a = kp / (JOINT_DAMPING + kd);
+            double c = (kp * q_des + kd * dq_des + tau_ff) / (JOINT_DAMPING + kd);
+            double q_next;
+            if (a > 1e-9) {
+                double q_inf = c / a;
+                q_next = q_inf + (j.q - q_inf) * std::exp(-a * dt_);
+            } else {
+                q_next = j.q + c * dt_;
+            }
+            double dq = (q_next - j.q) / dt_;
+            j.ddq = (dq - j.dq) / dt_;
+            j.dq = dq;
+            j.q = q_next;
+            j.tau = std::max(-TAU_LIMIT, std::min(TAU_LIMIT, JOINT_DAMPING * dq));
+            // Slow first-order heating with |tau|, cooling back to 30 C.
+            j.temp += dt_ / 60.0 * (30.0 + 1.5 * std::fabs(j.tau) - j.temp);
+            effort += std::fabs(j.tau);
+        }
+        current_ = 1.5 + 0.2 * effort;
+        battery_ = std::max(0.0, battery_ - dt_ / 60.0); // 1% per minute
+        time_ += dt_;
+    }
+
+    void fill(LowerState_& state)
+    {
+        for (int i = 0; i < 16; ++i) {
+            const JointState& j = joints_[i];
+            MotorState_& m = state.motor_state()[i];
+            m.mode(0);
+            m.q(static_cast<float>(j.q));
+            m.dq(static_cast<float>(j.dq));
+            m.ddq(static_cast<float>(j.ddq));
+            m.tau_est(static_cast<float>(j.tau));
+            m.q_raw(static_cast<float>(j.q));
+            m.dq_raw(static_cast<float>(j.dq));
+            m.ddq_raw(static_cast<float>(j.ddq));
+            m.motor_temp(static_cast<uint8_t>(j.temp));
+        }
+
+        IMUState_& imu = state.imu_state();
+        imu.quaternion()[0] = 1.0f; // w, x, y, z: level body
+        imu.quaternion()[1] = imu.quaternion()[2] = imu.quaternion()[3] = 0.0f;
+        for (int i = 0; i < 3; ++i) {
+            imu.gyroscope()[i] = static_cast<float>(gyro_noise_(rng_));
+            imu.accelerometer()[i] = static_cast<float>(accel_noise_(rng_) + (i == 2 ? GRAVITY : 0.0));
+            imu.rpy()[i] = 0.0f;
+        }
+
+        BmsState_& bms = state.bms_state();
+        bms.battery_level(static_cast<uint8_t>(std::ceil(battery_)));
+        bms.bat_id(1);
+        bms.bms_work_time(static_cast<uint32_t>(time_));
+        bms.battery_now_current(static_cast<float>(current_));
+    }
+
+private:
+    double dt_;
+    std::array<JointState, 16> joints_;
+    double battery_;
+    double current_;
+    double time_;
+    std::mt19937 rng_;
+    std::normal_distribution<double> gyro_noise_;
+    std::normal_distribution<double> accel_noise_;
+};
+
+int main(int argc, char** argv)
+{
+    double rate_hz = (argc > 1) ? std::atof(argv[1]) : 500.0;
+    int cmd_timeout_ms = (argc > 2) ? std::atoi(argv[2]) : 100;
+    if (rate_hz < 1.0 || rate_hz > 10000.0 || cmd_timeout_ms < 1) {
+        std::cerr << "Usage: " << argv[0] << " [rate_hz=500] [cmd_timeout_ms=100] [rt_priority] [cpu]" << std::endl;
+        return 1;
+    }
+    PeriodicExecutorConfig loop_config;
+    loop_config.period_ns = static_cast<int64_t>(1e9 / rate_hz);
+    loop_config.rt_priority = (argc > 3) ? std::atoi(argv[3]) : 0;
+    loop_config.cpu = (argc > 4) ? std::atoi(argv[4]) : -1;
+    loop_config.lock_memory = loop_config.rt_priority > 0;
+
+    std::signal(SIGINT, SignalHandler);
+    auto middleware = std::make_shared<DDSMiddleware>(0);
+    auto state_pub = middleware->create_publisher<LowerState_>("rt/lower/state", QoSProfile::SensorData());
+
+    QoSProfile cmd_qos;
+    cmd_qos.reliability = ReliabilityPolicy::RELIABLE;
+    cmd_qos.durability = DurabilityPolicy::VOLATILE;
+    cmd_qos.history = HistoryPolicy::KEEP_LAST;
+    cmd_qos.history_depth = 1;
+    auto cmd_sub = middleware->create_subscription<LowerCmd_>("rt/lower/cmd", lowerCmdCallback, cmd_qos);
+
+    RobotSim sim(1.0 / rate_hz);
+    LowerState_ state; // reused every cycle
+    uint64_t last_cmd_seq = 0, last_cmd_cycle = 0, timeouts = 0;
+    bool active = false;
+    uint64_t timeout_cycles = static_cast<uint64_t>(std::max(1.0, cmd_timeout_ms * rate_hz / 1000.0));
+
+    std::cout << "Simulating robot: rt/lower/state at " << rate_hz << " Hz, command timeout " << cmd_timeout_ms
+              << " ms (Ctrl+C to stop)" << std::endl;
+
+    PeriodicExecutor executor(loop_config);
+    executor.configure_current_thread();
+    executor.run([&](uint64_t cycle) {
+        uint64_t seq = 0;
+        const LowerCmd_* cmd = cmd_mailbox.read(&seq);
+        if (cmd && seq != last_cmd_seq) {
+            last_cmd_seq = seq;
+            last_cmd_cycle = cycle;
+            if (!active)
+                std::cout << "[" << cycle << "] Receiving rt/lower/cmd" << std::endl;
+            active = true;
+        } else if (active && cycle - last_cmd_cycle > timeout_cycles) {
+            active = false;
+            timeouts++;
+            std::cout << "[" << cycle << "] Command timeout, joints passive" << std::endl;
+        }
+
+        sim.step(active ? cmd : nullptr);
+        sim.fill(state);
+        state_pub->publish(state);
+        return !g_interrupt;
+    });
+
+    executor.print_stats(std::cout);
+    std::cout << "Commands received: " << cmd_mailbox.published() << ", timeouts: " << timeouts << std::endl;
+    return 0;
+}
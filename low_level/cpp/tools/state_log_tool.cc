@@ -0,0 +1,124 @@
+/**
+ * Offline reader for state logs written by state_recorder.
+ *
+ * Usage:
+ *   ./state_log_tool info <file.qlog>
+ *       Record count, time span, average rate and column layout.
+ *   ./state_log_tool dump <file.qlog> <column[:index]> [start_s] [end_s]
+ *       Print one column (e.g. q:2, tau_est:14, battery_current) between two
+ *       offsets in seconds from the start of the log. Only the pages holding the
+ *       timestamp index and the requested column are touched.
+ *   ./state_log_tool stats <file.qlog> <column[:index]> [start_s] [end_s]
+ *       Min / max / mean of one column over the same kind of range.
+ */
+
+#include "common/state_log.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using quad_sdk::StateLogReader;
+
+static const char* typeName(uint8_t type)
+{
+    switch (type) {
+        case quad_sdk::COL_I64:
+            return "i64";
+        case quad_sdk::COL_F32:
+            return "f32";
+        default:
+            return "u8";
+    }
+}
+
+static void printInfo(const StateLogReader& log)
+{
+    uint64_t n = log.size();
+    std::cout << "Records: " << n << std::endl;
+    if (n > 0) {
+        double span = (log.time(n - 1) - log.time(0)) / 1e9;
+        std::cout << "Time span: " << std::fixed << std::setprecision(3) << span << " s";
+        if (span > 0)
+            std::cout << " (" << std::setprecision(1) << (n - 1) / span << " Hz)";
+        std::cout << std::endl;
+    }
+    std::cout << "Columns:" << std::endl;
+    for (int c = 0; c < log.num_columns(); ++c) {
+        const quad_sdk::StateLogColumn& col = log.column(c);
+        std::cout << "  " << std::left << std::setw(16) << col.name << typeName(col.type) << "[" << col.count << "]"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " info|dump|stats <file.qlog> [column[:index]] [start_s] [end_s]"
+                  << std::endl;
+        return 1;
+    }
+    std::string command = argv[1];
+
+    StateLogReader log;
+    if (!log.open(argv[2]))
+        return 1;
+
+    if (command == "info") {
+        printInfo(log);
+        return 0;
+    }
+    if (argc < 4 || (command != "dump" && command != "stats")) {
+        std::cerr << "Unknown command or missing column" << std::endl;
+        return 1;
+    }
+
+    std::string spec = argv[3];
+    int index = 0;
+    size_t colon = spec.find(':');
+    if (colon != std::string::npos) {
+        index = std::atoi(spec.c_str() + colon + 1);
+        spec = spec.substr(0, colon);
+    }
+    int c = log.find_column(spec);
+    if (c < 0 || index < 0 || index >= log.column(c).count) {
+        std::cerr << "No such column: " << argv[3] << std::endl;
+        return 1;
+    }
+
+    uint64_t n = log.size();
+    if (n == 0)
+        return 0;
+    int64_t t0 = log.time(0);
+    uint64_t begin = (argc > 4) ? log.seek(t0 + static_cast<int64_t>(std::atof(argv[4]) * 1e9)) : 0;
+    uint64_t end = (argc > 5) ? log.seek(t0 + static_cast<int64_t>(std::atof(argv[5]) * 1e9)) : n;
+    if (end < begin) {
+        std::cerr << "start_s must not be after end_s" << std::endl;
+        return 1;
+    }
+
+    if (command == "dump") {
+        std::cout << std::fixed;
+        for (uint64_t i = begin; i < end; ++i) {
+            std::cout << std::setprecision(6) << (log.time(i) - t0) / 1e9 << " " << log.value(c, i, index)
+                      << std::endl;
+        }
+        return 0;
+    }
+
+    double lo = std::numeric_limits<double>::max(), hi = std::numeric_limits<double>::lowest(), sum = 0;
+    for (uint64_t i = begin; i < end; ++i) {
+        double v = log.value(c, i, index);
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+        sum += v;
+    }
+    uint64_t count = end - begin;
+    std::cout << argv[3] << ": n=" << count;
+    if (count > 0)
+        std::cout << " min=" << lo << " max=" << hi << " mean=" << sum / count;
+    std::cout << std::endl;
+    return 0;
+}
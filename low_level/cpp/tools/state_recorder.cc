@@ -0,0 +1,108 @@
+/**
+ * LowerState_ recorder
+ *
+ * Subscribes to rt/lower/state and appends every sample to a memory-mapped,
+ * block-columnar state log (see common/state_log.hpp). The DDS callback only
+ * flattens the message into a StateSample and pushes it into a lock-free ring;
+ * a separate writer thread drains the ring into the mapped file, so disk I/O
+ * never blocks the reader thread.
+ *
+ * Usage:
+ *   ./state_recorder [output.qlog]        (Ctrl+C to stop)
+ * Inspect the result with ./state_log_tool.
+ */
+
+#include "dds_middleware.hpp"
+#include "lower_state.hpp"
+#include "common/spsc_ring.hpp"
+#include "common/state_log.hpp"
+#include "common/state_sample.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace dobotmh4::msg::dds_;
+using quad_sdk::SpscRing;
+using quad_sdk::StateLogWriter;
+using quad_sdk::StateSample;
+
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
+{
+    g_interrupt.store(true);
+}
+
+// ~4 s of headroom at 2 kHz before samples are dropped.
+SpscRing<StateSample> g_ring(8192);
+std::atomic<uint64_t> g_received {0};
+std::atomic<uint64_t> g_dropped {0};
+std::atomic<uint64_t> g_written {0};
+
+void lowerStateCallback(const LowerState_& state)
+{
+    StateSample sample;
+    int64_t t_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    quad_sdk::to_sample(state, t_ns, sample);
+    g_received++;
+    if (!g_ring.try_push(sample))
+        g_dropped++;
+}
+
+int main(int argc, char** argv)
+{
+    std::signal(SIGINT, SignalHandler);
+    std::string path = (argc > 1) ? argv[1] : "lower_state.qlog";
+
+    StateLogWriter writer;
+    if (!writer.open(path))
+        return 1;
+
+    std::atomic<bool> stop {false};
+    std::thread writer_thread([&] {
+        StateSample sample;
+        auto last_flush = std::chrono::steady_clock::now();
+        while (true) {
+            bool wrote = false;
+            while (g_ring.try_pop(sample)) {
+                if (writer.append(sample))
+                    g_written++;
+                wrote = true;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (wrote && now - last_flush > std::chrono::milliseconds(100)) {
+                writer.flush();
+                last_flush = now;
+            }
+            if (!wrote) {
+                if (stop)
+                    break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+    });
+
+    {
+        auto middleware = std::make_shared<dds_middleware::DDSMiddleware>(0);
+        auto lower_state_sub = middleware->create_subscription<LowerState_>(
+            "rt/lower/state", lowerStateCallback, dds_middleware::QoSProfile::SensorData());
+
+        std::cout << "Recording rt/lower/state to " << path << " (Ctrl+C to stop)" << std::endl;
+        while (!g_interrupt) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            std::cout << "\r\033[K"
+                      << "received=" << g_received << " written=" << g_written << " dropped=" << g_dropped
+                      << std::flush;
+        }
+    }
+
+    stop = true;
+    writer_thread.join();
+    writer.close();
+    std::cout << "\nRecorded " << writer.count() << " samples to " << path << " (" << g_dropped << " dropped)"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * rt/voice/state analyzer
+ *
+ * Subscribes to the robot microphone stream (rt/voice/state) and runs VoiceAnalyzer
+ * (common/voice_analysis.hpp) on every chunk: voice activity, loudness and the
+ * smoothed sound-source angle. Prints one line per event instead of the audio, e.g.
+ *   12.480 speech_start rms=-31.2 peak=-18.7 dBFS speech=0.83 angle=74.9
+ * and every 10 s the analysis cost as a share of one core. Run it on the robot to
+ * trigger behaviours from speech without shipping the audio off the robot.
+ *
+ * Usage:
+ *   ./voice_events [threshold_db=9] [hangover_ms=300]     (Ctrl+C to stop)
+ */
+
+#include "dds_middleware.hpp"
+#include "voice_state.hpp"
+#include "common/voice_analysis.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace dds_middleware;
+using namespace dobotmh4::msg::dds_;
+
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
+{
+    g_interrupt.store(true);
+}
+
+std::unique_ptr<quad_sdk::VoiceAnalyzer> g_analyzer;
+std::vector<int16_t> g_pcm; // only touched on the DDS callback thread
+std::vector<quad_sdk::VoiceEvent> g_events;
+std::chrono::steady_clock::time_point g_start = std::chrono::steady_clock::now();
+std::atomic<uint64_t> g_chunks {0};
+std::atomic<uint64_t> g_samples {0};
+std::atomic<uint64_t> g_analysis_ns {0};
+
+void voiceStateCallback(const VoiceState_& voice_state)
+{
+    auto arrival = std::chrono::steady_clock::now();
+    size_t samples = voice_state.data_().size() / sizeof(int16_t);
+    if (g_pcm.size() < samples)
+        g_pcm.resize(samples);
+    std::memcpy(g_pcm.data(), voice_state.data_().data(), samples * sizeof(int16_t));
+
+    int64_t t_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(arrival - g_start).count();
+    g_events.clear();
+    g_analyzer->process(g_pcm.data(), samples, voice_state.angle_(), t_ns, g_events);
+    g_analysis_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - arrival)
+                         .count();
+    g_chunks++;
+    g_samples += samples;
+
+    for (const quad_sdk::VoiceEvent& e : g_events)
+        printf("%.3f %s rms=%.1f peak=%.1f dBFS speech=%.2f angle=%.1f\n", e.t_ns / 1e9,
+               quad_sdk::voice_event_name(e.type), e.rms_dbfs, e.peak_dbfs, e.speech_ratio, e.angle_deg);
+    if (!g_events.empty())
+        fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+    std::signal(SIGINT, SignalHandler);
+    quad_sdk::VoiceAnalysisConfig config;
+    config.threshold_db = (argc > 1) ? static_cast<float>(std::atof(argv[1])) : 9.0f;
+    config.hangover_ms = (argc > 2) ? std::atoi(argv[2]) : 300;
+    if (config.threshold_db <= 0.0f || config.hangover_ms < config.frame_ms) {
+        std::cerr << "Usage: " << argv[0] << " [threshold_db=9] [hangover_ms=300 (>= 20)]" << std::endl;
+        return 1;
+    }
+    g_analyzer.reset(new quad_sdk::VoiceAnalyzer(config));
+
+    auto middleware = std::make_shared<DDSMiddleware>(0);
+    QoSProfile qos; // matches e8_voice_sub
+    qos.reliability = ReliabilityPolicy::BEST_EFFORT;
+    qos.history = HistoryPolicy::KEEP_LAST;
+    qos.history_depth = 1;
+    qos.durability = DurabilityPolicy::VOLATILE;
+    auto voice_state_sub = middleware->create_subscription<VoiceState_>("rt/voice/state", voiceStateCallback, qos);
+
+    std::cout << "Analyzing rt/voice/state with " << g_analyzer->simd_name() << " kernels (Ctrl+C to stop)"
+              << std::endl;
+    uint64_t last_samples = 0, last_ns = 0;
+    auto report = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!g_interrupt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        if (std::chrono::steady_clock::now() < report)
+            continue;
+        report += std::chrono::seconds(10);
+        uint64_t samples = g_samples, ns = g_analysis_ns;
+        double audio_s = (samples - last_samples) / static_cast<double>(config.sample_rate);
+        printf("# %llu chunks, %.1f s of audio, analysis %.4f%% of one core\n",
+               static_cast<unsigned long long>(g_chunks.load()), audio_s,
+               audio_s > 0.0 ? 100.0 * (ns - last_ns) / (audio_s * 1e9) : 0.0);
+        fflush(stdout);
+        last_samples = samples;
+        last_ns = ns;
+    }
+    voice_state_sub.reset();
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * rt/voice/cmd receiver
+ *
+ * Stands in for the robot's voice playback service: subscribes to rt/voice/cmd,
+ * decodes "opus" payloads (common/opus_voice.hpp) and passes "streaming" S16_LE PCM
+ * through unchanged, then plays the 24 kHz audio with aplay or writes it to a raw
+ * PCM file. Handy for checking e7_voice_pub end to end without a robot.
+ *
+ * Usage:
+ *   ./voice_sink [output.pcm]        (Ctrl+C to stop; without a file the audio goes to aplay)
+ * Play a recording back with: aplay -t raw -f S16_LE -c1 -r24000 output.pcm
+ */
+
+#include "dds_middleware.hpp"
+#include "voice_cmd.hpp"
+#include "common/opus_voice.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dds_middleware;
+using namespace dobotmh4::msg::dds_;
+
+std::atomic<bool> g_interrupt {false};
+void SignalHandler(int)
+{
+    g_interrupt.store(true);
+}
+
+FILE* g_output = nullptr;
+quad_sdk::OpusVoiceDecoder g_decoder;
+std::vector<int16_t> g_pcm; // only touched on the DDS callback thread
+std::atomic<uint64_t> g_messages {0};
+std::atomic<uint64_t> g_payload_bytes {0};
+std::atomic<uint64_t> g_samples {0};
+std::atomic<uint64_t> g_errors {0};
+
+void voiceCmdCallback(const VoiceCmd_& cmd)
+{
+    g_messages++;
+    g_payload_bytes += cmd.data().size();
+    g_pcm.clear();
+    if (cmd.type() == quad_sdk::kVoiceTypeOpus) {
+        if (!g_decoder.decode(cmd.data().data(), cmd.data().size(), g_pcm))
+            g_errors++;
+    } else if (cmd.type() == "streaming") {
+        g_pcm.resize(cmd.data().size() / 2);
+        std::copy(cmd.data().begin(), cmd.data().begin() + g_pcm.size() * 2,
+                  reinterpret_cast<uint8_t*>(g_pcm.data()));
+    } else {
+        std::cout << "\nIgnoring VoiceCmd type '" << cmd.type() << "' (path: " << cmd.path() << ")" << std::endl;
+        return;
+    }
+    g_samples += g_pcm.size();
+    if (!g_pcm.empty() && fwrite(g_pcm.data(), sizeof(int16_t), g_pcm.size(), g_output) != g_pcm.size())
+        g_errors++;
+}
+
+int main(int argc, char** argv)
+{
+    std::signal(SIGINT, SignalHandler);
+    std::string path = (argc > 1) ? argv[1] : "";
+    if (!g_decoder.ok())
+        return 1;
+
+    bool playing = path.empty();
+    g_output = playing ? popen("aplay -q -t raw -f S16_LE -c1 -r24000", "w") : fopen(path.c_str(), "wb");
+    if (!g_output) {
+        std::cerr << (playing ? "aplay not found or failed to start" : "Failed to create " + path) << std::endl;
+        return 1;
+    }
+
+    {
+        auto middleware = std::make_shared<DDSMiddleware>(0);
+        QoSProfile qos; // matches e7_voice_pub
+        qos.reliability = ReliabilityPolicy::RELIABLE;
+        qos.history = HistoryPolicy::KEEP_LAST;
+        qos.history_depth = 5;
+        qos.durability = DurabilityPolicy::VOLATILE;
+        auto voice_cmd_sub = middleware->create_subscription<VoiceCmd_>("rt/voice/cmd", voiceCmdCallback, qos);
+
+        std::cout << "Receiving rt/voice/cmd " << (playing ? "into aplay" : "into " + path) << " (Ctrl+C to stop)"
+                  << std::endl;
+        uint64_t last_bytes = 0;
+        while (!g_interrupt) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            uint64_t bytes = g_payload_bytes;
+            std::cout << "\r\033[K"
+                      << "messages=" << g_messages << " payload=" << (bytes - last_bytes) << " B/s"
+                      << " audio=" << g_samples / static_cast<double>(quad_sdk::kVoiceSampleRate) << " s"
+                      << " errors=" << g_errors << std::flush;
+            last_bytes = bytes;
+        }
+    }
+
+    if (playing)
+        pclose(g_output);
+    else
+        fclose(g_output);
+    std::cout << std::endl;
+    return 0;
+}